@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+/*
+ * A minimal timing harness for the MathLibrary benchmarks.
+ *
+ * Build the Release configuration to get meaningful numbers. Kernels are
+ * marked BENCHMARK_NOINLINE so each one appears as its own function in an
+ * assembly listing (/FAs on MSVC, -S on GCC and Clang), which is the
+ * easiest way to compare the code generated for two approaches.
+ */
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace Benchmark
+{
+	/**
+	 * Stops the compiler from discarding a result it can see is unused.
+	 */
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(_MSC_VER)
+		const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+		(void)*p;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&value) : "memory");
+#endif
+	}
+
+	/**
+	 * Calls fn repeatedly and prints the fastest time per call, together
+	 * with the time per item when fn processes itemsPerCall items.
+	 *
+	 * @param name The label to print.
+	 * @param itemsPerCall The number of elements fn processes per call.
+	 * @param fn The work to time.
+	 * @return The fastest time per call in nanoseconds.
+	 */
+	template<typename Fn>
+	double Run(const char* name, size_t itemsPerCall, Fn&& fn, int repeats = 15, int callsPerRepeat = 20)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		fn(); // warm caches and branch predictors
+
+		double best = 1e300;
+		for (int r = 0; r < repeats; r++)
+		{
+			auto start = Clock::now();
+			for (int c = 0; c < callsPerRepeat; c++)
+			{
+				fn();
+			}
+			std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+			double perCall = elapsed.count() / callsPerRepeat;
+			if (perCall < best) { best = perCall; }
+		}
+
+		std::printf("  %-44s %12.0f ns/call %9.3f ns/item\n", name, best, best / (double)(itemsPerCall ? itemsPerCall : 1));
+		return best;
+	}
+
+	inline void Section(const char* title)
+	{
+		std::printf("\n%s\n", title);
+	}
+}
+
+// Entry points for each benchmark file, called in order from Main.cpp
+void RunExpressionBenchmarks();
+void RunPrecisionBenchmarks();
+void RunTransformBenchmarks();
+void RunPackingBenchmarks();
+void RunColorBenchmarks();
+void RunEasingBenchmarks();
+void RunSplineBenchmarks();
+void RunSkinningBenchmarks();
+void RunCullingBenchmarks();
+void RunCollisionBenchmarks();
+void RunBroadphaseBenchmarks();
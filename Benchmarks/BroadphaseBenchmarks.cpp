@@ -0,0 +1,178 @@
+#include "Benchmark.h"
+
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using MathClasses::AABB2;
+using MathClasses::IndexPair;
+using MathClasses::SpatialHashGrid;
+using MathClasses::SweepAndPrune2;
+using MathClasses::Vector2;
+
+/*
+ * Compares finding every pair of points within a distance by testing all
+ * n(n - 1)/2 pairs, against rebuilding a SpatialHashGrid and querying it.
+ * The points are spread at a fixed density, so the number of pairs grows
+ * with n and only the all-pairs cost grows with n squared.
+ *
+ * Then compares keeping the overlapping pairs of slowly moving boxes up to
+ * date each frame, by rebuilding a grid of their centres against updating
+ * a SweepAndPrune2. The grid's cells must be wide enough for the largest
+ * box, so a few large boxes make every cell crowded.
+ */
+namespace
+{
+	constexpr float Distance = 2.0f;
+
+	std::vector<Vector2> RandomPoints(size_t count)
+	{
+		// about one neighbour in range per point
+		const float range = std::sqrt((float)count * 3.14159265f * Distance * Distance) * 0.5f;
+		std::mt19937 rng(24);
+		std::uniform_real_distribution<float> position(-range, range);
+		std::vector<Vector2> points(count);
+		for (Vector2& point : points) {
+			point = Vector2(position(rng), position(rng));
+		}
+		return points;
+	}
+
+	BENCHMARK_NOINLINE size_t PairsAll(const std::vector<Vector2>& points, std::vector<IndexPair>& pairs)
+	{
+		pairs.clear();
+		const float distanceSqr = Distance * Distance;
+		for (uint32_t a = 0; a < points.size(); a++) {
+			for (uint32_t b = a + 1; b < points.size(); b++) {
+				if ((points[b] - points[a]).MagnitudeSqr() <= distanceSqr) { pairs.push_back({ a, b }); }
+			}
+		}
+		return pairs.size();
+	}
+
+	struct MovingBoxes
+	{
+		std::vector<Vector2> centers;
+		std::vector<Vector2> extents;
+		std::vector<Vector2> velocities;
+		float largestExtent = 0;
+
+		AABB2 Box(size_t i) const { return AABB2::FromCenterExtents(centers[i], extents[i]); }
+
+		void Step() {
+			for (size_t i = 0; i < centers.size(); i++) {
+				centers[i] = centers[i] + velocities[i];
+			}
+		}
+	};
+
+	// boxes 1 to 3 units wide, with one in every largeEvery between 20 and 80 units wide
+	MovingBoxes RandomBoxes(size_t count, size_t largeEvery)
+	{
+		const float range = std::sqrt((float)count) * 5.0f;
+		std::mt19937 rng(25);
+		std::uniform_real_distribution<float> position(-range, range);
+		std::uniform_real_distribution<float> small(0.5f, 1.5f);
+		std::uniform_real_distribution<float> large(10.0f, 40.0f);
+		std::uniform_real_distribution<float> speed(-0.05f, 0.05f);
+
+		MovingBoxes boxes;
+		for (size_t i = 0; i < count; i++) {
+			bool isLarge = largeEvery != 0 && i % largeEvery == 0;
+			boxes.centers.push_back(Vector2(position(rng), position(rng)));
+			boxes.extents.push_back(isLarge ? Vector2(large(rng), large(rng)) : Vector2(small(rng), small(rng)));
+			boxes.velocities.push_back(Vector2(speed(rng), speed(rng)));
+			boxes.largestExtent = std::max(boxes.largestExtent, std::max(boxes.extents.back().x, boxes.extents.back().y));
+		}
+		return boxes;
+	}
+
+	BENCHMARK_NOINLINE size_t BoxPairsGrid(SpatialHashGrid& grid, const MovingBoxes& boxes, std::vector<IndexPair>& candidates, std::vector<IndexPair>& pairs)
+	{
+		// any two overlapping boxes have centres within this distance
+		const float reach = boxes.largestExtent * 2.0f * 1.4142136f;
+		grid.Build(boxes.centers.data(), boxes.centers.size());
+		grid.FindPairs(reach, candidates);
+		pairs.clear();
+		for (const IndexPair& pair : candidates) {
+			if (boxes.Box(pair.a).Overlaps(boxes.Box(pair.b))) { pairs.push_back(pair); }
+		}
+		return pairs.size();
+	}
+
+	BENCHMARK_NOINLINE size_t BoxPairsSweep(SweepAndPrune2& broadphase, const MovingBoxes& boxes)
+	{
+		for (uint32_t i = 0; i < boxes.centers.size(); i++) {
+			broadphase.SetBounds(i, boxes.Box(i));
+		}
+		broadphase.Update();
+		return broadphase.Pairs().size();
+	}
+
+	BENCHMARK_NOINLINE size_t PairsGrid(SpatialHashGrid& grid, const std::vector<Vector2>& points, std::vector<IndexPair>& pairs)
+	{
+		grid.Build(points.data(), points.size());
+		return grid.FindPairs(Distance, pairs);
+	}
+}
+
+void RunBroadphaseBenchmarks()
+{
+	Benchmark::Section("Broadphase: all pairs within a distance, rebuilt each call");
+
+	char name[64];
+	std::vector<IndexPair> pairs;
+	for (size_t count : { 1000, 10000, 100000 }) {
+		std::vector<Vector2> points = RandomPoints(count);
+		const int calls = count >= 100000 ? 2 : 10;
+
+		// all pairs at 100k points is five billion tests, too slow to be worth timing
+		if (count <= 10000) {
+			std::snprintf(name, sizeof(name), "%zu points, all pairs", count);
+			Benchmark::Run(name, count, [&] {
+				Benchmark::DoNotOptimize(PairsAll(points, pairs));
+			}, 3, 1);
+		}
+
+		// enough buckets for about one cell each, so few cells share a bucket
+		SpatialHashGrid grid(Distance, count);
+		std::snprintf(name, sizeof(name), "%zu points, SpatialHashGrid", count);
+		Benchmark::Run(name, count, [&] {
+			Benchmark::DoNotOptimize(PairsGrid(grid, points, pairs));
+		}, 10, calls);
+		std::printf("  %-44s %12zu pairs\n", "", pairs.size());
+	}
+
+	Benchmark::Section("Broadphase: overlapping pairs of 20000 boxes moving a little each frame");
+
+	constexpr size_t BoxCount = 20000;
+	for (size_t largeEvery : { 0, 100 }) {
+		MovingBoxes boxes = RandomBoxes(BoxCount, largeEvery);
+		const char* scene = largeEvery == 0 ? "similar sizes" : "1% large";
+
+		SpatialHashGrid grid(boxes.largestExtent * 2.0f * 1.4142136f, BoxCount);
+		std::vector<IndexPair> candidates;
+		std::snprintf(name, sizeof(name), "%s, SpatialHashGrid rebuilt", scene);
+		Benchmark::Run(name, BoxCount, [&] {
+			boxes.Step();
+			Benchmark::DoNotOptimize(BoxPairsGrid(grid, boxes, candidates, pairs));
+		}, 5, 4);
+		std::printf("  %-44s %12zu pairs from %zu candidates\n", "", pairs.size(), candidates.size());
+
+		SweepAndPrune2 broadphase;
+		for (size_t i = 0; i < BoxCount; i++) {
+			broadphase.Add(boxes.Box(i));
+		}
+		broadphase.Update();
+		std::snprintf(name, sizeof(name), "%s, SweepAndPrune2 updated", scene);
+		Benchmark::Run(name, BoxCount, [&] {
+			boxes.Step();
+			Benchmark::DoNotOptimize(BoxPairsSweep(broadphase, boxes));
+		}, 5, 4);
+		std::printf("  %-44s %12zu pairs\n", "", broadphase.Pairs().size());
+	}
+}
@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+
+#include "Collision.h"
+
+#include <random>
+#include <vector>
+
+using MathClasses::AABB2;
+using MathClasses::AABB2Stream;
+using MathClasses::Capsule2;
+using MathClasses::Circle;
+using MathClasses::CircleStream;
+using MathClasses::Segment2;
+using MathClasses::Vector2;
+namespace Collision = MathClasses::Collision;
+
+/*
+ * Compares testing one shape against a list of candidates one at a time
+ * with Collision::Overlaps, against the four-wide Collision::OverlapMask
+ * kernels over structure-of-arrays streams. Both write a hit mask.
+ */
+namespace
+{
+	constexpr size_t Candidates = 4096;
+
+	template<typename Query, typename Shape>
+	BENCHMARK_NOINLINE size_t MaskEach(const Query& query, const std::vector<Shape>& others, uint32_t* mask)
+	{
+		std::fill(mask, mask + Collision::MaskWords(others.size()), 0u);
+		size_t hits = 0;
+		for (size_t i = 0; i < others.size(); i++) {
+			if (Collision::Overlaps(query, others[i])) {
+				mask[i / 32] |= 1u << (i % 32);
+				hits++;
+			}
+		}
+		return hits;
+	}
+
+	template<typename Query, typename Stream>
+	BENCHMARK_NOINLINE size_t MaskStream(const Query& query, const Stream& others, uint32_t* mask)
+	{
+		return Collision::OverlapMask(query, others, mask);
+	}
+}
+
+void RunCollisionBenchmarks()
+{
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+	std::vector<Circle> circles;
+	std::vector<AABB2> boxes;
+	CircleStream circleStream;
+	AABB2Stream boxStream;
+	for (size_t i = 0; i < Candidates; i++) {
+		Vector2 center(position(rng), position(rng));
+		circles.push_back(Circle(center, size(rng)));
+		boxes.push_back(AABB2::FromCenterExtents(center, Vector2(size(rng), size(rng))));
+		circleStream.PushBack(circles.back());
+		boxStream.PushBack(boxes.back());
+	}
+	std::vector<uint32_t> mask(Collision::MaskWords(Candidates));
+
+	const Circle circle(Vector2(10, -5), 20);
+	const AABB2 box(Vector2(-30, -10), Vector2(10, 20));
+	const Capsule2 capsule(Vector2(-80, -60), Vector2(70, 50), 5);
+	const Segment2 segment(Vector2(-90, 80), Vector2(85, -70));
+
+	Benchmark::Section("Collision: one query against 4096 candidates, hit mask");
+	Benchmark::Run("Circle vs circles, Overlaps each", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskEach(circle, circles, mask.data()));
+	});
+	Benchmark::Run("Circle vs circles, OverlapMask", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskStream(circle, circleStream, mask.data()));
+	});
+	Benchmark::Run("Circle vs boxes, Overlaps each", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskEach(circle, boxes, mask.data()));
+	});
+	Benchmark::Run("Circle vs boxes, OverlapMask", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskStream(circle, boxStream, mask.data()));
+	});
+	Benchmark::Run("Box vs boxes, Overlaps each", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskEach(box, boxes, mask.data()));
+	});
+	Benchmark::Run("Box vs boxes, OverlapMask", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskStream(box, boxStream, mask.data()));
+	});
+	Benchmark::Run("Capsule vs circles, Overlaps each", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskEach(capsule, circles, mask.data()));
+	});
+	Benchmark::Run("Capsule vs circles, OverlapMask", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskStream(capsule, circleStream, mask.data()));
+	});
+	Benchmark::Run("Segment vs boxes, Overlaps each", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskEach(segment, boxes, mask.data()));
+	});
+	Benchmark::Run("Segment vs boxes, OverlapMask", Candidates, [&] {
+		Benchmark::DoNotOptimize(MaskStream(segment, boxStream, mask.data()));
+	});
+}
@@ -0,0 +1,157 @@
+#include "Benchmark.h"
+
+#include "Color.h"
+#include "ColorSpace.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using MathClasses::Color;
+using MathClasses::HSV;
+using MathClasses::Vector4;
+namespace ColorKernels = MathClasses::ColorKernels;
+namespace ColorSpace = MathClasses::ColorSpace;
+
+/*
+ * Compares per-colour byte math against the four-wide ColorKernels, and
+ * pow-based colour-space conversion against the ColorSpace batch
+ * functions, on a batch about the size of a frame's sprites and particles.
+ */
+namespace
+{
+	constexpr size_t Count = 16384;
+
+	BENCHMARK_NOINLINE void TintScalar(const Color* in, Color tint, Color* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = in[i] * tint;
+		}
+	}
+
+	BENCHMARK_NOINLINE void TintBatched(const Color* in, Color tint, Color* out, size_t count)
+	{
+		ColorKernels::Tint(in, tint, out, count);
+	}
+
+	BENCHMARK_NOINLINE void BlendScalar(const Color* src, const Color* dst, Color* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = Color::Blend(src[i], dst[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void BlendBatched(const Color* src, const Color* dst, Color* out, size_t count)
+	{
+		ColorKernels::Blend(src, dst, out, count);
+	}
+
+	BENCHMARK_NOINLINE void FromVector4Scalar(const Vector4* in, Color* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = Color::FromVector4(in[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void FromVector4Batched(const Vector4* in, Color* out, size_t count)
+	{
+		ColorKernels::FromVector4(in, out, count);
+	}
+
+	float PowEncode(float x)
+	{
+		x = std::fmin(std::fmax(x, 0.0f), 1.0f);
+		return x <= 0.0031308f ? x * 12.92f : 1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+	}
+
+	BENCHMARK_NOINLINE void LinearToSrgbPow(const Vector4* in, Color* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = Color((uint8_t)(PowEncode(in[i].x) * 255.0f + 0.5f), (uint8_t)(PowEncode(in[i].y) * 255.0f + 0.5f),
+				(uint8_t)(PowEncode(in[i].z) * 255.0f + 0.5f), Color::ToByte(in[i].w));
+		}
+	}
+
+	BENCHMARK_NOINLINE void LinearToSrgbBatched(const Vector4* in, Color* out, size_t count)
+	{
+		ColorSpace::LinearToSrgb(in, out, count);
+	}
+
+	BENCHMARK_NOINLINE void ShiftHueScalar(const Color* in, float degrees, Color* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			HSV hsv = ColorSpace::RgbToHsv(in[i]);
+			hsv.h = std::fmod(hsv.h + degrees, 360.0f);
+			out[i] = ColorSpace::HsvToRgb(hsv);
+		}
+	}
+
+	BENCHMARK_NOINLINE void ShiftHueBatched(const Color* in, float degrees, Color* out, size_t count)
+	{
+		ColorSpace::ShiftHue(in, degrees, out, count);
+	}
+}
+
+void RunColorBenchmarks()
+{
+	std::vector<Color> src(Count), dst(Count), out(Count);
+	std::vector<Vector4> floats(Count);
+	uint32_t state = 12345;
+	for (size_t i = 0; i < Count; i++) {
+		state = state * 1664525u + 1013904223u;
+		src[i].rgba = state;
+		dst[i].rgba = state * 2654435761u;
+		floats[i] = src[i].ToVector4();
+	}
+	const Color tint(255, 200, 120, 180);
+
+	Benchmark::Section("Color: tint");
+	Benchmark::Run("operator* per colour", Count, [&] {
+		TintScalar(src.data(), tint, out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("ColorKernels::Tint", Count, [&] {
+		TintBatched(src.data(), tint, out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Color: alpha blend");
+	Benchmark::Run("Color::Blend per colour", Count, [&] {
+		BlendScalar(src.data(), dst.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("ColorKernels::Blend", Count, [&] {
+		BlendBatched(src.data(), dst.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Color: float to byte");
+	Benchmark::Run("Color::FromVector4 per colour", Count, [&] {
+		FromVector4Scalar(floats.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("ColorKernels::FromVector4", Count, [&] {
+		FromVector4Batched(floats.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("ColorSpace: linear to sRGB");
+	Benchmark::Run("std::pow per channel", Count, [&] {
+		LinearToSrgbPow(floats.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("ColorSpace::LinearToSrgb batched", Count, [&] {
+		LinearToSrgbBatched(floats.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("ColorSpace: hue shift");
+	Benchmark::Run("RgbToHsv/HsvToRgb per colour", Count, [&] {
+		ShiftHueScalar(src.data(), 90.0f, out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("ColorSpace::ShiftHue", Count, [&] {
+		ShiftHueBatched(src.data(), 90.0f, out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+}
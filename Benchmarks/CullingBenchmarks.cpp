@@ -0,0 +1,100 @@
+#include "Benchmark.h"
+
+#include "Bounds.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using MathClasses::AABB;
+using MathClasses::AABBStream;
+using MathClasses::Frustum;
+using MathClasses::Matrix4;
+using MathClasses::Sphere;
+using MathClasses::SphereStream;
+using MathClasses::Vector3;
+
+/*
+ * Compares culling an array of bounds one object at a time with the
+ * Frustum::Intersects tests, against the structure-of-arrays Frustum::Cull
+ * kernels, both writing a compacted list of visible indices. Reports
+ * objects culled per millisecond.
+ */
+namespace
+{
+	constexpr size_t Objects = 65536;
+
+	BENCHMARK_NOINLINE size_t CullSpheresEach(const Frustum& frustum, const std::vector<Sphere>& spheres, uint32_t* visible)
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < spheres.size(); i++) {
+			if (frustum.Intersects(spheres[i])) { visible[count++] = (uint32_t)i; }
+		}
+		return count;
+	}
+
+	BENCHMARK_NOINLINE size_t CullBoxesEach(const Frustum& frustum, const std::vector<AABB>& boxes, uint32_t* visible)
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < boxes.size(); i++) {
+			if (frustum.Intersects(boxes[i])) { visible[count++] = (uint32_t)i; }
+		}
+		return count;
+	}
+
+	BENCHMARK_NOINLINE size_t CullSpheresStream(const Frustum& frustum, const SphereStream& spheres, uint32_t* visible)
+	{
+		return frustum.CullSpheres(spheres, visible);
+	}
+
+	BENCHMARK_NOINLINE size_t CullBoxesStream(const Frustum& frustum, const AABBStream& boxes, uint32_t* visible)
+	{
+		return frustum.CullBoxes(boxes, visible);
+	}
+
+	void PrintRate(double nanosecondsPerCall)
+	{
+		std::printf("  %-44s %12.0f objects/ms\n", "", Objects / nanosecondsPerCall * 1.0e6);
+	}
+}
+
+void RunCullingBenchmarks()
+{
+	Matrix4 camera = Matrix4::MakeTRS(Vector3(0, 2, 0), Vector3(0, 0.6f, 0), Vector3(1, 1, 1));
+	Frustum frustum = Frustum::FromMatrix(Matrix4::MakePerspective(1.0f, 16.0f / 9.0f, 0.5f, 200.0f) * camera.AffineInverted());
+
+	// objects scattered around the camera, so roughly a fifth are visible
+	// and the visibility of neighbouring objects is unpredictable
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+	std::uniform_real_distribution<float> size(0.25f, 2.0f);
+	std::vector<Sphere> spheres;
+	std::vector<AABB> boxes;
+	SphereStream sphereStream;
+	AABBStream boxStream;
+	for (size_t i = 0; i < Objects; i++) {
+		Vector3 center(position(rng), position(rng) * 0.1f, position(rng));
+		Vector3 extents(size(rng), size(rng), size(rng));
+		spheres.push_back(Sphere(center, extents.Magnitude()));
+		boxes.push_back(AABB::FromCenterExtents(center, extents));
+		sphereStream.PushBack(spheres.back());
+		boxStream.PushBack(boxes.back());
+	}
+	std::vector<uint32_t> visible(Objects);
+
+	char title[96];
+	std::snprintf(title, sizeof(title), "Frustum culling: 65536 objects, %zu visible", frustum.CullBoxes(boxStream, visible.data()));
+	Benchmark::Section(title);
+	PrintRate(Benchmark::Run("Spheres, Intersects per object", Objects, [&] {
+		Benchmark::DoNotOptimize(CullSpheresEach(frustum, spheres, visible.data()));
+	}, 10, 10));
+	PrintRate(Benchmark::Run("Spheres, Frustum::CullSpheres", Objects, [&] {
+		Benchmark::DoNotOptimize(CullSpheresStream(frustum, sphereStream, visible.data()));
+	}, 10, 10));
+	PrintRate(Benchmark::Run("Boxes, Intersects per object", Objects, [&] {
+		Benchmark::DoNotOptimize(CullBoxesEach(frustum, boxes, visible.data()));
+	}, 10, 10));
+	PrintRate(Benchmark::Run("Boxes, Frustum::CullBoxes", Objects, [&] {
+		Benchmark::DoNotOptimize(CullBoxesStream(frustum, boxStream, visible.data()));
+	}, 10, 10));
+}
@@ -0,0 +1,146 @@
+#include "Benchmark.h"
+
+#include "Utils.h"
+#include "VectorStream.h"
+
+#include <vector>
+
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+namespace Easing = MathClasses::Easing;
+
+/*
+ * Compares calling the scalar interpolation templates in Utils.h once per
+ * value against the array kernels, on a batch about the size of a frame's
+ * running tweens.
+ */
+namespace
+{
+	constexpr size_t Count = 16384;
+
+	BENCHMARK_NOINLINE void LerpScalar(const float* start, const float* end, const float* alpha, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = MathClasses::Lerp(start[i], end[i], alpha[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void LerpBatched(const float* start, const float* end, const float* alpha, float* out, size_t count)
+	{
+		MathClasses::LerpArray(start, end, alpha, out, count);
+	}
+
+	BENCHMARK_NOINLINE void SmoothStepScalar(const float* in, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = MathClasses::SmoothStep(0.0f, 1.0f, in[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void SmoothStepBatched(const float* in, float* out, size_t count)
+	{
+		MathClasses::SmoothStepArray(0.0f, 1.0f, in, out, count);
+	}
+
+	BENCHMARK_NOINLINE void RemapScalar(const float* in, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = MathClasses::Remap(-1.0f, 2.0f, 10.0f, 20.0f, in[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void RemapBatched(const float* in, float* out, size_t count)
+	{
+		MathClasses::RemapArray(-1.0f, 2.0f, 10.0f, 20.0f, in, out, count);
+	}
+
+	BENCHMARK_NOINLINE void EaseScalar(const float* in, float* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = Easing::InOutCubic::Apply(in[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void EaseBatched(const float* in, float* out, size_t count)
+	{
+		MathClasses::EaseArray<Easing::InOutCubic>(in, out, count);
+	}
+
+	BENCHMARK_NOINLINE void TweenScalar(const Vector3* start, const Vector3* end, const float* alpha, Vector3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = MathClasses::Lerp(start[i], end[i], Easing::OutCubic::Apply(alpha[i]));
+		}
+	}
+
+	BENCHMARK_NOINLINE void TweenBatched(const Vector3Stream& start, const Vector3Stream& end, const float* alpha, float* eased, Vector3Stream& out)
+	{
+		MathClasses::EaseArray<Easing::OutCubic>(alpha, eased, start.Size());
+		Vector3Stream::Lerp(start, end, eased, out);
+	}
+}
+
+void RunEasingBenchmarks()
+{
+	std::vector<float> start(Count), end(Count), alpha(Count), out(Count);
+	std::vector<Vector3> startAoS(Count), endAoS(Count), outAoS(Count);
+	for (size_t i = 0; i < Count; i++) {
+		float f = (float)i;
+		start[i] = f * 0.5f;
+		end[i] = 100.0f - f * 0.25f;
+		alpha[i] = (float)((i * 7919) % 1000) / 999.0f;
+		startAoS[i] = Vector3(start[i], -f, f * 0.1f);
+		endAoS[i] = Vector3(end[i], f, -f * 0.1f);
+	}
+	Vector3Stream startSoA = Vector3Stream::FromArray(startAoS.data(), Count);
+	Vector3Stream endSoA = Vector3Stream::FromArray(endAoS.data(), Count);
+	Vector3Stream outSoA(Count);
+
+	Benchmark::Section("Easing: lerp with per-element alpha");
+	Benchmark::Run("Lerp per value", Count, [&] {
+		LerpScalar(start.data(), end.data(), alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("LerpArray", Count, [&] {
+		LerpBatched(start.data(), end.data(), alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Easing: smoothstep and remap");
+	Benchmark::Run("SmoothStep per value", Count, [&] {
+		SmoothStepScalar(alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("SmoothStepArray", Count, [&] {
+		SmoothStepBatched(alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("Remap per value", Count, [&] {
+		RemapScalar(alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("RemapArray", Count, [&] {
+		RemapBatched(alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Easing: InOutCubic");
+	Benchmark::Run("Apply per value", Count, [&] {
+		EaseScalar(alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("EaseArray", Count, [&] {
+		EaseBatched(alpha.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Easing: Vector3 tween (OutCubic then lerp)");
+	Benchmark::Run("Lerp<Vector3> per element", Count, [&] {
+		TweenScalar(startAoS.data(), endAoS.data(), alpha.data(), outAoS.data(), Count);
+		Benchmark::DoNotOptimize(outAoS[0]);
+	});
+	Benchmark::Run("EaseArray + Vector3Stream::Lerp", Count, [&] {
+		TweenBatched(startSoA, endSoA, alpha.data(), out.data(), outSoA);
+		Benchmark::DoNotOptimize(outSoA.x[0]);
+	});
+}
@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+
+#include "Vector3.h"
+#include "VectorStream.h"
+#include "VectorExpr.h"
+
+#include <vector>
+
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+using MathClasses::Expr::Lazy;
+
+namespace Expr = MathClasses::Expr;
+
+/*
+ * Compares the expression templates in VectorExpr.h against the plain
+ * operators for out = a + b * s - c, and for the distance between points.
+ */
+namespace
+{
+	constexpr size_t Count = 16384;
+
+	BENCHMARK_NOINLINE void OperatorsAoS(const Vector3* a, const Vector3* b, const Vector3* c, float s, Vector3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = a[i] + b[i] * s - c[i];
+		}
+	}
+
+	BENCHMARK_NOINLINE void ExpressionAoS(const Vector3* a, const Vector3* b, const Vector3* c, float s, Vector3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			Expr::Assign(out[i], Lazy(a[i]) + Lazy(b[i]) * s - Lazy(c[i]));
+		}
+	}
+
+	BENCHMARK_NOINLINE float OperatorsDistance(const Vector3* a, const Vector3* b, size_t count)
+	{
+		float total = 0;
+		for (size_t i = 0; i < count; i++) {
+			total += a[i].Distance(b[i]);
+		}
+		return total;
+	}
+
+	BENCHMARK_NOINLINE float ExpressionDistance(const Vector3* a, const Vector3* b, size_t count)
+	{
+		float total = 0;
+		for (size_t i = 0; i < count; i++) {
+			total += Expr::Magnitude(Lazy(a[i]) - Lazy(b[i]));
+		}
+		return total;
+	}
+
+	// three passes over memory with one temporary stream
+	BENCHMARK_NOINLINE void OperatorsSoA(const Vector3Stream& a, const Vector3Stream& b, const Vector3Stream& c, float s, Vector3Stream& temp, Vector3Stream& out)
+	{
+		Vector3Stream::Scale(b, s, temp);
+		Vector3Stream::Add(a, temp, temp);
+		Vector3Stream::Sub(temp, c, out);
+	}
+
+	// one pass, intermediates stay in registers
+	BENCHMARK_NOINLINE void ExpressionSoA(const Vector3Stream& a, const Vector3Stream& b, const Vector3Stream& c, float s, Vector3Stream& out)
+	{
+		Expr::Assign(out, Lazy(a) + Lazy(b) * s - Lazy(c));
+	}
+}
+
+void RunExpressionBenchmarks()
+{
+	std::vector<Vector3> a(Count), b(Count), c(Count), out(Count);
+	for (size_t i = 0; i < Count; i++) {
+		a[i] = Vector3((float)i, (float)(i % 7), 1.0f);
+		b[i] = Vector3(0.5f, (float)(i % 13), (float)i * 0.25f);
+		c[i] = Vector3(1.0f, 2.0f, (float)(i % 5));
+	}
+	Vector3Stream sa = Vector3Stream::FromArray(a.data(), Count);
+	Vector3Stream sb = Vector3Stream::FromArray(b.data(), Count);
+	Vector3Stream sc = Vector3Stream::FromArray(c.data(), Count);
+	Vector3Stream sTemp(Count), sOut(Count);
+	const float s = 1.75f;
+
+	Benchmark::Section("Expression templates: out = a + b * s - c");
+	Benchmark::Run("Vector3 operators", Count, [&] {
+		OperatorsAoS(a.data(), b.data(), c.data(), s, out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("Vector3 Expr::Assign", Count, [&] {
+		ExpressionAoS(a.data(), b.data(), c.data(), s, out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("Vector3Stream Scale/Add/Sub", Count, [&] {
+		OperatorsSoA(sa, sb, sc, s, sTemp, sOut);
+		Benchmark::DoNotOptimize(sOut.x[0]);
+	});
+	Benchmark::Run("Vector3Stream Expr::Assign", Count, [&] {
+		ExpressionSoA(sa, sb, sc, s, sOut);
+		Benchmark::DoNotOptimize(sOut.x[0]);
+	});
+
+	Benchmark::Section("Expression templates: distance");
+	Benchmark::Run("Vector3::Distance", Count, [&] {
+		float total = OperatorsDistance(a.data(), b.data(), Count);
+		Benchmark::DoNotOptimize(total);
+	});
+	Benchmark::Run("Expr::Magnitude(a - b)", Count, [&] {
+		float total = ExpressionDistance(a.data(), b.data(), Count);
+		Benchmark::DoNotOptimize(total);
+	});
+}
@@ -0,0 +1,17 @@
+#include "Benchmark.h"
+
+int main()
+{
+	RunExpressionBenchmarks();
+	RunPrecisionBenchmarks();
+	RunTransformBenchmarks();
+	RunPackingBenchmarks();
+	RunColorBenchmarks();
+	RunEasingBenchmarks();
+	RunSplineBenchmarks();
+	RunSkinningBenchmarks();
+	RunCullingBenchmarks();
+	RunCollisionBenchmarks();
+	RunBroadphaseBenchmarks();
+	return 0;
+}
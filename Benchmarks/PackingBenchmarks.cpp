@@ -0,0 +1,148 @@
+#include "Benchmark.h"
+
+#include "PackedVector.h"
+
+#include <cmath>
+#include <vector>
+
+using MathClasses::Half;
+using MathClasses::OctahedralNormal;
+using MathClasses::QuantisationBox;
+using MathClasses::Vector3;
+using MathClasses::Vector3h;
+using MathClasses::Vector3q16;
+using MathClasses::Vector3Stream;
+namespace Packing = MathClasses::Packing;
+
+/*
+ * Compares converting vectors one at a time through the scalar packed
+ * types against the four-wide stream kernels in Packing.
+ */
+namespace
+{
+	constexpr size_t Count = 16384;
+
+	BENCHMARK_NOINLINE void HalfPackScalar(const Vector3Stream& in, Vector3h* out)
+	{
+		for (size_t i = 0; i < in.Size(); i++) {
+			out[i] = { Half(in.x[i]), Half(in.y[i]), Half(in.z[i]) };
+		}
+	}
+
+	BENCHMARK_NOINLINE void HalfPackBatched(const Vector3Stream& in, Vector3h* out)
+	{
+		Packing::Pack(in, out);
+	}
+
+	BENCHMARK_NOINLINE void HalfUnpackScalar(const Vector3h* in, size_t count, Vector3Stream& out)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out.x[i] = in[i].x;
+			out.y[i] = in[i].y;
+			out.z[i] = in[i].z;
+		}
+	}
+
+	BENCHMARK_NOINLINE void HalfUnpackBatched(const Vector3h* in, size_t count, Vector3Stream& out)
+	{
+		Packing::Unpack(in, count, out);
+	}
+
+	BENCHMARK_NOINLINE void QuantisedPackScalar(const Vector3Stream& in, const QuantisationBox& box, Vector3q16* out)
+	{
+		for (size_t i = 0; i < in.Size(); i++) {
+			out[i] = box.Pack(in.Get(i));
+		}
+	}
+
+	BENCHMARK_NOINLINE void QuantisedPackBatched(const Vector3Stream& in, const QuantisationBox& box, Vector3q16* out)
+	{
+		Packing::Pack(in, box, out);
+	}
+
+	BENCHMARK_NOINLINE void NormalPackScalar(const Vector3Stream& in, OctahedralNormal* out)
+	{
+		for (size_t i = 0; i < in.Size(); i++) {
+			out[i] = OctahedralNormal::Encode(in.Get(i));
+		}
+	}
+
+	BENCHMARK_NOINLINE void NormalPackBatched(const Vector3Stream& in, OctahedralNormal* out)
+	{
+		Packing::PackNormals(in, out);
+	}
+
+	BENCHMARK_NOINLINE void NormalUnpackScalar(const OctahedralNormal* in, size_t count, Vector3Stream& out)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out.Set(i, in[i].Decode());
+		}
+	}
+
+	BENCHMARK_NOINLINE void NormalUnpackBatched(const OctahedralNormal* in, size_t count, Vector3Stream& out)
+	{
+		Packing::UnpackNormals(in, count, out);
+	}
+}
+
+void RunPackingBenchmarks()
+{
+	Vector3Stream positions, normals, out;
+	for (size_t i = 0; i < Count; i++) {
+		float f = (float)i;
+		positions.PushBack(Vector3(std::sin(f) * 100.0f, f * 0.01f, std::cos(f * 0.7f) * 50.0f));
+		normals.PushBack(Vector3(std::sin(f), std::cos(f * 1.3f), std::sin(f * 0.3f) - 0.5f).Normalised());
+	}
+	out.Resize(Count);
+
+	QuantisationBox box(Vector3(-100, 0, -50), Vector3(100, Count * 0.01f, 50));
+	std::vector<Vector3h> halves(Count);
+	std::vector<Vector3q16> quantised(Count);
+	std::vector<OctahedralNormal> octahedral(Count);
+
+	Benchmark::Section("Packing: Vector3h");
+	Benchmark::Run("Pack per element", Count, [&] {
+		HalfPackScalar(positions, halves.data());
+		Benchmark::DoNotOptimize(halves[0]);
+	});
+	Benchmark::Run("Pack batched", Count, [&] {
+		HalfPackBatched(positions, halves.data());
+		Benchmark::DoNotOptimize(halves[0]);
+	});
+	Benchmark::Run("Unpack per element", Count, [&] {
+		HalfUnpackScalar(halves.data(), Count, out);
+		Benchmark::DoNotOptimize(out.x[0]);
+	});
+	Benchmark::Run("Unpack batched", Count, [&] {
+		HalfUnpackBatched(halves.data(), Count, out);
+		Benchmark::DoNotOptimize(out.x[0]);
+	});
+
+	Benchmark::Section("Packing: Vector3q16");
+	Benchmark::Run("Pack per element", Count, [&] {
+		QuantisedPackScalar(positions, box, quantised.data());
+		Benchmark::DoNotOptimize(quantised[0]);
+	});
+	Benchmark::Run("Pack batched", Count, [&] {
+		QuantisedPackBatched(positions, box, quantised.data());
+		Benchmark::DoNotOptimize(quantised[0]);
+	});
+
+	Benchmark::Section("Packing: OctahedralNormal");
+	Benchmark::Run("Encode per element", Count, [&] {
+		NormalPackScalar(normals, octahedral.data());
+		Benchmark::DoNotOptimize(octahedral[0]);
+	});
+	Benchmark::Run("Encode batched", Count, [&] {
+		NormalPackBatched(normals, octahedral.data());
+		Benchmark::DoNotOptimize(octahedral[0]);
+	});
+	Benchmark::Run("Decode per element", Count, [&] {
+		NormalUnpackScalar(octahedral.data(), Count, out);
+		Benchmark::DoNotOptimize(out.x[0]);
+	});
+	Benchmark::Run("Decode batched", Count, [&] {
+		NormalUnpackBatched(octahedral.data(), Count, out);
+		Benchmark::DoNotOptimize(out.x[0]);
+	});
+}
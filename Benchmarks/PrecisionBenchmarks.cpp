@@ -0,0 +1,105 @@
+#include "Benchmark.h"
+
+#include "Precision.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+
+#include <vector>
+
+using MathClasses::Precision;
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+
+/*
+ * Compares Precision::Exact against Precision::Fast for the operations
+ * that take a precision policy.
+ */
+namespace
+{
+	constexpr size_t Count = 16384;
+
+	template<Precision P>
+	BENCHMARK_NOINLINE void NormaliseArray(const Vector3* in, Vector3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = in[i].Normalised<P>();
+		}
+	}
+
+	template<Precision P>
+	BENCHMARK_NOINLINE void NormaliseStream(Vector3Stream& stream)
+	{
+		stream.Normalise<P>();
+	}
+
+	template<Precision P>
+	BENCHMARK_NOINLINE float SinCosArray(const float* angles, size_t count)
+	{
+		float total = 0;
+		for (size_t i = 0; i < count; i++) {
+			float s, c;
+			MathClasses::SinCos<P>(angles[i], s, c);
+			total += s * c;
+		}
+		return total;
+	}
+
+	template<Precision P>
+	BENCHMARK_NOINLINE float Atan2Array(const float* ys, const float* xs, size_t count)
+	{
+		float total = 0;
+		for (size_t i = 0; i < count; i++) {
+			total += MathClasses::Atan2<P>(ys[i], xs[i]);
+		}
+		return total;
+	}
+}
+
+void RunPrecisionBenchmarks()
+{
+	std::vector<Vector3> points(Count), out(Count);
+	std::vector<float> angles(Count), xs(Count), ys(Count);
+	for (size_t i = 0; i < Count; i++) {
+		points[i] = Vector3((float)i + 1.0f, (float)(i % 7) - 3.0f, 0.5f);
+		angles[i] = (float)i * 0.01f - 80.0f;
+		xs[i] = (float)(i % 97) - 48.0f;
+		ys[i] = (float)(i % 89) - 44.5f;
+	}
+	Vector3Stream stream = Vector3Stream::FromArray(points.data(), Count);
+
+	Benchmark::Section("Precision: normalise");
+	Benchmark::Run("Vector3::Normalised<Exact>", Count, [&] {
+		NormaliseArray<Precision::Exact>(points.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("Vector3::Normalised<Fast>", Count, [&] {
+		NormaliseArray<Precision::Fast>(points.data(), out.data(), Count);
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("Vector3Stream::Normalise<Exact>", Count, [&] {
+		NormaliseStream<Precision::Exact>(stream);
+		Benchmark::DoNotOptimize(stream.x[0]);
+	});
+	Benchmark::Run("Vector3Stream::Normalise<Fast>", Count, [&] {
+		NormaliseStream<Precision::Fast>(stream);
+		Benchmark::DoNotOptimize(stream.x[0]);
+	});
+
+	Benchmark::Section("Precision: trigonometry");
+	Benchmark::Run("SinCos<Exact>", Count, [&] {
+		float total = SinCosArray<Precision::Exact>(angles.data(), Count);
+		Benchmark::DoNotOptimize(total);
+	});
+	Benchmark::Run("SinCos<Fast>", Count, [&] {
+		float total = SinCosArray<Precision::Fast>(angles.data(), Count);
+		Benchmark::DoNotOptimize(total);
+	});
+	Benchmark::Run("Atan2<Exact>", Count, [&] {
+		float total = Atan2Array<Precision::Exact>(ys.data(), xs.data(), Count);
+		Benchmark::DoNotOptimize(total);
+	});
+	Benchmark::Run("Atan2<Fast>", Count, [&] {
+		float total = Atan2Array<Precision::Fast>(ys.data(), xs.data(), Count);
+		Benchmark::DoNotOptimize(total);
+	});
+}
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+
+#include "Skinning.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using MathClasses::Matrix4;
+using MathClasses::SkinWeightStream;
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+using MathClasses::Vector4;
+namespace Skinning = MathClasses::Skinning;
+
+/*
+ * Compares skinning by transforming each vertex by each of its bones and
+ * summing, against the blended-matrix Skinning kernels on one thread and
+ * across every hardware thread. Reports vertices per second.
+ */
+namespace
+{
+	constexpr size_t Vertices = 65536;
+	constexpr size_t Bones = 64;
+
+	BENCHMARK_NOINLINE void SkinPerBone(const Matrix4* palette, const SkinWeightStream& influences, const Vector3Stream& positions,
+										const Vector3Stream& normals, Vector3Stream& outPositions, Vector3Stream& outNormals)
+	{
+		for (size_t i = 0; i < positions.Size(); i++) {
+			Vector3 p = positions.Get(i), n = normals.Get(i);
+			Vector4 skinnedP, skinnedN;
+			for (size_t k = 0; k < SkinWeightStream::MaxInfluences; k++) {
+				const Matrix4& m = palette[influences.bone[k][i]];
+				float w = influences.weight[k][i];
+				skinnedP = skinnedP + (m * Vector4(p.x, p.y, p.z, 1.0f)) * w;
+				skinnedN = skinnedN + (m * Vector4(n.x, n.y, n.z, 0.0f)) * w;
+			}
+			outPositions.Set(i, Vector3(skinnedP.x, skinnedP.y, skinnedP.z));
+			outNormals.Set(i, Vector3(skinnedN.x, skinnedN.y, skinnedN.z).Normalised());
+		}
+	}
+
+	BENCHMARK_NOINLINE void SkinSingle(const Matrix4* palette, const SkinWeightStream& influences, const Vector3Stream& positions,
+									   const Vector3Stream& normals, Vector3Stream& outPositions, Vector3Stream& outNormals)
+	{
+		Skinning::Skin(palette, influences, positions, normals, outPositions, outNormals);
+	}
+
+	BENCHMARK_NOINLINE void SkinThreaded(const Matrix4* palette, const SkinWeightStream& influences, const Vector3Stream& positions,
+										 const Vector3Stream& normals, Vector3Stream& outPositions, Vector3Stream& outNormals)
+	{
+		Skinning::SkinParallel(palette, influences, positions, normals, outPositions, outNormals);
+	}
+
+	void PrintRate(double nanosecondsPerCall)
+	{
+		std::printf("  %-44s %12.1f M vertices/s\n", "", Vertices / nanosecondsPerCall * 1000.0);
+	}
+}
+
+void RunSkinningBenchmarks()
+{
+	std::vector<Matrix4> palette(Bones);
+	for (size_t b = 0; b < Bones; b++) {
+		float f = (float)b;
+		palette[b] = Matrix4::MakeTRS(Vector3(f, -f, f * 0.5f), Vector3(f * 0.1f, f * 0.2f, f * -0.3f), Vector3(1, 1, 1));
+	}
+
+	SkinWeightStream influences;
+	Vector3Stream positions, normals, outPositions(Vertices), outNormals(Vertices);
+	for (size_t i = 0; i < Vertices; i++) {
+		float f = (float)i;
+		uint16_t bone = (uint16_t)(i % Bones);
+		influences.PushBack({ bone, (uint16_t)((bone + 1) % Bones), (uint16_t)((bone + 7) % Bones), 0 }, { 0.5f, 0.3f, 0.2f, 0.0f });
+		positions.PushBack(Vector3(f * 0.001f, 1.0f, -f * 0.002f));
+		normals.PushBack(Vector3(0, 1, 0));
+	}
+
+	Benchmark::Section("Skinning: 65536 vertices, 4 influences");
+	PrintRate(Benchmark::Run("Transform per bone and sum", Vertices, [&] {
+		SkinPerBone(palette.data(), influences, positions, normals, outPositions, outNormals);
+		Benchmark::DoNotOptimize(outPositions.x[0]);
+	}, 5, 4));
+	PrintRate(Benchmark::Run("Skinning::Skin", Vertices, [&] {
+		SkinSingle(palette.data(), influences, positions, normals, outPositions, outNormals);
+		Benchmark::DoNotOptimize(outPositions.x[0]);
+	}, 5, 4));
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "Skinning::SkinParallel (%u threads)", std::max(1u, std::thread::hardware_concurrency()));
+	PrintRate(Benchmark::Run(label, Vertices, [&] {
+		SkinThreaded(palette.data(), influences, positions, normals, outPositions, outNormals);
+		Benchmark::DoNotOptimize(outPositions.x[0]);
+	}, 5, 4));
+}
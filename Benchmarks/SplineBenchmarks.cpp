@@ -0,0 +1,106 @@
+#include "Benchmark.h"
+
+#include "Spline.h"
+#include "VectorStream.h"
+
+#include <vector>
+
+using MathClasses::CubicCurve3;
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+using MathClasses::CurveStepper;
+using MathClasses::CurveStream;
+
+/*
+ * Compares evaluating cubic curves one point at a time against forward
+ * differencing and the batched curve types, for a path sampled densely
+ * and for many agents each following their own path.
+ */
+namespace
+{
+	constexpr size_t Samples = 16384;
+	constexpr size_t Agents = 4096;
+
+	BENCHMARK_NOINLINE void SampleEvaluate(const CubicCurve3& curve, Vector3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = curve.Evaluate(i / (float)(count - 1));
+		}
+	}
+
+	BENCHMARK_NOINLINE void SampleForwardDifference(const CubicCurve3& curve, Vector3* out, size_t count)
+	{
+		curve.Sample(out, count);
+	}
+
+	BENCHMARK_NOINLINE void AgentsEvaluate(const CubicCurve3* curves, const float* t, Vector3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = curves[i].Evaluate(t[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void AgentsStream(const CurveStream<Vector3>& stream, const float* t, Vector3* out)
+	{
+		stream.Evaluate(t, out);
+	}
+
+	BENCHMARK_NOINLINE void AgentsStreamSoA(const CurveStream<Vector3>& stream, const float* t, Vector3Stream& out)
+	{
+		stream.Evaluate(t, { out.x.data(), out.y.data(), out.z.data() });
+	}
+
+	BENCHMARK_NOINLINE void AgentsStep(CurveStepper<Vector3>& stepper)
+	{
+		stepper.Step();
+	}
+}
+
+void RunSplineBenchmarks()
+{
+	CubicCurve3 path = CubicCurve3::FromBezier(Vector3(0, 0, 0), Vector3(10, 40, -5), Vector3(60, -20, 5), Vector3(100, 0, 0));
+	std::vector<Vector3> points(Samples);
+
+	std::vector<CubicCurve3> curves(Agents);
+	std::vector<float> t(Agents);
+	CurveStream<Vector3> stream;
+	CurveStepper<Vector3> stepper;
+	for (size_t i = 0; i < Agents; i++) {
+		float f = (float)i;
+		curves[i] = CubicCurve3::FromCatmullRom(Vector3(-f, 0, 0), Vector3(0, f, 0), Vector3(f, 0, f), Vector3(0, -f, 2 * f));
+		t[i] = (float)(i % 100) / 100.0f;
+		stream.PushBack(curves[i]);
+		// enough steps that the benchmark's repeated calls stay on the curve
+		stepper.PushBack(curves[i], 1 << 20);
+	}
+	std::vector<Vector3> positions(Agents);
+	Vector3Stream positionsSoA(Agents);
+
+	Benchmark::Section("Spline: sampling one curve");
+	Benchmark::Run("Evaluate per sample", Samples, [&] {
+		SampleEvaluate(path, points.data(), Samples);
+		Benchmark::DoNotOptimize(points[0]);
+	});
+	Benchmark::Run("Sample (forward differencing)", Samples, [&] {
+		SampleForwardDifference(path, points.data(), Samples);
+		Benchmark::DoNotOptimize(points[0]);
+	});
+
+	Benchmark::Section("Spline: one sample for each of many curves");
+	Benchmark::Run("Evaluate per curve", Agents, [&] {
+		AgentsEvaluate(curves.data(), t.data(), positions.data(), Agents);
+		Benchmark::DoNotOptimize(positions[0]);
+	});
+	Benchmark::Run("CurveStream::Evaluate", Agents, [&] {
+		AgentsStream(stream, t.data(), positions.data());
+		Benchmark::DoNotOptimize(positions[0]);
+	});
+	Benchmark::Run("CurveStream::Evaluate to components", Agents, [&] {
+		AgentsStreamSoA(stream, t.data(), positionsSoA);
+		Benchmark::DoNotOptimize(positionsSoA.x[0]);
+	});
+	Benchmark::Run("CurveStepper::Step", Agents, [&] {
+		AgentsStep(stepper);
+		Benchmark::DoNotOptimize(stepper.position[0][0]);
+	});
+}
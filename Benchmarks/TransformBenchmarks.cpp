@@ -0,0 +1,177 @@
+#include "Benchmark.h"
+
+#include "Affine2D.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "VectorStream.h"
+
+#include <vector>
+
+using MathClasses::Affine2D;
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Vector2;
+using MathClasses::Vector2Stream;
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+
+/*
+ * Compares building local transforms by multiplying the individual
+ * factory matrices against the closed-form MakeEuler and MakeTRS, and
+ * 2D scene work done with Matrix3 against Affine2D.
+ */
+namespace
+{
+	constexpr size_t Count = 4096;
+
+	BENCHMARK_NOINLINE void EulerProduct(const Vector3Stream& rotations, Matrix4* out)
+	{
+		for (size_t i = 0; i < rotations.Size(); i++) {
+			out[i] = Matrix4::MakeRotateZ(rotations.z[i]) * Matrix4::MakeRotateY(rotations.y[i]) * Matrix4::MakeRotateX(rotations.x[i]);
+		}
+	}
+
+	BENCHMARK_NOINLINE void EulerClosedForm(const Vector3Stream& rotations, Matrix4* out)
+	{
+		for (size_t i = 0; i < rotations.Size(); i++) {
+			out[i] = Matrix4::MakeEuler(rotations.Get(i));
+		}
+	}
+
+	BENCHMARK_NOINLINE void TRSProduct(const Vector3Stream& translations, const Vector3Stream& rotations, const Vector3Stream& scales, Matrix4* out)
+	{
+		for (size_t i = 0; i < translations.Size(); i++) {
+			out[i] = Matrix4::MakeTranslation(translations.Get(i)) * Matrix4::MakeEuler(rotations.Get(i)) * Matrix4::MakeScale(scales.Get(i));
+		}
+	}
+
+	BENCHMARK_NOINLINE void TRSSingle(const Vector3Stream& translations, const Vector3Stream& rotations, const Vector3Stream& scales, Matrix4* out)
+	{
+		for (size_t i = 0; i < translations.Size(); i++) {
+			out[i] = Matrix4::MakeTRS(translations.Get(i), rotations.Get(i), scales.Get(i));
+		}
+	}
+
+	BENCHMARK_NOINLINE void TRSBatched(const Vector3Stream& translations, const Vector3Stream& rotations, const Vector3Stream& scales, Matrix4* out)
+	{
+		Matrix4::MakeTRS(translations, rotations, scales, out);
+	}
+
+	BENCHMARK_NOINLINE void TRS2DProduct(const Vector2Stream& translations, const float* rotations, const Vector2Stream& scales, Matrix3* out)
+	{
+		for (size_t i = 0; i < translations.Size(); i++) {
+			Vector2 scale = scales.Get(i);
+			out[i] = Matrix3::MakeTranslation(translations.Get(i)) * Matrix3::MakeRotateZ(rotations[i]) * Matrix3::MakeScale(scale.x, scale.y);
+		}
+	}
+
+	BENCHMARK_NOINLINE void TRS2DBatched(const Vector2Stream& translations, const float* rotations, const Vector2Stream& scales, Matrix3* out)
+	{
+		Matrix3::MakeTRS(translations, rotations, scales, out);
+	}
+
+	BENCHMARK_NOINLINE void ComposeMatrix3(const Matrix3* parents, const Matrix3* locals, Matrix3* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			out[i] = parents[i] * locals[i];
+		}
+	}
+
+	BENCHMARK_NOINLINE void ComposeAffine2D(const Affine2D* parents, const Affine2D* locals, Affine2D* out, size_t count)
+	{
+		Affine2D::Multiply(parents, locals, out, count);
+	}
+
+	BENCHMARK_NOINLINE void PointsMatrix3(const Matrix3& transform, const Vector2* in, Vector2* out, size_t count)
+	{
+		transform.TransformPoints(in, out, count);
+	}
+
+	BENCHMARK_NOINLINE void PointsAffine2D(const Affine2D& transform, const Vector2* in, Vector2* out, size_t count)
+	{
+		transform.TransformPoints(in, out, count);
+	}
+}
+
+void RunTransformBenchmarks()
+{
+	Vector3Stream translations, rotations, scales;
+	Vector2Stream translations2D, scales2D;
+	std::vector<float> rotations2D(Count);
+	for (size_t i = 0; i < Count; i++) {
+		float f = (float)i;
+		translations.PushBack(Vector3(f, f * 0.5f, -f));
+		rotations.PushBack(Vector3(f * 0.001f, f * -0.002f, f * 0.003f));
+		scales.PushBack(Vector3(1.0f + f * 0.01f, 2.0f, 0.5f));
+		translations2D.PushBack(Vector2(f, f * 0.5f));
+		scales2D.PushBack(Vector2(1.0f + f * 0.01f, 2.0f));
+		rotations2D[i] = f * 0.003f;
+	}
+	std::vector<Matrix4> out(Count);
+	std::vector<Matrix3> out2D(Count);
+
+	Benchmark::Section("Transform: Matrix4 euler");
+	Benchmark::Run("RotateZ * RotateY * RotateX", Count, [&] {
+		EulerProduct(rotations, out.data());
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("MakeEuler", Count, [&] {
+		EulerClosedForm(rotations, out.data());
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Transform: Matrix4 TRS");
+	Benchmark::Run("Translation * Euler * Scale", Count, [&] {
+		TRSProduct(translations, rotations, scales, out.data());
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("MakeTRS per element", Count, [&] {
+		TRSSingle(translations, rotations, scales, out.data());
+		Benchmark::DoNotOptimize(out[0]);
+	});
+	Benchmark::Run("MakeTRS batched", Count, [&] {
+		TRSBatched(translations, rotations, scales, out.data());
+		Benchmark::DoNotOptimize(out[0]);
+	});
+
+	Benchmark::Section("Transform: Matrix3 2D TRS");
+	Benchmark::Run("Translation * RotateZ * Scale", Count, [&] {
+		TRS2DProduct(translations2D, rotations2D.data(), scales2D, out2D.data());
+		Benchmark::DoNotOptimize(out2D[0]);
+	});
+	Benchmark::Run("MakeTRS batched", Count, [&] {
+		TRS2DBatched(translations2D, rotations2D.data(), scales2D, out2D.data());
+		Benchmark::DoNotOptimize(out2D[0]);
+	});
+
+	std::vector<Matrix3> parents2D(Count), world2D(Count);
+	std::vector<Affine2D> parentsAffine(Count), localsAffine(Count), worldAffine(Count);
+	std::vector<Vector2> points(Count), transformed(Count);
+	TRS2DBatched(translations2D, rotations2D.data(), scales2D, out2D.data());
+	for (size_t i = 0; i < Count; i++) {
+		parents2D[i] = out2D[(i * 31) % Count];
+		parentsAffine[i] = Affine2D(parents2D[i]);
+		localsAffine[i] = Affine2D(out2D[i]);
+		points[i] = translations2D.Get(i);
+	}
+
+	Benchmark::Section("Transform: 2D parent * local");
+	Benchmark::Run("Matrix3 per element", Count, [&] {
+		ComposeMatrix3(parents2D.data(), out2D.data(), world2D.data(), Count);
+		Benchmark::DoNotOptimize(world2D[0]);
+	});
+	Benchmark::Run("Affine2D::Multiply", Count, [&] {
+		ComposeAffine2D(parentsAffine.data(), localsAffine.data(), worldAffine.data(), Count);
+		Benchmark::DoNotOptimize(worldAffine[0]);
+	});
+
+	Benchmark::Section("Transform: 2D points");
+	Benchmark::Run("Matrix3::TransformPoints", Count, [&] {
+		PointsMatrix3(parents2D[1], points.data(), transformed.data(), Count);
+		Benchmark::DoNotOptimize(transformed[0]);
+	});
+	Benchmark::Run("Affine2D::TransformPoints", Count, [&] {
+		PointsAffine2D(parentsAffine[1], points.data(), transformed.data(), Count);
+		Benchmark::DoNotOptimize(transformed[0]);
+	});
+}
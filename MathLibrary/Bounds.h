@@ -0,0 +1,556 @@
+#pragma once
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix4.h"
+#include "Affine2D.h"
+#include "VectorStream.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MathClasses
+{
+	/**
+	 * An axis-aligned bounding box between two corners, in 2D or 3D.
+	 *
+	 * A box is valid when min <= max on every axis; one with min == max
+	 * bounds a single point.
+	 */
+	template<typename V>
+	struct BoundingBox
+	{
+		V min, max;
+
+		/**
+		 * Initializes both corners to zero
+		 */
+		constexpr BoundingBox() = default;
+		constexpr BoundingBox(V inMin, V inMax) : min(inMin), max(inMax) {}
+
+		static constexpr BoundingBox FromCenterExtents(V center, V extents) {
+			return { center - extents, center + extents };
+		}
+
+		/**
+		 * Returns the smallest box holding every point. There must be at
+		 * least one point.
+		 */
+		static constexpr BoundingBox FromPoints(const V* points, size_t count) {
+			assert(count > 0);
+			BoundingBox box(points[0], points[0]);
+			for (size_t i = 1; i < count; i++) {
+				box.Encapsulate(points[i]);
+			}
+			return box;
+		}
+
+		constexpr V Center() const {
+			return (min + max) * 0.5f;
+		}
+
+		/**
+		 * Returns the half-size of the box on each axis.
+		 */
+		constexpr V Extents() const {
+			return (max - min) * 0.5f;
+		}
+
+		constexpr V Size() const {
+			return max - min;
+		}
+
+		/**
+		 * Returns true if the point is inside the box or on its surface.
+		 */
+		constexpr bool Contains(V point) const {
+			return V::All([&](auto i) { return point.Get(i) >= min.Get(i) && point.Get(i) <= max.Get(i); });
+		}
+
+		/**
+		 * Returns true if the boxes overlap or touch.
+		 */
+		constexpr bool Overlaps(const BoundingBox& other) const {
+			return V::All([&](auto i) { return min.Get(i) <= other.max.Get(i) && other.min.Get(i) <= max.Get(i); });
+		}
+
+		/**
+		 * Grows the box to hold the point.
+		 */
+		constexpr void Encapsulate(V point) {
+			min = V::Map([&](auto i) { return std::min(min.Get(i), point.Get(i)); });
+			max = V::Map([&](auto i) { return std::max(max.Get(i), point.Get(i)); });
+		}
+
+		/**
+		 * Returns the smallest box holding both boxes.
+		 */
+		constexpr BoundingBox Merged(const BoundingBox& other) const {
+			return {
+				V::Map([&](auto i) { return std::min(min.Get(i), other.min.Get(i)); }),
+				V::Map([&](auto i) { return std::max(max.Get(i), other.max.Get(i)); })
+			};
+		}
+
+		/**
+		 * Returns the box grown by amount on every side.
+		 */
+		constexpr BoundingBox Expanded(float amount) const {
+			V grow = V::Map([&](auto) { return amount; });
+			return { min - grow, max + grow };
+		}
+
+		/**
+		 * Returns the smallest axis-aligned box holding this box after it is
+		 * transformed (Arvo's method): the centre is transformed as a point
+		 * and the extents by the absolute values of the upper 3x3.
+		 */
+		BoundingBox Transformed(const Matrix4& transform) const requires (V::Dimension == 3) {
+			V center = Center(), extents = Extents();
+			V newCenter(
+				(transform.m1 * center.x) + (transform.m5 * center.y) + (transform.m9 * center.z) + transform.m13,
+				(transform.m2 * center.x) + (transform.m6 * center.y) + (transform.m10 * center.z) + transform.m14,
+				(transform.m3 * center.x) + (transform.m7 * center.y) + (transform.m11 * center.z) + transform.m15);
+			V newExtents(
+				(std::abs(transform.m1) * extents.x) + (std::abs(transform.m5) * extents.y) + (std::abs(transform.m9) * extents.z),
+				(std::abs(transform.m2) * extents.x) + (std::abs(transform.m6) * extents.y) + (std::abs(transform.m10) * extents.z),
+				(std::abs(transform.m3) * extents.x) + (std::abs(transform.m7) * extents.y) + (std::abs(transform.m11) * extents.z));
+			return FromCenterExtents(newCenter, newExtents);
+		}
+
+		/**
+		 * Returns the smallest axis-aligned box holding this box after a 2D
+		 * transform. See Transformed(const Matrix4&).
+		 */
+		BoundingBox Transformed(const Affine2D& transform) const requires (V::Dimension == 2) {
+			V center = Center(), extents = Extents();
+			V newExtents(
+				(std::abs(transform.m1) * extents.x) + (std::abs(transform.m3) * extents.y),
+				(std::abs(transform.m2) * extents.x) + (std::abs(transform.m4) * extents.y));
+			return FromCenterExtents(transform.TransformPoint(center), newExtents);
+		}
+
+		constexpr bool operator == (const BoundingBox& rhs) const {
+			return min == rhs.min && max == rhs.max;
+		}
+
+		constexpr bool operator != (const BoundingBox& rhs) const {
+			return !(*this == rhs);
+		}
+	};
+
+	/**
+	 * A sphere, or in 2D a circle, given by its centre and radius.
+	 */
+	template<typename V>
+	struct BoundingSphere
+	{
+		V center;
+		float radius = 0;
+
+		constexpr BoundingSphere() = default;
+		constexpr BoundingSphere(V inCenter, float inRadius) : center(inCenter), radius(inRadius) {}
+
+		constexpr bool Contains(V point) const {
+			return (point - center).MagnitudeSqr() <= radius * radius;
+		}
+
+		constexpr bool Overlaps(const BoundingSphere& other) const {
+			float reach = radius + other.radius;
+			return (other.center - center).MagnitudeSqr() <= reach * reach;
+		}
+
+		/**
+		 * Returns the box that just holds the sphere.
+		 */
+		constexpr BoundingBox<V> Bounds() const {
+			return BoundingBox<V>::FromCenterExtents(center, V::Map([&](auto) { return radius; }));
+		}
+
+		constexpr bool operator == (const BoundingSphere& rhs) const {
+			return center == rhs.center && radius == rhs.radius;
+		}
+
+		constexpr bool operator != (const BoundingSphere& rhs) const {
+			return !(*this == rhs);
+		}
+	};
+
+	using AABB = BoundingBox<Vector3>;
+	using AABB2 = BoundingBox<Vector2>;
+	using Sphere = BoundingSphere<Vector3>;
+	using Circle = BoundingSphere<Vector2>;
+
+	/**
+	 * A plane holding the points p where normal.Dot(p) + distance == 0.
+	 *
+	 * Points on the side the normal faces have a positive signed distance.
+	 * Distances are only true lengths when the normal is unit length; see
+	 * Normalised().
+	 */
+	struct Plane
+	{
+		Vector3 normal;
+		float distance = 0;
+
+		constexpr Plane() = default;
+		constexpr Plane(Vector3 inNormal, float inDistance) : normal(inNormal), distance(inDistance) {}
+
+		/**
+		 * Creates the plane with the given normal passing through a point.
+		 */
+		static constexpr Plane FromPointNormal(Vector3 point, Vector3 normal) {
+			return { normal, -normal.Dot(point) };
+		}
+
+		/**
+		 * Creates the plane through three points, facing the side from which
+		 * they wind counter-clockwise.
+		 */
+		static Plane FromPoints(Vector3 a, Vector3 b, Vector3 c) {
+			return FromPointNormal(a, (b - a).Cross(c - a).Normalised());
+		}
+
+		/**
+		 * Returns the plane scaled so its normal is unit length. The plane
+		 * itself is unchanged.
+		 */
+		Plane Normalised() const {
+			float inv = 1.0f / normal.Magnitude();
+			return { normal * inv, distance * inv };
+		}
+
+		constexpr float SignedDistance(Vector3 point) const {
+			return ((normal.x * point.x) + (normal.y * point.y)) + (normal.z * point.z) + distance;
+		}
+
+		constexpr bool operator == (const Plane& rhs) const {
+			return normal == rhs.normal && distance == rhs.distance;
+		}
+
+		constexpr bool operator != (const Plane& rhs) const {
+			return !(*this == rhs);
+		}
+	};
+
+	/**
+	 * Box bounds as structure-of-arrays, stored by centre and extents so the
+	 * culling kernels can load four boxes' worth of each without shuffling.
+	 */
+	struct AABBStream
+	{
+		Vector3Stream center, extents;
+
+		AABBStream() {}
+		explicit AABBStream(size_t count) : center(count), extents(count) {}
+
+		size_t Size() const { return center.Size(); }
+		void Resize(size_t count) { center.Resize(count); extents.Resize(count); }
+		void Reserve(size_t count) { center.Reserve(count); extents.Reserve(count); }
+		void Clear() { center.Clear(); extents.Clear(); }
+
+		void PushBack(const AABB& box) { center.PushBack(box.Center()); extents.PushBack(box.Extents()); }
+		AABB Get(size_t i) const { return AABB::FromCenterExtents(center.Get(i), extents.Get(i)); }
+		void Set(size_t i, const AABB& box) { center.Set(i, box.Center()); extents.Set(i, box.Extents()); }
+	};
+
+	/**
+	 * Sphere bounds as structure-of-arrays.
+	 */
+	struct SphereStream
+	{
+		Vector3Stream center;
+		std::vector<float> radius;
+
+		SphereStream() {}
+		explicit SphereStream(size_t count) : center(count), radius(count) {}
+
+		size_t Size() const { return center.Size(); }
+		void Resize(size_t count) { center.Resize(count); radius.resize(count); }
+		void Reserve(size_t count) { center.Reserve(count); radius.reserve(count); }
+		void Clear() { center.Clear(); radius.clear(); }
+
+		void PushBack(const Sphere& sphere) { center.PushBack(sphere.center); radius.push_back(sphere.radius); }
+		Sphere Get(size_t i) const { return { center.Get(i), radius[i] }; }
+		void Set(size_t i, const Sphere& sphere) { center.Set(i, sphere.center); radius[i] = sphere.radius; }
+	};
+
+	/**
+	 * Circle bounds as structure-of-arrays.
+	 */
+	struct CircleStream
+	{
+		Vector2Stream center;
+		std::vector<float> radius;
+
+		CircleStream() {}
+		explicit CircleStream(size_t count) : center(count), radius(count) {}
+
+		size_t Size() const { return center.Size(); }
+		void Resize(size_t count) { center.Resize(count); radius.resize(count); }
+		void Reserve(size_t count) { center.Reserve(count); radius.reserve(count); }
+		void Clear() { center.Clear(); radius.clear(); }
+
+		void PushBack(const Circle& circle) { center.PushBack(circle.center); radius.push_back(circle.radius); }
+		Circle Get(size_t i) const { return { center.Get(i), radius[i] }; }
+		void Set(size_t i, const Circle& circle) { center.Set(i, circle.center); radius[i] = circle.radius; }
+	};
+
+	namespace Detail
+	{
+		/**
+		 * The signed distances of four points from a plane, added in the
+		 * same order as Plane::SignedDistance().
+		 */
+		inline Simd::Float4 PlaneDistance4(const Plane& plane, Simd::Float4 x, Simd::Float4 y, Simd::Float4 z)
+		{
+			Simd::Float4 distance = Simd::Add(Simd::Mul(Simd::Splat(plane.normal.x), x), Simd::Mul(Simd::Splat(plane.normal.y), y));
+			distance = Simd::Add(distance, Simd::Mul(Simd::Splat(plane.normal.z), z));
+			return Simd::Add(distance, Simd::Splat(plane.distance));
+		}
+
+		/**
+		 * Appends first + j to out for each set bit j of a 4-bit mask,
+		 * returning the new count. Every index is written, and the count
+		 * only advances past the visible ones, so there is no branch.
+		 */
+		inline size_t AppendVisible(int mask, uint32_t first, uint32_t* out, size_t count)
+		{
+			out[count] = first;
+			count += mask & 1;
+			out[count] = first + 1;
+			count += (mask >> 1) & 1;
+			out[count] = first + 2;
+			count += (mask >> 2) & 1;
+			out[count] = first + 3;
+			count += (mask >> 3) & 1;
+			return count;
+		}
+	}
+
+	/**
+	 * 2D box bounds as structure-of-arrays, stored by corners since the
+	 * overlap test only compares them.
+	 */
+	struct AABB2Stream
+	{
+		Vector2Stream min, max;
+
+		AABB2Stream() {}
+		explicit AABB2Stream(size_t count) : min(count), max(count) {}
+
+		size_t Size() const { return min.Size(); }
+		void Resize(size_t count) { min.Resize(count); max.Resize(count); }
+		void Reserve(size_t count) { min.Reserve(count); max.Reserve(count); }
+		void Clear() { min.Clear(); max.Clear(); }
+
+		void PushBack(const AABB2& box) { min.PushBack(box.min); max.PushBack(box.max); }
+		AABB2 Get(size_t i) const { return { min.Get(i), max.Get(i) }; }
+		void Set(size_t i, const AABB2& box) { min.Set(i, box.min); max.Set(i, box.max); }
+
+		/**
+		 * Writes the index of every box that overlaps the view, such as a
+		 * camera's visible rectangle, in ascending order, and returns how
+		 * many there are. Each box gets the same answer as AABB2::Overlaps.
+		 *
+		 * Four boxes are compared per iteration and their indices appended
+		 * without branching, as in Frustum::CullBoxes().
+		 *
+		 * @param view The rectangle to test against.
+		 * @param out Destination for the overlapping indices, holding at least Size() entries.
+		 * @return The number of indices written.
+		 */
+		size_t Overlapping(const AABB2& view, uint32_t* out) const {
+			const Simd::Float4 viewMinX = Simd::Splat(view.min.x), viewMinY = Simd::Splat(view.min.y);
+			const Simd::Float4 viewMaxX = Simd::Splat(view.max.x), viewMaxY = Simd::Splat(view.max.y);
+			const size_t count = Size();
+
+			size_t written = 0, i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 x = Simd::And(
+					Simd::CmpLe(Simd::LoadUnaligned(min.x.data() + i), viewMaxX),
+					Simd::CmpGe(Simd::LoadUnaligned(max.x.data() + i), viewMinX));
+				Simd::Float4 y = Simd::And(
+					Simd::CmpLe(Simd::LoadUnaligned(min.y.data() + i), viewMaxY),
+					Simd::CmpGe(Simd::LoadUnaligned(max.y.data() + i), viewMinY));
+				written = Detail::AppendVisible(Simd::MoveMask(Simd::And(x, y)), (uint32_t)i, out, written);
+			}
+			for (; i < count; i++) {
+				out[written] = (uint32_t)i;
+				written += Get(i).Overlaps(view) ? 1 : 0;
+			}
+			return written;
+		}
+	};
+
+	/**
+	 * The six planes bounding a view volume, with normals facing inward.
+	 *
+	 * The tests are conservative: a box or sphere that misses the volume
+	 * but straddles two planes near a corner is reported visible, which
+	 * only costs drawing something off screen.
+	 */
+	struct Frustum
+	{
+		enum Side { Left, Right, Bottom, Top, Near, Far };
+
+		std::array<Plane, 6> planes;
+
+		/**
+		 * Extracts the planes of a view-projection matrix (Gribb and
+		 * Hartmann), which must map to clip space with depth from -w to w
+		 * like Matrix4::MakePerspective. Each plane is a sum or difference
+		 * of the matrix's rows, so a point p is inside when
+		 * -w <= x, y, z <= w for the clip-space (x, y, z, w) = M * p.
+		 *
+		 * @param viewProjection The projection multiplied by the view matrix.
+		 * @return The frustum, with unit-length plane normals.
+		 */
+		static Frustum FromMatrix(const Matrix4& viewProjection) {
+			Matrix4 rows = viewProjection.Transposed();
+			const Vector4 combined[6] = {
+				rows.axis[3] + rows.axis[0], rows.axis[3] - rows.axis[0],
+				rows.axis[3] + rows.axis[1], rows.axis[3] - rows.axis[1],
+				rows.axis[3] + rows.axis[2], rows.axis[3] - rows.axis[2]
+			};
+
+			Frustum frustum;
+			for (size_t p = 0; p < 6; p++) {
+				frustum.planes[p] = Plane(Vector3(combined[p].x, combined[p].y, combined[p].z), combined[p].w).Normalised();
+			}
+			return frustum;
+		}
+
+		constexpr bool Contains(Vector3 point) const {
+			for (const Plane& plane : planes) {
+				if (plane.SignedDistance(point) < 0) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Returns false if the sphere lies wholly behind any plane.
+		 */
+		constexpr bool Intersects(const Sphere& sphere) const {
+			for (const Plane& plane : planes) {
+				if (plane.SignedDistance(sphere.center) + sphere.radius < 0) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Returns false if the box lies wholly behind any plane, found by
+		 * testing the corner furthest along that plane's normal: the centre's
+		 * distance plus the extents projected onto the absolute normal.
+		 */
+		bool Intersects(const AABB& box) const {
+			return IntersectsBox(box.Center(), box.Extents());
+		}
+
+		/**
+		 * The box test of Intersects(const AABB&), taking the box by its
+		 * centre and extents as AABBStream stores it.
+		 */
+		bool IntersectsBox(Vector3 center, Vector3 extents) const {
+			for (const Plane& plane : planes) {
+				float reach = ((std::abs(plane.normal.x) * extents.x) + (std::abs(plane.normal.y) * extents.y)) + (std::abs(plane.normal.z) * extents.z);
+				if (plane.SignedDistance(center) + reach < 0) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Writes the index of every sphere that intersects the frustum, in
+		 * ascending order, and returns how many there are. Each sphere gets
+		 * the same answer as Intersects(const Sphere&).
+		 *
+		 * Four spheres are tested against all six planes per iteration, and
+		 * their visible indices are appended without branching by always
+		 * writing each index and advancing the count only past visible ones.
+		 *
+		 * @param spheres The bounds to test.
+		 * @param visible Destination for the visible indices, holding at least spheres.Size() entries.
+		 * @return The number of indices written.
+		 */
+		size_t CullSpheres(const SphereStream& spheres, uint32_t* visible) const {
+			const float* cx = spheres.center.x.data();
+			const float* cy = spheres.center.y.data();
+			const float* cz = spheres.center.z.data();
+			const float* r = spheres.radius.data();
+			const size_t count = spheres.Size();
+			const Simd::Float4 zero = Simd::Zero();
+
+			size_t written = 0, i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 x = Simd::LoadUnaligned(cx + i);
+				Simd::Float4 y = Simd::LoadUnaligned(cy + i);
+				Simd::Float4 z = Simd::LoadUnaligned(cz + i);
+				Simd::Float4 radius = Simd::LoadUnaligned(r + i);
+
+				Simd::Float4 inside = Simd::CmpEq(zero, zero);
+				for (const Plane& plane : planes) {
+					Simd::Float4 reach = Simd::Add(Detail::PlaneDistance4(plane, x, y, z), radius);
+					inside = Simd::And(inside, Simd::CmpGe(reach, zero));
+				}
+				written = Detail::AppendVisible(Simd::MoveMask(inside), (uint32_t)i, visible, written);
+			}
+			for (; i < count; i++) {
+				visible[written] = (uint32_t)i;
+				written += Intersects(spheres.Get(i)) ? 1 : 0;
+			}
+			return written;
+		}
+
+		/**
+		 * Writes the index of every box that intersects the frustum, in
+		 * ascending order, and returns how many there are. Each box gets the
+		 * same answer as Intersects(const AABB&). See CullSpheres().
+		 *
+		 * @param boxes The bounds to test.
+		 * @param visible Destination for the visible indices, holding at least boxes.Size() entries.
+		 * @return The number of indices written.
+		 */
+		size_t CullBoxes(const AABBStream& boxes, uint32_t* visible) const {
+			const float* cx = boxes.center.x.data();
+			const float* cy = boxes.center.y.data();
+			const float* cz = boxes.center.z.data();
+			const float* ex = boxes.extents.x.data();
+			const float* ey = boxes.extents.y.data();
+			const float* ez = boxes.extents.z.data();
+			const size_t count = boxes.Size();
+			const Simd::Float4 zero = Simd::Zero();
+
+			size_t written = 0, i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 x = Simd::LoadUnaligned(cx + i);
+				Simd::Float4 y = Simd::LoadUnaligned(cy + i);
+				Simd::Float4 z = Simd::LoadUnaligned(cz + i);
+				Simd::Float4 extentX = Simd::LoadUnaligned(ex + i);
+				Simd::Float4 extentY = Simd::LoadUnaligned(ey + i);
+				Simd::Float4 extentZ = Simd::LoadUnaligned(ez + i);
+
+				Simd::Float4 inside = Simd::CmpEq(zero, zero);
+				for (const Plane& plane : planes) {
+					Simd::Float4 reach = Simd::Add(Simd::Add(
+						Simd::Mul(Simd::Splat(std::abs(plane.normal.x)), extentX),
+						Simd::Mul(Simd::Splat(std::abs(plane.normal.y)), extentY)),
+						Simd::Mul(Simd::Splat(std::abs(plane.normal.z)), extentZ));
+					reach = Simd::Add(Detail::PlaneDistance4(plane, x, y, z), reach);
+					inside = Simd::And(inside, Simd::CmpGe(reach, zero));
+				}
+				written = Detail::AppendVisible(Simd::MoveMask(inside), (uint32_t)i, visible, written);
+			}
+			for (; i < count; i++) {
+				visible[written] = (uint32_t)i;
+				written += IntersectsBox(boxes.center.Get(i), boxes.extents.Get(i)) ? 1 : 0;
+			}
+			return written;
+		}
+	};
+}
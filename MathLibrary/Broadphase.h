@@ -0,0 +1,542 @@
+#pragma once
+#include "Bounds.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace MathClasses
+{
+	/**
+	 * Two object indices found close enough to need a narrow-phase test,
+	 * with a less than b.
+	 */
+	struct IndexPair
+	{
+		uint32_t a, b;
+
+		constexpr bool operator ==(const IndexPair& rhs) const { return a == rhs.a && b == rhs.b; }
+		constexpr bool operator !=(const IndexPair& rhs) const { return !(*this == rhs); }
+		constexpr bool operator <(const IndexPair& rhs) const { return a < rhs.a || (a == rhs.a && b < rhs.b); }
+	};
+
+	/**
+	 * A broadphase over points, rebuilt from scratch every tick.
+	 *
+	 * Space is divided into square cells, and each cell is hashed into a
+	 * fixed number of buckets so the world needs no bounds. Build() groups
+	 * the objects by bucket with a counting sort, leaving one flat array of
+	 * positions in bucket order and an offset table into it; a query then
+	 * only reads the buckets of the cells it covers.
+	 *
+	 * Distinct cells can share a bucket, which costs some extra distance
+	 * tests but never a missed or repeated result. Every array is reused
+	 * between builds, so once the object count stops growing, building and
+	 * querying do not allocate.
+	 */
+	class SpatialHashGrid
+	{
+	public:
+		/**
+		 * @param cellSize The width of a cell, at least the largest distance that will be queried.
+		 * @param bucketCount The number of hash buckets, rounded up to a power of two.
+		 */
+		explicit SpatialHashGrid(float cellSize, size_t bucketCount = 4096)
+			: cellSize(cellSize), inverseCellSize(1.0f / cellSize) {
+			assert(cellSize > 0);
+			size_t buckets = 1;
+			while (buckets < bucketCount) { buckets <<= 1; }
+			bucketMask = (uint32_t)(buckets - 1);
+			bucketStart.resize(buckets + 1);
+		}
+
+		float CellSize() const { return cellSize; }
+		size_t BucketCount() const { return (size_t)bucketMask + 1; }
+		size_t Size() const { return index.size(); }
+
+		/**
+		 * Replaces the contents of the grid with the given positions, which
+		 * are referred to by their index in the array from then on.
+		 */
+		void Build(const Vector2* positions, size_t count) {
+			Resize(count);
+			for (size_t i = 0; i < count; i++) {
+				bucketOf[i] = BucketAt(positions[i].x, positions[i].y);
+			}
+			SortByBucket([&](size_t i) { return positions[i]; }, count);
+		}
+
+		void Build(const Vector2Stream& positions) {
+			const size_t count = positions.Size();
+			Resize(count);
+			const float* inX = positions.x.data();
+			const float* inY = positions.y.data();
+			for (size_t i = 0; i < count; i++) {
+				bucketOf[i] = BucketAt(inX[i], inY[i]);
+			}
+			SortByBucket([&](size_t i) { return Vector2(inX[i], inY[i]); }, count);
+		}
+
+		/**
+		 * Finds every object within a distance of a point.
+		 *
+		 * @param point The centre of the search.
+		 * @param radius The search distance, no greater than the cell size.
+		 * @param out Replaced with the indices found, in no particular order.
+		 * @return The number of indices found.
+		 */
+		size_t Query(const Vector2& point, float radius, std::vector<uint32_t>& out) const {
+			assert(radius <= cellSize);
+			out.clear();
+
+			uint32_t buckets[9];
+			size_t bucketCount = BucketsCovering(CellOf(point.x - radius), CellOf(point.x + radius),
+												 CellOf(point.y - radius), CellOf(point.y + radius), buckets);
+
+			const float radiusSqr = radius * radius;
+			for (size_t k = 0; k < bucketCount; k++) {
+				for (uint32_t s = bucketStart[buckets[k]]; s < bucketStart[buckets[k] + 1]; s++) {
+					float dx = sortedX[s] - point.x;
+					float dy = sortedY[s] - point.y;
+					if (dx * dx + dy * dy <= radiusSqr) { out.push_back(index[s]); }
+				}
+			}
+			return out.size();
+		}
+
+		/**
+		 * Finds every pair of objects within a distance of each other.
+		 *
+		 * Each object is compared against the later objects of its own cell
+		 * and every object of four of its eight neighbouring cells, the
+		 * half of the neighbourhood ahead of it, so each pair of cells is
+		 * visited once and each pair of objects is reported exactly once.
+		 *
+		 * @param distance The pair distance, no greater than the cell size.
+		 * @param out Replaced with the pairs found, each with a less than b, in no particular order.
+		 * @return The number of pairs found.
+		 */
+		size_t FindPairs(float distance, std::vector<IndexPair>& out) const {
+			assert(distance <= cellSize);
+			out.clear();
+
+			static constexpr int32_t Ahead[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+			const float distanceSqr = distance * distance;
+			const size_t count = index.size();
+
+			// neighbouring slots of the sorted arrays usually share a cell, so
+			// the buckets around it are only looked up when the cell changes
+			uint64_t cell = 0;
+			uint32_t ownEnd = 0;
+			uint64_t aheadCell[4];
+			uint32_t aheadBegin[4], aheadEnd[4];
+
+			for (size_t s = 0; s < count; s++) {
+				if (s == 0 || cellKey[s] != cell) {
+					cell = cellKey[s];
+					int32_t cellX = (int32_t)(cell >> 32);
+					int32_t cellY = (int32_t)(uint32_t)cell;
+					ownEnd = bucketStart[BucketOfCell(cellX, cellY) + 1];
+					for (size_t k = 0; k < 4; k++) {
+						aheadCell[k] = CellKey(cellX + Ahead[k][0], cellY + Ahead[k][1]);
+						uint32_t bucket = BucketOfCell(cellX + Ahead[k][0], cellY + Ahead[k][1]);
+						aheadBegin[k] = bucketStart[bucket];
+						aheadEnd[k] = bucketStart[bucket + 1];
+					}
+				}
+
+				const uint32_t self = index[s];
+				const float x = sortedX[s];
+				const float y = sortedY[s];
+
+				// a bucket can hold several cells, so each candidate's cell is checked as well as its distance
+				auto test = [&](uint32_t t, uint64_t expectedCell) {
+					float dx = sortedX[t] - x;
+					float dy = sortedY[t] - y;
+					if ((cellKey[t] == expectedCell) & (dx * dx + dy * dy <= distanceSqr)) {
+						out.push_back({ std::min(self, index[t]), std::max(self, index[t]) });
+					}
+				};
+				for (uint32_t t = (uint32_t)s + 1; t < ownEnd; t++) { test(t, cell); }
+				for (size_t k = 0; k < 4; k++) {
+					for (uint32_t t = aheadBegin[k]; t < aheadEnd[k]; t++) { test(t, aheadCell[k]); }
+				}
+			}
+			return out.size();
+		}
+
+	private:
+		float cellSize;
+		float inverseCellSize;
+		uint32_t bucketMask;
+
+		// bucketStart[b] to bucketStart[b + 1] is the range of bucket b in the sorted arrays
+		std::vector<uint32_t> bucketStart;
+		std::vector<uint32_t> bucketOf;
+		std::vector<uint32_t> index;
+		std::vector<uint64_t> cellKey;
+		std::vector<float> sortedX, sortedY;
+
+		void Resize(size_t count) {
+			bucketOf.resize(count);
+			index.resize(count);
+			cellKey.resize(count);
+			sortedX.resize(count);
+			sortedY.resize(count);
+		}
+
+		int32_t CellOf(float coordinate) const {
+			// truncation rounds towards zero, so step negative fractions down one
+			float scaled = coordinate * inverseCellSize;
+			int32_t truncated = (int32_t)scaled;
+			return truncated - (int32_t)(scaled < (float)truncated);
+		}
+
+		uint32_t BucketOfCell(int32_t cellX, int32_t cellY) const {
+			// the prime multipliers from Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+			return (((uint32_t)cellX * 73856093u) ^ ((uint32_t)cellY * 19349663u)) & bucketMask;
+		}
+
+		uint32_t BucketAt(float x, float y) const {
+			return BucketOfCell(CellOf(x), CellOf(y));
+		}
+
+		static uint64_t CellKey(int32_t cellX, int32_t cellY) {
+			return ((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellY;
+		}
+
+		/*
+		 * Collects the distinct buckets of a block of at most 3 x 3 cells, so
+		 * that cells sharing a bucket are only read once.
+		 */
+		size_t BucketsCovering(int32_t minX, int32_t maxX, int32_t minY, int32_t maxY, uint32_t (&out)[9]) const {
+			size_t count = 0;
+			for (int32_t cellY = minY; cellY <= maxY; cellY++) {
+				for (int32_t cellX = minX; cellX <= maxX; cellX++) {
+					uint32_t bucket = BucketOfCell(cellX, cellY);
+					bool seen = false;
+					for (size_t k = 0; k < count; k++) { seen |= out[k] == bucket; }
+					if (!seen) { out[count++] = bucket; }
+				}
+			}
+			return count;
+		}
+
+		template<typename PositionAt>
+		void SortByBucket(PositionAt positionAt, size_t count) {
+			// count the objects in each bucket, then turn the counts into start offsets
+			std::fill(bucketStart.begin(), bucketStart.end(), 0u);
+			for (size_t i = 0; i < count; i++) {
+				bucketStart[bucketOf[i]]++;
+			}
+			uint32_t sum = 0;
+			for (uint32_t& start : bucketStart) {
+				uint32_t bucketSize = start;
+				start = sum;
+				sum += bucketSize;
+			}
+
+			// scattering advances each start to the end of its bucket, which is the next bucket's start
+			for (size_t i = 0; i < count; i++) {
+				uint32_t s = bucketStart[bucketOf[i]]++;
+				Vector2 position = positionAt(i);
+				index[s] = (uint32_t)i;
+				cellKey[s] = CellKey(CellOf(position.x), CellOf(position.y));
+				sortedX[s] = position.x;
+				sortedY[s] = position.y;
+			}
+			for (size_t b = bucketStart.size() - 1; b > 0; b--) {
+				bucketStart[b] = bucketStart[b - 1];
+			}
+			bucketStart[0] = 0;
+		}
+	};
+
+	/**
+	 * A broadphase over boxes that is kept up to date from frame to frame
+	 * instead of rebuilt, for scenes where most objects move a little each
+	 * frame.
+	 *
+	 * The box ends along each axis are kept in one sorted list per axis.
+	 * Update() re-sorts the lists with an insertion sort, which is close to
+	 * linear when little has moved. A pair of boxes can only start or stop
+	 * overlapping where one box's min passes the other's max, so only the
+	 * pairs those swaps touch are tested, and the set of overlapping pairs
+	 * is changed to match. Unlike a grid, the cost does not depend on how
+	 * much the boxes differ in size.
+	 *
+	 * Handles from Add() stay valid until Remove(), and a removed handle may
+	 * be given out again after the next Update().
+	 */
+	template<typename V>
+	class SweepAndPrune
+	{
+	public:
+		using Box = BoundingBox<V>;
+		static constexpr size_t Axes = V::Dimension;
+
+		/**
+		 * Adds a box, which takes part in pairs from the next Update(). The
+		 * box's min must not exceed its max on any axis, and neither may be NaN.
+		 *
+		 * @return The handle of the new object.
+		 */
+		uint32_t Add(const Box& box) {
+			assert(IsOrdered(box));
+			uint32_t handle;
+			if (freeHandles.empty()) {
+				handle = (uint32_t)boxes.size();
+				boxes.push_back(box);
+				alive.push_back(true);
+			} else {
+				handle = freeHandles.back();
+				freeHandles.pop_back();
+				boxes[handle] = box;
+				alive[handle] = true;
+			}
+
+			// new ends start after every other, so sorting them in passes every max they overlap
+			for (std::vector<Endpoint>& list : endpoints) {
+				list.push_back({ 0, handle << 1 });
+				list.push_back({ 0, (handle << 1) | 1 });
+			}
+			addedSinceUpdate++;
+			liveCount++;
+			return handle;
+		}
+
+		/**
+		 * Removes an object. Its pairs are reported as removed by the next Update().
+		 */
+		void Remove(uint32_t handle) {
+			assert(alive[handle]);
+			alive[handle] = false;
+			removedHandles.push_back(handle);
+			liveCount--;
+		}
+
+		/**
+		 * Moves an object. Its pairs are brought up to date by the next Update().
+		 * The box must be ordered as for Add().
+		 */
+		void SetBounds(uint32_t handle, const Box& box) {
+			assert(alive[handle]);
+			assert(IsOrdered(box));
+			boxes[handle] = box;
+		}
+
+		const Box& Bounds(uint32_t handle) const { return boxes[handle]; }
+		size_t Size() const { return liveCount; }
+
+		/**
+		 * Brings the set of overlapping pairs up to date with every Add(),
+		 * Remove() and SetBounds() since the last call.
+		 *
+		 * When many objects were added at once, the lists are sorted and
+		 * swept from scratch instead, since sorting each new end in one at
+		 * a time would be quadratic.
+		 */
+		void Update() {
+			added.clear();
+			removed.clear();
+
+			if (!removedHandles.empty()) {
+				DropRemoved();
+			}
+
+			for (size_t axis = 0; axis < Axes; axis++) {
+				for (Endpoint& end : endpoints[axis]) {
+					const Box& box = boxes[end.Handle()];
+					end.value = end.IsMax() ? box.max[(int)axis] : box.min[(int)axis];
+				}
+			}
+
+			if (addedSinceUpdate * 4 > liveCount) {
+				Rebuild();
+			} else {
+				for (std::vector<Endpoint>& list : endpoints) {
+					InsertionSort(list);
+				}
+			}
+			addedSinceUpdate = 0;
+		}
+
+		/**
+		 * The pairs of objects whose boxes overlap, each with a less than b,
+		 * in no particular order.
+		 */
+		const std::vector<IndexPair>& Pairs() const { return pairs; }
+
+		/**
+		 * The pairs that started overlapping during the last Update().
+		 */
+		const std::vector<IndexPair>& Added() const { return added; }
+
+		/**
+		 * The pairs that stopped overlapping during the last Update(),
+		 * including those of removed objects.
+		 */
+		const std::vector<IndexPair>& Removed() const { return removed; }
+
+	private:
+		struct Endpoint
+		{
+			float value;
+			// the object's handle shifted up one, with the low bit set for a max
+			uint32_t data;
+
+			uint32_t Handle() const { return data >> 1; }
+			bool IsMax() const { return (data & 1) != 0; }
+
+			// a min sorts before a max of the same value, so touching boxes overlap as they do in BoundingBox::Overlaps
+			bool operator <(const Endpoint& rhs) const {
+				return value < rhs.value || (value == rhs.value && (data & 1) < (rhs.data & 1));
+			}
+		};
+
+		std::vector<Box> boxes;
+		std::vector<bool> alive;
+		std::vector<uint32_t> freeHandles;
+		std::vector<uint32_t> removedHandles;
+		size_t liveCount = 0;
+		size_t addedSinceUpdate = 0;
+
+		std::array<std::vector<Endpoint>, Axes> endpoints;
+
+		// pairSlot maps a pair's key to its place in pairs, so either end can remove it
+		std::vector<IndexPair> pairs;
+		std::unordered_map<uint64_t, uint32_t> pairSlot;
+		std::vector<IndexPair> added, removed;
+
+		// false for a NaN bound too, as every comparison with NaN is false
+		static bool IsOrdered(const Box& box) {
+			for (int axis = 0; axis < (int)Axes; axis++) {
+				if (!(box.min[axis] <= box.max[axis])) { return false; }
+			}
+			return true;
+		}
+
+		static uint64_t PairKey(uint32_t a, uint32_t b) {
+			return ((uint64_t)a << 32) | b;
+		}
+
+		void AddPair(uint32_t a, uint32_t b) {
+			if (a > b) { std::swap(a, b); }
+			if (pairSlot.try_emplace(PairKey(a, b), (uint32_t)pairs.size()).second) {
+				pairs.push_back({ a, b });
+				added.push_back({ a, b });
+			}
+		}
+
+		void RemovePair(uint32_t a, uint32_t b) {
+			if (a > b) { std::swap(a, b); }
+			auto found = pairSlot.find(PairKey(a, b));
+			if (found == pairSlot.end()) { return; }
+			RemovePairAt(found->second);
+		}
+
+		void RemovePairAt(uint32_t slot) {
+			IndexPair pair = pairs[slot];
+			pairSlot.erase(PairKey(pair.a, pair.b));
+			if (slot + 1 < pairs.size()) {
+				pairs[slot] = pairs.back();
+				pairSlot[PairKey(pairs[slot].a, pairs[slot].b)] = slot;
+			}
+			pairs.pop_back();
+			removed.push_back(pair);
+		}
+
+		void DropRemoved() {
+			for (uint32_t slot = 0; slot < pairs.size();) {
+				if (!alive[pairs[slot].a] || !alive[pairs[slot].b]) {
+					RemovePairAt(slot);
+				} else {
+					slot++;
+				}
+			}
+			for (std::vector<Endpoint>& list : endpoints) {
+				list.erase(std::remove_if(list.begin(), list.end(), [&](const Endpoint& end) { return !alive[end.Handle()]; }), list.end());
+			}
+			for (uint32_t handle : removedHandles) {
+				freeHandles.push_back(handle);
+			}
+			removedHandles.clear();
+		}
+
+		/*
+		 * Moves each end left to its place. Every swap is of two ends that
+		 * have changed order since the last sort, so a min passing a max
+		 * means the two boxes may now overlap, and a max passing a min means
+		 * they no longer do.
+		 */
+		void InsertionSort(std::vector<Endpoint>& list) {
+			for (size_t i = 1; i < list.size(); i++) {
+				const Endpoint end = list[i];
+				size_t j = i;
+				while (j > 0 && end < list[j - 1]) {
+					const Endpoint& passed = list[j - 1];
+					if (end.IsMax() != passed.IsMax()) {
+						if (!end.IsMax()) {
+							if (boxes[end.Handle()].Overlaps(boxes[passed.Handle()])) { AddPair(end.Handle(), passed.Handle()); }
+						} else {
+							RemovePair(end.Handle(), passed.Handle());
+						}
+					}
+					list[j] = passed;
+					j--;
+				}
+				list[j] = end;
+			}
+		}
+
+		/*
+		 * Sorts every list from scratch, then sweeps the first axis with a
+		 * list of the boxes currently open to find every overlapping pair.
+		 */
+		void Rebuild() {
+			for (std::vector<Endpoint>& list : endpoints) {
+				std::sort(list.begin(), list.end());
+			}
+
+			for (uint32_t slot = 0; slot < pairs.size();) {
+				if (!boxes[pairs[slot].a].Overlaps(boxes[pairs[slot].b])) {
+					RemovePairAt(slot);
+				} else {
+					slot++;
+				}
+			}
+
+			std::vector<uint32_t> open;
+			for (const Endpoint& end : endpoints[0]) {
+				const uint32_t handle = end.Handle();
+				if (end.IsMax()) {
+					// only missing if the box's max sorted before its min, which Add() and SetBounds() assert against
+					auto found = std::find(open.begin(), open.end(), handle);
+					assert(found != open.end());
+					if (found != open.end()) {
+						*found = open.back();
+						open.pop_back();
+					}
+				} else {
+					for (uint32_t other : open) {
+						if (boxes[handle].Overlaps(boxes[other])) { AddPair(handle, other); }
+					}
+					open.push_back(handle);
+				}
+			}
+		}
+	};
+
+	using SweepAndPrune2 = SweepAndPrune<Vector2>;
+	using SweepAndPrune3 = SweepAndPrune<Vector3>;
+}
@@ -0,0 +1,814 @@
+#pragma once
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Bounds.h"
+#include "VectorStream.h"
+#include "Precision.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace MathClasses
+{
+	/**
+	 * A line segment between two points, in 2D or 3D.
+	 */
+	template<typename V>
+	struct LineSegment
+	{
+		V a, b;
+
+		constexpr LineSegment() = default;
+		constexpr LineSegment(V inA, V inB) : a(inA), b(inB) {}
+
+		/**
+		 * Returns the point a fraction t of the way from a to b.
+		 */
+		constexpr V At(float t) const {
+			return a + (b - a) * t;
+		}
+	};
+
+	/**
+	 * The points within radius of a line segment: a circle or sphere swept
+	 * from a to b.
+	 */
+	template<typename V>
+	struct CapsuleShape
+	{
+		V a, b;
+		float radius = 0;
+
+		constexpr CapsuleShape() = default;
+		constexpr CapsuleShape(V inA, V inB, float inRadius) : a(inA), b(inB), radius(inRadius) {}
+
+		constexpr BoundingBox<V> Bounds() const {
+			return BoundingBox<V>(a, a).Merged(BoundingBox<V>(b, b)).Expanded(radius);
+		}
+	};
+
+	using Segment2 = LineSegment<Vector2>;
+	using Segment3 = LineSegment<Vector3>;
+	using Capsule2 = CapsuleShape<Vector2>;
+	using Capsule3 = CapsuleShape<Vector3>;
+
+	/**
+	 * A 2D box rotated about its centre, given by its half-size along its
+	 * own X axis and the unit direction of that axis. Its Y axis is the X
+	 * axis turned a quarter turn counter-clockwise.
+	 */
+	struct OBB2
+	{
+		Vector2 center;
+		Vector2 extents;
+		Vector2 axisX = { 1.0f, 0 };
+
+		constexpr OBB2() = default;
+		constexpr OBB2(Vector2 inCenter, Vector2 inExtents, Vector2 inAxisX = { 1.0f, 0 })
+			: center(inCenter), extents(inExtents), axisX(inAxisX) {}
+
+		/**
+		 * Takes an axis-aligned box as an unrotated one.
+		 */
+		explicit constexpr OBB2(const AABB2& box) : OBB2(box.Center(), box.Extents()) {}
+
+		/**
+		 * Creates a box rotated counter-clockwise by an angle in radians.
+		 */
+		template<Precision P = DefaultPrecision>
+		static OBB2 FromRotation(Vector2 center, Vector2 extents, float rotation) {
+			float s, c;
+			SinCos<P>(rotation, s, c);
+			return { center, extents, { c, s } };
+		}
+
+		constexpr Vector2 AxisY() const {
+			return axisX.Perp();
+		}
+
+		/**
+		 * Converts a world point to the box's frame, where the box spans
+		 * -extents to extents.
+		 */
+		constexpr Vector2 ToLocal(Vector2 point) const {
+			Vector2 offset = point - center;
+			return { offset.Dot(axisX), offset.Dot(AxisY()) };
+		}
+
+		constexpr Vector2 ToWorld(Vector2 local) const {
+			return center + ToWorldVector(local);
+		}
+
+		constexpr Vector2 ToWorldVector(Vector2 local) const {
+			return axisX * local.x + AxisY() * local.y;
+		}
+
+		/**
+		 * Returns the half-length of the box's shadow on a unit axis.
+		 */
+		float ProjectedRadius(Vector2 axis) const {
+			return (extents.x * std::abs(axisX.Dot(axis))) + (extents.y * std::abs(AxisY().Dot(axis)));
+		}
+
+		/**
+		 * Returns the corner furthest along a direction.
+		 */
+		constexpr Vector2 Support(Vector2 direction) const {
+			float x = direction.Dot(axisX) >= 0 ? extents.x : -extents.x;
+			float y = direction.Dot(AxisY()) >= 0 ? extents.y : -extents.y;
+			return ToWorld({ x, y });
+		}
+
+		/**
+		 * Writes the corners in counter-clockwise order.
+		 */
+		constexpr void Corners(Vector2 out[4]) const {
+			out[0] = ToWorld({ -extents.x, -extents.y });
+			out[1] = ToWorld({ extents.x, -extents.y });
+			out[2] = ToWorld({ extents.x, extents.y });
+			out[3] = ToWorld({ -extents.x, extents.y });
+		}
+
+		AABB2 Bounds() const {
+			Vector2 reach(ProjectedRadius({ 1.0f, 0 }), ProjectedRadius({ 0, 1.0f }));
+			return AABB2::FromCenterExtents(center, reach);
+		}
+
+		bool Contains(Vector2 point) const {
+			Vector2 local = ToLocal(point);
+			return std::abs(local.x) <= extents.x && std::abs(local.y) <= extents.y;
+		}
+	};
+
+	/**
+	 * How two overlapping shapes a and b touch.
+	 *
+	 * The normal is unit length and points from a towards b, and moving b
+	 * by normal * depth (or a by the opposite) just separates them. The
+	 * point lies in the overlapping region.
+	 */
+	template<typename V>
+	struct Contact
+	{
+		V normal;
+		float depth = 0;
+		V point;
+
+		/**
+		 * Returns the same contact seen from b.
+		 */
+		constexpr Contact Flipped() const {
+			return { normal * -1.0f, depth, point };
+		}
+	};
+
+	using Contact2 = Contact<Vector2>;
+	using Contact3 = Contact<Vector3>;
+
+	/*
+	 * Overlap and penetration tests between circles and spheres, boxes,
+	 * capsules, segments and, in 2D, rotated boxes.
+	 *
+	 * Overlaps() answers whether two shapes touch. Intersect() also fills
+	 * a Contact and returns false, leaving the contact unchanged, for
+	 * exactly the shapes Overlaps() rejects. Shapes that only touch count
+	 * as overlapping, with a depth of zero. Cast() finds where a segment
+	 * first enters a shape.
+	 *
+	 * The batch forms test one 2D query shape against a whole stream of
+	 * candidates, four per iteration. They give each candidate exactly the
+	 * answer Overlaps() would, and write it either as a hit mask, one bit
+	 * per candidate, or as the indices and contacts of the hits.
+	 */
+	namespace Collision
+	{
+		/**
+		 * Returns the point on segment ab closest to p.
+		 */
+		template<typename V>
+		constexpr V ClosestPointOnSegment(V a, V b, V p) {
+			V ab = b - a;
+			float lengthSq = ab.MagnitudeSqr();
+			float t = lengthSq > 0 ? std::min(std::max((p - a).Dot(ab) / lengthSq, 0.0f), 1.0f) : 0.0f;
+			return a + ab * t;
+		}
+
+		/**
+		 * Finds the closest pair of points between segments p1q1 and p2q2
+		 * (Ericson, "Real-Time Collision Detection", 5.1.9).
+		 */
+		template<typename V>
+		constexpr void ClosestPointsOnSegments(V p1, V q1, V p2, V q2, V& outC1, V& outC2) {
+			V d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+			float a = d1.MagnitudeSqr(), e = d2.MagnitudeSqr(), f = d2.Dot(r);
+			float s = 0, t = 0;
+
+			if (a == 0 && e == 0) {
+				outC1 = p1;
+				outC2 = p2;
+				return;
+			}
+			if (a == 0) {
+				t = std::clamp(f / e, 0.0f, 1.0f);
+			}
+			else {
+				float c = d1.Dot(r);
+				if (e == 0) {
+					s = std::clamp(-c / a, 0.0f, 1.0f);
+				}
+				else {
+					float b = d1.Dot(d2);
+					float denom = (a * e) - (b * b);
+					s = denom != 0 ? std::clamp(((b * f) - (c * e)) / denom, 0.0f, 1.0f) : 0.0f;
+					t = ((b * s) + f) / e;
+					if (t < 0) {
+						t = 0;
+						s = std::clamp(-c / a, 0.0f, 1.0f);
+					}
+					else if (t > 1) {
+						t = 1;
+						s = std::clamp((b - c) / a, 0.0f, 1.0f);
+					}
+				}
+			}
+			outC1 = p1 + d1 * s;
+			outC2 = p2 + d2 * t;
+		}
+
+		namespace Detail
+		{
+			template<typename V>
+			constexpr V UnitX() {
+				return V::Map([](auto i) { return i == 0 ? 1.0f : 0.0f; });
+			}
+
+			template<typename V>
+			constexpr V UnitAxis(size_t axis, float sign) {
+				return V::Map([&](auto i) { return i == axis ? sign : 0.0f; });
+			}
+
+			template<typename V>
+			constexpr V Clamp(V point, const BoundingBox<V>& box) {
+				return V::Map([&](auto i) { return std::min(std::max(point.Get(i), box.min.Get(i)), box.max.Get(i)); });
+			}
+
+			/**
+			 * The contact between spheres at two points, once they are
+			 * known to overlap.
+			 */
+			template<typename V>
+			inline Contact<V> SphereContact(V centerA, float radiusA, V centerB, float radiusB, float distSq) {
+				Contact<V> contact;
+				float dist = std::sqrt(distSq);
+				contact.normal = dist > 0 ? (centerB - centerA) / dist : UnitX<V>();
+				contact.depth = (radiusA + radiusB) - dist;
+				contact.point = centerA + contact.normal * (radiusA - (contact.depth * 0.5f));
+				return contact;
+			}
+		}
+
+		// Spheres and circles --------------------------------------------
+
+		template<typename V>
+		constexpr bool Overlaps(const BoundingSphere<V>& a, const BoundingSphere<V>& b) {
+			return a.Overlaps(b);
+		}
+
+		template<typename V>
+		inline bool Intersect(const BoundingSphere<V>& a, const BoundingSphere<V>& b, Contact<V>& outContact) {
+			float distSq = (b.center - a.center).MagnitudeSqr();
+			float reach = a.radius + b.radius;
+			if (distSq > reach * reach) { return false; }
+			outContact = Detail::SphereContact(a.center, a.radius, b.center, b.radius, distSq);
+			return true;
+		}
+
+		// Boxes ----------------------------------------------------------
+
+		template<typename V>
+		constexpr bool Overlaps(const BoundingBox<V>& a, const BoundingBox<V>& b) {
+			return a.Overlaps(b);
+		}
+
+		/**
+		 * Separates two boxes along the axis on which they overlap least.
+		 */
+		template<typename V>
+		inline bool Intersect(const BoundingBox<V>& a, const BoundingBox<V>& b, Contact<V>& outContact) {
+			if (!a.Overlaps(b)) { return false; }
+
+			V low = V::Map([&](auto i) { return std::max(a.min.Get(i), b.min.Get(i)); });
+			V high = V::Map([&](auto i) { return std::min(a.max.Get(i), b.max.Get(i)); });
+			V overlap = high - low;
+			V between = b.Center() - a.Center();
+
+			size_t axis = 0;
+			for (size_t i = 1; i < V::Dimension; i++) {
+				if (overlap[(int)i] < overlap[(int)axis]) { axis = i; }
+			}
+			outContact.normal = Detail::UnitAxis<V>(axis, between[(int)axis] >= 0 ? 1.0f : -1.0f);
+			outContact.depth = overlap[(int)axis];
+			outContact.point = (low + high) * 0.5f;
+			return true;
+		}
+
+		// Sphere and box -------------------------------------------------
+
+		template<typename V>
+		constexpr bool Overlaps(const BoundingSphere<V>& a, const BoundingBox<V>& b) {
+			V offset = a.center - Detail::Clamp(a.center, b);
+			return offset.MagnitudeSqr() <= a.radius * a.radius;
+		}
+
+		template<typename V>
+		constexpr bool Overlaps(const BoundingBox<V>& a, const BoundingSphere<V>& b) {
+			return Overlaps(b, a);
+		}
+
+		/**
+		 * Pushes the sphere out of the box by the nearest point on the box,
+		 * or through the nearest face when its centre is inside.
+		 */
+		template<typename V>
+		inline bool Intersect(const BoundingSphere<V>& a, const BoundingBox<V>& b, Contact<V>& outContact) {
+			V closest = Detail::Clamp(a.center, b);
+			V offset = a.center - closest;
+			float distSq = offset.MagnitudeSqr();
+			if (distSq > a.radius * a.radius) { return false; }
+
+			if (distSq > 0) {
+				float dist = std::sqrt(distSq);
+				outContact.normal = offset / -dist;
+				outContact.depth = a.radius - dist;
+				outContact.point = closest;
+				return true;
+			}
+
+			// the centre is inside: leaving through the min face on an axis
+			// means b lies towards +axis of a
+			size_t axis = 0;
+			float sign = 1.0f, best = a.center[0] - b.min[0];
+			for (size_t i = 0; i < V::Dimension; i++) {
+				float toMin = a.center[(int)i] - b.min[(int)i];
+				float toMax = b.max[(int)i] - a.center[(int)i];
+				if (toMin < best) { best = toMin; axis = i; sign = 1.0f; }
+				if (toMax < best) { best = toMax; axis = i; sign = -1.0f; }
+			}
+			outContact.normal = Detail::UnitAxis<V>(axis, sign);
+			outContact.depth = a.radius + best;
+			outContact.point = a.center;
+			outContact.point[(int)axis] = sign > 0 ? b.min[(int)axis] : b.max[(int)axis];
+			return true;
+		}
+
+		template<typename V>
+		inline bool Intersect(const BoundingBox<V>& a, const BoundingSphere<V>& b, Contact<V>& outContact) {
+			Contact<V> contact;
+			if (!Intersect(b, a, contact)) { return false; }
+			outContact = contact.Flipped();
+			return true;
+		}
+
+		// Capsules -------------------------------------------------------
+
+		template<typename V>
+		constexpr bool Overlaps(const CapsuleShape<V>& a, const BoundingSphere<V>& b) {
+			V offset = b.center - ClosestPointOnSegment(a.a, a.b, b.center);
+			float reach = a.radius + b.radius;
+			return offset.MagnitudeSqr() <= reach * reach;
+		}
+
+		template<typename V>
+		constexpr bool Overlaps(const BoundingSphere<V>& a, const CapsuleShape<V>& b) {
+			return Overlaps(b, a);
+		}
+
+		template<typename V>
+		inline bool Intersect(const CapsuleShape<V>& a, const BoundingSphere<V>& b, Contact<V>& outContact) {
+			V closest = ClosestPointOnSegment(a.a, a.b, b.center);
+			float distSq = (b.center - closest).MagnitudeSqr();
+			float reach = a.radius + b.radius;
+			if (distSq > reach * reach) { return false; }
+			outContact = Detail::SphereContact(closest, a.radius, b.center, b.radius, distSq);
+			return true;
+		}
+
+		template<typename V>
+		inline bool Intersect(const BoundingSphere<V>& a, const CapsuleShape<V>& b, Contact<V>& outContact) {
+			Contact<V> contact;
+			if (!Intersect(b, a, contact)) { return false; }
+			outContact = contact.Flipped();
+			return true;
+		}
+
+		template<typename V>
+		constexpr bool Overlaps(const CapsuleShape<V>& a, const CapsuleShape<V>& b) {
+			V closestA, closestB;
+			ClosestPointsOnSegments(a.a, a.b, b.a, b.b, closestA, closestB);
+			float reach = a.radius + b.radius;
+			return (closestB - closestA).MagnitudeSqr() <= reach * reach;
+		}
+
+		template<typename V>
+		inline bool Intersect(const CapsuleShape<V>& a, const CapsuleShape<V>& b, Contact<V>& outContact) {
+			V closestA, closestB;
+			ClosestPointsOnSegments(a.a, a.b, b.a, b.b, closestA, closestB);
+			float distSq = (closestB - closestA).MagnitudeSqr();
+			float reach = a.radius + b.radius;
+			if (distSq > reach * reach) { return false; }
+			outContact = Detail::SphereContact(closestA, a.radius, closestB, b.radius, distSq);
+			return true;
+		}
+
+		// Segments -------------------------------------------------------
+
+		/**
+		 * Finds where a segment first enters a sphere.
+		 *
+		 * @param segment The segment, travelled from a to b.
+		 * @param sphere The sphere.
+		 * @param outT Set to the fraction of the way along the segment of the first point inside, 0 if a is inside.
+		 * @return True if any part of the segment is inside the sphere.
+		 */
+		template<typename V>
+		inline bool Cast(const LineSegment<V>& segment, const BoundingSphere<V>& sphere, float& outT) {
+			V d = segment.b - segment.a, m = segment.a - sphere.center;
+			float c = m.MagnitudeSqr() - (sphere.radius * sphere.radius);
+			if (c <= 0) {
+				outT = 0;
+				return true;
+			}
+
+			float a = d.MagnitudeSqr(), b = m.Dot(d);
+			float discriminant = (b * b) - (a * c);
+			if (a == 0 || b >= 0 || discriminant < 0) { return false; }
+			float t = (-b - std::sqrt(discriminant)) / a;
+			if (t > 1) { return false; }
+			outT = t;
+			return true;
+		}
+
+		/**
+		 * Finds where a segment first enters a box, by clipping it against
+		 * the slab between each pair of faces.
+		 *
+		 * @param segment The segment, travelled from a to b.
+		 * @param box The box.
+		 * @param outT Set to the fraction of the way along the segment of the first point inside, 0 if a is inside.
+		 * @return True if any part of the segment is inside the box.
+		 */
+		template<typename V>
+		inline bool Cast(const LineSegment<V>& segment, const BoundingBox<V>& box, float& outT) {
+			float tMin = 0, tMax = 1.0f;
+			for (int i = 0; i < (int)V::Dimension; i++) {
+				float d = segment.b[i] - segment.a[i];
+				if (d == 0) {
+					if (segment.a[i] < box.min[i] || segment.a[i] > box.max[i]) { return false; }
+					continue;
+				}
+				float inv = 1.0f / d;
+				float t1 = (box.min[i] - segment.a[i]) * inv;
+				float t2 = (box.max[i] - segment.a[i]) * inv;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+				if (tMin > tMax) { return false; }
+			}
+			outT = tMin;
+			return true;
+		}
+
+		inline bool Cast(const Segment2& segment, const OBB2& box, float& outT) {
+			Segment2 local(box.ToLocal(segment.a), box.ToLocal(segment.b));
+			return Cast(local, AABB2(box.extents * -1.0f, box.extents), outT);
+		}
+
+		template<typename V>
+		constexpr bool Overlaps(const LineSegment<V>& a, const BoundingSphere<V>& b) {
+			return (b.center - ClosestPointOnSegment(a.a, a.b, b.center)).MagnitudeSqr() <= b.radius * b.radius;
+		}
+
+		template<typename V>
+		inline bool Overlaps(const LineSegment<V>& a, const BoundingBox<V>& b) {
+			float t;
+			return Cast(a, b, t);
+		}
+
+		inline bool Overlaps(const Segment2& a, const OBB2& b) {
+			float t;
+			return Cast(a, b, t);
+		}
+
+		// Rotated boxes --------------------------------------------------
+
+		namespace Detail
+		{
+			/**
+			 * The separating axis test between two rotated boxes. Returns
+			 * false at the first separating axis, otherwise the axis of
+			 * least overlap, pointing from a to b, and that overlap.
+			 */
+			inline bool LeastOverlapAxis(const OBB2& a, const OBB2& b, Vector2& outAxis, float& outOverlap) {
+				const Vector2 axes[4] = { a.axisX, a.AxisY(), b.axisX, b.AxisY() };
+				Vector2 between = b.center - a.center;
+				outOverlap = 0;
+				for (int i = 0; i < 4; i++) {
+					float distance = between.Dot(axes[i]);
+					float overlap = (a.ProjectedRadius(axes[i]) + b.ProjectedRadius(axes[i])) - std::abs(distance);
+					if (overlap < 0) { return false; }
+					if (i == 0 || overlap < outOverlap) {
+						outOverlap = overlap;
+						outAxis = distance >= 0 ? axes[i] : axes[i] * -1.0f;
+					}
+				}
+				return true;
+			}
+		}
+
+		inline bool Overlaps(const OBB2& a, const OBB2& b) {
+			Vector2 axis;
+			float overlap;
+			return Detail::LeastOverlapAxis(a, b, axis, overlap);
+		}
+
+		/**
+		 * Separates two rotated boxes along the axis of least overlap. The
+		 * contact point is b's corner deepest inside a.
+		 */
+		inline bool Intersect(const OBB2& a, const OBB2& b, Contact2& outContact) {
+			Vector2 axis;
+			float overlap;
+			if (!Detail::LeastOverlapAxis(a, b, axis, overlap)) { return false; }
+			outContact.normal = axis;
+			outContact.depth = overlap;
+			outContact.point = b.Support(axis * -1.0f);
+			return true;
+		}
+
+		inline bool Overlaps(const OBB2& a, const AABB2& b) { return Overlaps(a, OBB2(b)); }
+		inline bool Overlaps(const AABB2& a, const OBB2& b) { return Overlaps(OBB2(a), b); }
+		inline bool Intersect(const OBB2& a, const AABB2& b, Contact2& outContact) { return Intersect(a, OBB2(b), outContact); }
+		inline bool Intersect(const AABB2& a, const OBB2& b, Contact2& outContact) { return Intersect(OBB2(a), b, outContact); }
+
+		/**
+		 * Tests the circle in the box's frame, where the box is axis-aligned.
+		 */
+		inline bool Overlaps(const Circle& a, const OBB2& b) {
+			return Overlaps(Circle(b.ToLocal(a.center), a.radius), AABB2(b.extents * -1.0f, b.extents));
+		}
+
+		inline bool Overlaps(const OBB2& a, const Circle& b) {
+			return Overlaps(b, a);
+		}
+
+		inline bool Intersect(const Circle& a, const OBB2& b, Contact2& outContact) {
+			Contact2 local;
+			if (!Intersect(Circle(b.ToLocal(a.center), a.radius), AABB2(b.extents * -1.0f, b.extents), local)) { return false; }
+			outContact.normal = b.ToWorldVector(local.normal);
+			outContact.depth = local.depth;
+			outContact.point = b.ToWorld(local.point);
+			return true;
+		}
+
+		inline bool Intersect(const OBB2& a, const Circle& b, Contact2& outContact) {
+			Contact2 contact;
+			if (!Intersect(b, a, contact)) { return false; }
+			outContact = contact.Flipped();
+			return true;
+		}
+
+		// Batches --------------------------------------------------------
+
+		/**
+		 * Returns the number of 32-bit words in the hit mask of count
+		 * candidates.
+		 */
+		constexpr size_t MaskWords(size_t count) {
+			return (count + 31) / 32;
+		}
+
+		/**
+		 * Returns true if candidate i is set in a hit mask.
+		 */
+		constexpr bool IsHit(const uint32_t* mask, size_t i) {
+			return ((mask[i / 32] >> (i % 32)) & 1) != 0;
+		}
+
+		namespace Detail
+		{
+			/**
+			 * Runs a four-wide overlap test over count candidates and
+			 * writes the hit mask, returning the number of hits. test(i)
+			 * returns a lane mask for candidates i to i + 3, and single(i)
+			 * tests candidate i alone.
+			 */
+			template<typename Test4, typename Test1>
+			inline size_t WriteMask(size_t count, uint32_t* mask, Test4&& test, Test1&& single) {
+				std::fill(mask, mask + MaskWords(count), 0u);
+				size_t hits = 0, i = 0;
+				for (; i + 4 <= count; i += 4) {
+					uint32_t bits = (uint32_t)Simd::MoveMask(test(i));
+					mask[i / 32] |= bits << (i % 32);
+					hits += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + (bits >> 3);
+				}
+				for (; i < count; i++) {
+					if (single(i)) {
+						mask[i / 32] |= 1u << (i % 32);
+						hits++;
+					}
+				}
+				return hits;
+			}
+
+			/**
+			 * Runs a four-wide overlap test over count candidates and calls
+			 * intersect(i, contact) for each hit, appending those that
+			 * report a contact. Returns the number of contacts written.
+			 */
+			template<typename Test4, typename Test1, typename IntersectFn>
+			inline size_t WriteContacts(size_t count, uint32_t* outIndices, Contact2* outContacts, Test4&& test, Test1&& single, IntersectFn&& intersect) {
+				size_t written = 0, i = 0;
+				for (; i + 4 <= count; i += 4) {
+					int bits = Simd::MoveMask(test(i));
+					if (bits == 0) { continue; }
+					for (size_t lane = 0; lane < 4; lane++) {
+						if (((bits >> lane) & 1) && intersect(i + lane, outContacts[written])) { outIndices[written++] = (uint32_t)(i + lane); }
+					}
+				}
+				for (; i < count; i++) {
+					if (single(i) && intersect(i, outContacts[written])) { outIndices[written++] = (uint32_t)i; }
+				}
+				return written;
+			}
+
+			inline Simd::Float4 CircleCircle4(const Circle& query, const CircleStream& others, size_t i) {
+				Simd::Float4 dx = Simd::Sub(Simd::LoadUnaligned(others.center.x.data() + i), Simd::Splat(query.center.x));
+				Simd::Float4 dy = Simd::Sub(Simd::LoadUnaligned(others.center.y.data() + i), Simd::Splat(query.center.y));
+				Simd::Float4 reach = Simd::Add(Simd::Splat(query.radius), Simd::LoadUnaligned(others.radius.data() + i));
+				return Simd::CmpLe(Simd::Add(Simd::Mul(dx, dx), Simd::Mul(dy, dy)), Simd::Mul(reach, reach));
+			}
+
+			inline Simd::Float4 CircleBox4(const Circle& query, const AABB2Stream& others, size_t i) {
+				Simd::Float4 x = Simd::Splat(query.center.x), y = Simd::Splat(query.center.y);
+				Simd::Float4 dx = Simd::Sub(x, Simd::Min(Simd::Max(x, Simd::LoadUnaligned(others.min.x.data() + i)), Simd::LoadUnaligned(others.max.x.data() + i)));
+				Simd::Float4 dy = Simd::Sub(y, Simd::Min(Simd::Max(y, Simd::LoadUnaligned(others.min.y.data() + i)), Simd::LoadUnaligned(others.max.y.data() + i)));
+				return Simd::CmpLe(Simd::Add(Simd::Mul(dx, dx), Simd::Mul(dy, dy)), Simd::Splat(query.radius * query.radius));
+			}
+
+			inline Simd::Float4 BoxBox4(const AABB2& query, const AABB2Stream& others, size_t i) {
+				Simd::Float4 x = Simd::And(
+					Simd::CmpLe(Simd::Splat(query.min.x), Simd::LoadUnaligned(others.max.x.data() + i)),
+					Simd::CmpLe(Simd::LoadUnaligned(others.min.x.data() + i), Simd::Splat(query.max.x)));
+				Simd::Float4 y = Simd::And(
+					Simd::CmpLe(Simd::Splat(query.min.y), Simd::LoadUnaligned(others.max.y.data() + i)),
+					Simd::CmpLe(Simd::LoadUnaligned(others.min.y.data() + i), Simd::Splat(query.max.y)));
+				return Simd::And(x, y);
+			}
+		}
+
+		/**
+		 * Tests a circle against every circle of a stream.
+		 *
+		 * @param query The circle to test.
+		 * @param others The candidates.
+		 * @param outMask Destination for the hit mask, holding MaskWords(others.Size()) words.
+		 * @return The number of hits.
+		 */
+		inline size_t OverlapMask(const Circle& query, const CircleStream& others, uint32_t* outMask) {
+			return Detail::WriteMask(others.Size(), outMask,
+				[&](size_t i) { return Detail::CircleCircle4(query, others, i); },
+				[&](size_t i) { return Overlaps(query, others.Get(i)); });
+		}
+
+		/**
+		 * Tests a circle against every box of a stream. See
+		 * OverlapMask(const Circle&, const CircleStream&, uint32_t*).
+		 */
+		inline size_t OverlapMask(const Circle& query, const AABB2Stream& others, uint32_t* outMask) {
+			return Detail::WriteMask(others.Size(), outMask,
+				[&](size_t i) { return Detail::CircleBox4(query, others, i); },
+				[&](size_t i) { return Overlaps(query, others.Get(i)); });
+		}
+
+		/**
+		 * Tests a box against every box of a stream. See
+		 * OverlapMask(const Circle&, const CircleStream&, uint32_t*).
+		 */
+		inline size_t OverlapMask(const AABB2& query, const AABB2Stream& others, uint32_t* outMask) {
+			return Detail::WriteMask(others.Size(), outMask,
+				[&](size_t i) { return Detail::BoxBox4(query, others, i); },
+				[&](size_t i) { return Overlaps(query, others.Get(i)); });
+		}
+
+		/**
+		 * Tests a capsule against every circle of a stream. See
+		 * OverlapMask(const Circle&, const CircleStream&, uint32_t*).
+		 */
+		inline size_t OverlapMask(const Capsule2& query, const CircleStream& others, uint32_t* outMask) {
+			const Vector2 ab = query.b - query.a;
+			const float lengthSq = ab.MagnitudeSqr();
+			const Simd::Float4 ax = Simd::Splat(query.a.x), ay = Simd::Splat(query.a.y);
+			const Simd::Float4 abx = Simd::Splat(ab.x), aby = Simd::Splat(ab.y);
+			const Simd::Float4 zero = Simd::Zero(), one = Simd::Splat(1.0f);
+
+			return Detail::WriteMask(others.Size(), outMask,
+				[&](size_t i) {
+					Simd::Float4 x = Simd::LoadUnaligned(others.center.x.data() + i);
+					Simd::Float4 y = Simd::LoadUnaligned(others.center.y.data() + i);
+					Simd::Float4 t = zero;
+					if (lengthSq > 0) {
+						Simd::Float4 along = Simd::Add(Simd::Mul(Simd::Sub(x, ax), abx), Simd::Mul(Simd::Sub(y, ay), aby));
+						t = Simd::Min(Simd::Max(Simd::Div(along, Simd::Splat(lengthSq)), zero), one);
+					}
+					Simd::Float4 dx = Simd::Sub(x, Simd::Add(ax, Simd::Mul(abx, t)));
+					Simd::Float4 dy = Simd::Sub(y, Simd::Add(ay, Simd::Mul(aby, t)));
+					Simd::Float4 reach = Simd::Add(Simd::Splat(query.radius), Simd::LoadUnaligned(others.radius.data() + i));
+					return Simd::CmpLe(Simd::Add(Simd::Mul(dx, dx), Simd::Mul(dy, dy)), Simd::Mul(reach, reach));
+				},
+				[&](size_t i) { return Overlaps(query, others.Get(i)); });
+		}
+
+		/**
+		 * Tests a segment against every box of a stream, such as a line of
+		 * sight against walls. See
+		 * OverlapMask(const Circle&, const CircleStream&, uint32_t*).
+		 */
+		inline size_t OverlapMask(const Segment2& query, const AABB2Stream& others, uint32_t* outMask) {
+			const float dx = query.b.x - query.a.x, dy = query.b.y - query.a.y;
+			const Simd::Float4 ax = Simd::Splat(query.a.x), ay = Simd::Splat(query.a.y);
+			const Simd::Float4 invX = Simd::Splat(dx != 0 ? 1.0f / dx : 0.0f);
+			const Simd::Float4 invY = Simd::Splat(dy != 0 ? 1.0f / dy : 0.0f);
+
+			return Detail::WriteMask(others.Size(), outMask,
+				[&](size_t i) {
+					Simd::Float4 minX = Simd::LoadUnaligned(others.min.x.data() + i), maxX = Simd::LoadUnaligned(others.max.x.data() + i);
+					Simd::Float4 minY = Simd::LoadUnaligned(others.min.y.data() + i), maxY = Simd::LoadUnaligned(others.max.y.data() + i);
+					Simd::Float4 tMin = Simd::Zero(), tMax = Simd::Splat(1.0f);
+					Simd::Float4 hit = Simd::CmpEq(tMin, tMin);
+
+					// a segment parallel to an axis must start within that slab
+					if (dx == 0) {
+						hit = Simd::And(hit, Simd::And(Simd::CmpGe(ax, minX), Simd::CmpLe(ax, maxX)));
+					}
+					else {
+						Simd::Float4 t1 = Simd::Mul(Simd::Sub(minX, ax), invX), t2 = Simd::Mul(Simd::Sub(maxX, ax), invX);
+						tMin = Simd::Max(tMin, Simd::Min(t1, t2));
+						tMax = Simd::Min(tMax, Simd::Max(t1, t2));
+					}
+					if (dy == 0) {
+						hit = Simd::And(hit, Simd::And(Simd::CmpGe(ay, minY), Simd::CmpLe(ay, maxY)));
+					}
+					else {
+						Simd::Float4 t1 = Simd::Mul(Simd::Sub(minY, ay), invY), t2 = Simd::Mul(Simd::Sub(maxY, ay), invY);
+						tMin = Simd::Max(tMin, Simd::Min(t1, t2));
+						tMax = Simd::Min(tMax, Simd::Max(t1, t2));
+					}
+					return Simd::And(hit, Simd::CmpLe(tMin, tMax));
+				},
+				[&](size_t i) { return Overlaps(query, others.Get(i)); });
+		}
+
+		/**
+		 * Finds the contacts between a circle and every circle of a stream
+		 * it overlaps. Candidates are rejected four at a time, and the
+		 * contacts of the hits are filled in by Intersect().
+		 *
+		 * @param query The circle to test, shape a of each contact.
+		 * @param others The candidates, each shape b of its contact.
+		 * @param outIndices Destination for the candidate index of each contact, holding at least others.Size() entries.
+		 * @param outContacts Destination for the contacts, holding at least others.Size() entries.
+		 * @return The number of contacts written.
+		 */
+		inline size_t Contacts(const Circle& query, const CircleStream& others, uint32_t* outIndices, Contact2* outContacts) {
+			return Detail::WriteContacts(others.Size(), outIndices, outContacts,
+				[&](size_t i) { return Detail::CircleCircle4(query, others, i); },
+				[&](size_t i) { return Overlaps(query, others.Get(i)); },
+				[&](size_t i, Contact2& contact) { return Intersect(query, others.Get(i), contact); });
+		}
+
+		/**
+		 * Finds the contacts between a circle and every box of a stream it
+		 * overlaps. See Contacts(const Circle&, const CircleStream&, uint32_t*, Contact2*).
+		 */
+		inline size_t Contacts(const Circle& query, const AABB2Stream& others, uint32_t* outIndices, Contact2* outContacts) {
+			return Detail::WriteContacts(others.Size(), outIndices, outContacts,
+				[&](size_t i) { return Detail::CircleBox4(query, others, i); },
+				[&](size_t i) { return Overlaps(query, others.Get(i)); },
+				[&](size_t i, Contact2& contact) { return Intersect(query, others.Get(i), contact); });
+		}
+
+		/**
+		 * Finds the contacts between a box and every box of a stream it
+		 * overlaps. See Contacts(const Circle&, const CircleStream&, uint32_t*, Contact2*).
+		 */
+		inline size_t Contacts(const AABB2& query, const AABB2Stream& others, uint32_t* outIndices, Contact2* outContacts) {
+			return Detail::WriteContacts(others.Size(), outIndices, outContacts,
+				[&](size_t i) { return Detail::BoxBox4(query, others, i); },
+				[&](size_t i) { return Overlaps(query, others.Get(i)); },
+				[&](size_t i, Contact2& contact) { return Intersect(query, others.Get(i), contact); });
+		}
+	}
+}
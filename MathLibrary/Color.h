@@ -0,0 +1,363 @@
+#pragma once
+#include "Vector4.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MathClasses
+{
+	/**
+	 * An 8-bit-per-channel RGBA colour, packed into 4 bytes in r, g, b, a
+	 * order. This is the same layout as raylib's Color, so arrays of either
+	 * can be reinterpreted as the other without copying (see AsRaylib).
+	 *
+	 * Byte math rounds to nearest: multiplying two channels gives
+	 * round(x * y / 255), so tinting by white or blending at full alpha
+	 * returns the input unchanged.
+	 */
+	struct Color
+	{
+		union
+		{
+			struct
+			{
+				uint8_t r, g, b, a;
+			};
+
+			uint8_t v[4];
+			uint32_t rgba;
+		};
+
+		/**
+		 * Initializes to opaque black.
+		 */
+		constexpr Color() : Color(0, 0, 0, 255) {}
+
+		constexpr Color(uint8_t inR, uint8_t inG, uint8_t inB, uint8_t inA = 255)
+			: r(inR), g(inG), b(inB), a(inA) {}
+
+#ifdef RAYLIB_CPP_INCLUDE_RAYLIB_CPP_HPP_
+		Color(const raylib::Color& RColor) : Color(RColor.r, RColor.g, RColor.b, RColor.a) {}
+		operator raylib::Color() const { return raylib::Color(r, g, b, a); }
+#endif
+
+#ifdef RAYLIB_H
+		Color(const ::Color& RColor) : Color(RColor.r, RColor.g, RColor.b, RColor.a) {}
+		operator ::Color() const { return { r, g, b, a }; }
+#endif
+
+		/**
+		 * Returns round(n / 255) for n in [0, 255 * 255], without dividing.
+		 */
+		static constexpr uint8_t Div255(uint32_t n) {
+			n += 128;
+			return (uint8_t)((n + (n >> 8)) >> 8);
+		}
+
+		/**
+		 * Multiplies every channel by the other's, as tinting a sprite does.
+		 */
+		constexpr Color operator *(Color rhs) const {
+			return { Div255(r * rhs.r), Div255(g * rhs.g), Div255(b * rhs.b), Div255(a * rhs.a) };
+		}
+
+		constexpr Color& operator *=(Color rhs) {
+			return *this = *this * rhs;
+		}
+
+		/**
+		 * Returns this colour with r, g and b multiplied by alpha.
+		 */
+		constexpr Color Premultiplied() const {
+			return { Div255(r * a), Div255(g * a), Div255(b * a), a };
+		}
+
+		/**
+		 * Composites src over dst using src's alpha, as drawing a sprite
+		 * with alpha blending does. Both colours are straight (not
+		 * premultiplied) alpha.
+		 *
+		 * @param src The colour drawn on top.
+		 * @param dst The colour underneath.
+		 * @return The colour channels are lerped by src.a; the alpha is src.a + dst.a * (1 - src.a).
+		 */
+		static constexpr Color Blend(Color src, Color dst) {
+			uint32_t inverse = 255u - src.a;
+			return {
+				Div255(src.r * src.a + dst.r * inverse),
+				Div255(src.g * src.a + dst.g * inverse),
+				Div255(src.b * src.a + dst.b * inverse),
+				(uint8_t)(src.a + Div255(dst.a * inverse))
+			};
+		}
+
+		/**
+		 * Linearly interpolates every channel. The fraction is clamped to
+		 * [0, 1] and rounded to a weight out of 255.
+		 */
+		static constexpr Color Lerp(Color start, Color end, float t) {
+			uint32_t weight = LerpWeight(t);
+			uint32_t inverse = 255u - weight;
+			return {
+				Div255(start.r * inverse + end.r * weight),
+				Div255(start.g * inverse + end.g * weight),
+				Div255(start.b * inverse + end.b * weight),
+				Div255(start.a * inverse + end.a * weight)
+			};
+		}
+
+		static constexpr uint32_t LerpWeight(float t) {
+			return (uint32_t)(std::min(std::max(t, 0.0f), 1.0f) * 255.0f + 0.5f);
+		}
+
+		/**
+		 * Returns the channels as floats in [0, 1], in x, y, z, w order.
+		 */
+		constexpr Vector4 ToVector4() const {
+			return { r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f };
+		}
+
+		/**
+		 * Converts channels in [0, 1] to bytes, rounding to nearest.
+		 * Values outside the range are clamped.
+		 */
+		static constexpr Color FromVector4(const Vector4& v) {
+			return { ToByte(v.x), ToByte(v.y), ToByte(v.z), ToByte(v.w) };
+		}
+
+		static constexpr uint8_t ToByte(float channel) {
+			return (uint8_t)(std::min(std::max(channel, 0.0f), 1.0f) * 255.0f + 0.5f);
+		}
+
+		constexpr bool operator ==(const Color& rhs) const {
+			return r == rhs.r && g == rhs.g && b == rhs.b && a == rhs.a;
+		}
+
+		constexpr bool operator !=(const Color& rhs) const {
+			return !(*this == rhs);
+		}
+
+		std::string ToString() const {
+			return "r: " + std::to_string(r) + ", g: " + std::to_string(g) + ", b: " + std::to_string(b) + ", a: " + std::to_string(a);
+		}
+
+		uint8_t& operator [](int channel) {
+			return v[channel];
+		}
+
+		const uint8_t& operator [](int channel) const {
+			return v[channel];
+		}
+	};
+
+	static_assert(sizeof(Color) == 4, "Color must match the 4-byte layout of raylib's Color");
+
+#ifdef RAYLIB_H
+	static_assert(sizeof(::Color) == sizeof(Color), "raylib's Color layout has changed");
+
+	/**
+	 * Views an array of colours as raylib colours, for passing pixel or
+	 * vertex colour buffers straight to raylib.
+	 */
+	inline ::Color* AsRaylib(Color* colors) { return reinterpret_cast<::Color*>(colors); }
+	inline const ::Color* AsRaylib(const Color* colors) { return reinterpret_cast<const ::Color*>(colors); }
+#endif
+
+	namespace Detail
+	{
+		/**
+		 * The channels of four colours, one colour per lane, as floats
+		 * holding whole numbers in [0, 255].
+		 */
+		struct ColorChannels4
+		{
+			Simd::Float4 r, g, b, a;
+		};
+
+		inline ColorChannels4 LoadColors4(const Color* colors)
+		{
+			// r is the lowest byte of each little-endian 32-bit lane
+			Simd::Int4 packed = Simd::LoadUnaligned(reinterpret_cast<const int32_t*>(&colors->rgba));
+			const Simd::Int4 mask = Simd::SplatInt(0xFF);
+			return {
+				Simd::ConvertToFloat(Simd::And(packed, mask)),
+				Simd::ConvertToFloat(Simd::And(Simd::ShiftRight<8>(packed), mask)),
+				Simd::ConvertToFloat(Simd::And(Simd::ShiftRight<16>(packed), mask)),
+				Simd::ConvertToFloat(Simd::ShiftRight<24>(packed))
+			};
+		}
+
+		/**
+		 * Rounds each channel to the nearest whole number and stores the
+		 * four colours. Channels must be in [0, 255].
+		 */
+		inline void StoreColors4(Color* colors, const ColorChannels4& c)
+		{
+			const Simd::Float4 half = Simd::Splat(0.5f);
+			Simd::Int4 r = Simd::ConvertToInt(Simd::Add(c.r, half));
+			Simd::Int4 g = Simd::ConvertToInt(Simd::Add(c.g, half));
+			Simd::Int4 b = Simd::ConvertToInt(Simd::Add(c.b, half));
+			Simd::Int4 a = Simd::ConvertToInt(Simd::Add(c.a, half));
+			Simd::Int4 packed = Simd::Or(Simd::Or(r, Simd::ShiftLeft<8>(g)), Simd::Or(Simd::ShiftLeft<16>(b), Simd::ShiftLeft<24>(a)));
+			Simd::StoreUnaligned(reinterpret_cast<int32_t*>(&colors->rgba), packed);
+		}
+
+		/**
+		 * n / 255 for whole numbers n in [0, 255 * 255]. Multiplying by the
+		 * rounded reciprocal errs by under 1e-4, and n / 255 is never
+		 * within 1/510 of a half, so rounding the result afterwards gives
+		 * exactly Color::Div255.
+		 */
+		inline Simd::Float4 Div255(Simd::Float4 n)
+		{
+			return Simd::Mul(n, Simd::Splat(1.0f / 255.0f));
+		}
+	}
+
+	/*
+	 * Kernels over arrays of colours, four colours per iteration. Each gives
+	 * exactly the same bytes as the scalar operation it names, and outputs
+	 * may alias inputs.
+	 */
+	namespace ColorKernels
+	{
+		/**
+		 * out[i] = in[i] * tint
+		 */
+		inline void Tint(const Color* in, Color tint, Color* out, size_t count)
+		{
+			const Simd::Float4 tr = Simd::Splat(tint.r), tg = Simd::Splat(tint.g);
+			const Simd::Float4 tb = Simd::Splat(tint.b), ta = Simd::Splat(tint.a);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 c = Detail::LoadColors4(in + i);
+				Detail::StoreColors4(out + i, {
+					Detail::Div255(Simd::Mul(c.r, tr)), Detail::Div255(Simd::Mul(c.g, tg)),
+					Detail::Div255(Simd::Mul(c.b, tb)), Detail::Div255(Simd::Mul(c.a, ta)) });
+			}
+			for (; i < count; i++) {
+				out[i] = in[i] * tint;
+			}
+		}
+
+		/**
+		 * out[i] = in[i].Premultiplied()
+		 */
+		inline void Premultiply(const Color* in, Color* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 c = Detail::LoadColors4(in + i);
+				Detail::StoreColors4(out + i, {
+					Detail::Div255(Simd::Mul(c.r, c.a)), Detail::Div255(Simd::Mul(c.g, c.a)),
+					Detail::Div255(Simd::Mul(c.b, c.a)), c.a });
+			}
+			for (; i < count; i++) {
+				out[i] = in[i].Premultiplied();
+			}
+		}
+
+		/**
+		 * out[i] = Color::Blend(src[i], dst[i])
+		 */
+		inline void Blend(const Color* src, const Color* dst, Color* out, size_t count)
+		{
+			const Simd::Float4 full = Simd::Splat(255.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 s = Detail::LoadColors4(src + i);
+				Detail::ColorChannels4 d = Detail::LoadColors4(dst + i);
+				Simd::Float4 inverse = Simd::Sub(full, s.a);
+
+				// products and sums are whole numbers below 2^24, so exact
+				// in float; adding the whole s.a before rounding the alpha
+				// cannot change how it rounds
+				Detail::StoreColors4(out + i, {
+					Detail::Div255(Simd::Add(Simd::Mul(s.r, s.a), Simd::Mul(d.r, inverse))),
+					Detail::Div255(Simd::Add(Simd::Mul(s.g, s.a), Simd::Mul(d.g, inverse))),
+					Detail::Div255(Simd::Add(Simd::Mul(s.b, s.a), Simd::Mul(d.b, inverse))),
+					Simd::Add(s.a, Detail::Div255(Simd::Mul(d.a, inverse))) });
+			}
+			for (; i < count; i++) {
+				out[i] = Color::Blend(src[i], dst[i]);
+			}
+		}
+
+		/**
+		 * out[i] = Color::Lerp(start[i], end[i], t)
+		 */
+		inline void Lerp(const Color* start, const Color* end, float t, Color* out, size_t count)
+		{
+			const uint32_t weight = Color::LerpWeight(t);
+			const Simd::Float4 w = Simd::Splat((float)weight);
+			const Simd::Float4 inverse = Simd::Splat((float)(255u - weight));
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 s = Detail::LoadColors4(start + i);
+				Detail::ColorChannels4 e = Detail::LoadColors4(end + i);
+				Detail::StoreColors4(out + i, {
+					Detail::Div255(Simd::Add(Simd::Mul(s.r, inverse), Simd::Mul(e.r, w))),
+					Detail::Div255(Simd::Add(Simd::Mul(s.g, inverse), Simd::Mul(e.g, w))),
+					Detail::Div255(Simd::Add(Simd::Mul(s.b, inverse), Simd::Mul(e.b, w))),
+					Detail::Div255(Simd::Add(Simd::Mul(s.a, inverse), Simd::Mul(e.a, w))) });
+			}
+			for (; i < count; i++) {
+				out[i] = Color::Lerp(start[i], end[i], t);
+			}
+		}
+
+		/**
+		 * out[i] = in[i].ToVector4()
+		 */
+		inline void ToVector4(const Color* in, Vector4* out, size_t count)
+		{
+			const Simd::Float4 full = Simd::Splat(255.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 c = Detail::LoadColors4(in + i);
+				Simd::Float4 r = Simd::Div(c.r, full), g = Simd::Div(c.g, full);
+				Simd::Float4 b = Simd::Div(c.b, full), a = Simd::Div(c.a, full);
+
+				// one colour per lane becomes one colour per register
+				Simd::Transpose(r, g, b, a);
+				out[i + 0].simd = r;
+				out[i + 1].simd = g;
+				out[i + 2].simd = b;
+				out[i + 3].simd = a;
+			}
+			for (; i < count; i++) {
+				out[i] = in[i].ToVector4();
+			}
+		}
+
+		/**
+		 * out[i] = Color::FromVector4(in[i])
+		 */
+		inline void FromVector4(const Vector4* in, Color* out, size_t count)
+		{
+			const Simd::Float4 zero = Simd::Zero(), one = Simd::Splat(1.0f);
+			const Simd::Float4 full = Simd::Splat(255.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 r = in[i + 0].simd, g = in[i + 1].simd;
+				Simd::Float4 b = in[i + 2].simd, a = in[i + 3].simd;
+				Simd::Transpose(r, g, b, a);
+
+				Detail::StoreColors4(out + i, {
+					Simd::Mul(Simd::Min(Simd::Max(r, zero), one), full), Simd::Mul(Simd::Min(Simd::Max(g, zero), one), full),
+					Simd::Mul(Simd::Min(Simd::Max(b, zero), one), full), Simd::Mul(Simd::Min(Simd::Max(a, zero), one), full) });
+			}
+			for (; i < count; i++) {
+				out[i] = Color::FromVector4(in[i]);
+			}
+		}
+	}
+}
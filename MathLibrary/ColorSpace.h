@@ -0,0 +1,334 @@
+#pragma once
+#include "Color.h"
+#include "Vector4.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace MathClasses
+{
+	/**
+	 * A colour as hue, saturation, value and alpha. Hue is in degrees in
+	 * [0, 360); the others are in [0, 1].
+	 */
+	struct HSV
+	{
+		float h, s, v, a;
+	};
+
+	static_assert(sizeof(HSV) == 16, "HSV must be four packed floats");
+
+	namespace Detail
+	{
+		/**
+		 * One channel of the HSV to RGB formula, with n = 5, 3, 1 for
+		 * r, g and b and the hue in sixths of a turn.
+		 */
+		inline float HsvChannel(float n, float sixths, float s, float v)
+		{
+			float k = n + sixths;
+			if (k >= 6.0f) { k -= 6.0f; }
+			float t = std::max(std::min(std::min(k, 4.0f - k), 1.0f), 0.0f);
+			return v - (v * s) * t;
+		}
+
+		struct HSV4
+		{
+			Simd::Float4 h, s, v;
+		};
+
+		inline Simd::Float4 EncodeSrgb4(Simd::Float4 linear)
+		{
+			const Simd::Float4 zero = Simd::Zero(), one = Simd::Splat(1.0f);
+			Simd::Float4 x = Simd::Min(Simd::Max(linear, zero), one);
+			Simd::Float4 s1 = Simd::Sqrt(x);
+			Simd::Float4 s2 = Simd::Sqrt(s1);
+			Simd::Float4 s3 = Simd::Sqrt(s2);
+			Simd::Float4 curve = Simd::Add(Simd::Mul(Simd::Splat(0.662002687f), s1), Simd::Mul(Simd::Splat(0.684122060f), s2));
+			curve = Simd::Sub(curve, Simd::Mul(Simd::Splat(0.323583601f), s3));
+			curve = Simd::Sub(curve, Simd::Mul(Simd::Splat(0.0225411470f), x));
+			Simd::Float4 encoded = Simd::Select(Simd::CmpLe(x, Simd::Splat(0.0031308f)), Simd::Mul(Simd::Splat(12.92f), x), curve);
+			return Simd::Mul(Simd::Min(Simd::Max(encoded, zero), one), Simd::Splat(255.0f));
+		}
+
+		/**
+		 * RGB channels in [0, 255], one colour per lane, to HSV.
+		 */
+		inline HSV4 RgbToHsv4(const ColorChannels4& c)
+		{
+			const Simd::Float4 zero = Simd::Zero();
+			Simd::Float4 max = Simd::Max(Simd::Max(c.r, c.g), c.b);
+			Simd::Float4 min = Simd::Min(Simd::Min(c.r, c.g), c.b);
+			Simd::Float4 delta = Simd::Sub(max, min);
+
+			// every branch is computed and the right one selected; lanes
+			// with zero delta divide by zero and are discarded
+			Simd::Float4 hr = Simd::Div(Simd::Sub(c.g, c.b), delta);
+			Simd::Float4 hg = Simd::Add(Simd::Div(Simd::Sub(c.b, c.r), delta), Simd::Splat(2.0f));
+			Simd::Float4 hb = Simd::Add(Simd::Div(Simd::Sub(c.r, c.g), delta), Simd::Splat(4.0f));
+			Simd::Float4 hue = Simd::Select(Simd::CmpEq(max, c.r), hr, Simd::Select(Simd::CmpEq(max, c.g), hg, hb));
+			hue = Simd::Mul(hue, Simd::Splat(60.0f));
+			hue = Simd::Select(Simd::CmpLt(hue, zero), Simd::Add(hue, Simd::Splat(360.0f)), hue);
+			hue = Simd::Select(Simd::CmpGt(delta, zero), hue, zero);
+
+			Simd::Float4 saturation = Simd::Select(Simd::CmpGt(max, zero), Simd::Div(delta, max), zero);
+			return { hue, saturation, Simd::Div(max, Simd::Splat(255.0f)) };
+		}
+
+		inline Simd::Float4 HsvChannel4(float n, const HSV4& hsv, Simd::Float4 sixths)
+		{
+			const Simd::Float4 six = Simd::Splat(6.0f);
+			Simd::Float4 k = Simd::Add(Simd::Splat(n), sixths);
+			k = Simd::Select(Simd::CmpGe(k, six), Simd::Sub(k, six), k);
+			Simd::Float4 t = Simd::Min(Simd::Min(k, Simd::Sub(Simd::Splat(4.0f), k)), Simd::Splat(1.0f));
+			t = Simd::Max(t, Simd::Zero());
+			Simd::Float4 channel = Simd::Sub(hsv.v, Simd::Mul(Simd::Mul(hsv.v, hsv.s), t));
+			return Simd::Mul(Simd::Min(Simd::Max(channel, Simd::Zero()), Simd::Splat(1.0f)), Simd::Splat(255.0f));
+		}
+
+		/**
+		 * HSV to RGB channels in [0, 255], ready for StoreColors4.
+		 */
+		inline ColorChannels4 HsvToRgb4(const HSV4& hsv, Simd::Float4 alpha)
+		{
+			Simd::Float4 sixths = Simd::Div(hsv.h, Simd::Splat(60.0f));
+			return { HsvChannel4(5.0f, hsv, sixths), HsvChannel4(3.0f, hsv, sixths), HsvChannel4(1.0f, hsv, sixths), alpha };
+		}
+	}
+
+	/*
+	 * Conversions between sRGB-encoded Colors and linear light, and between
+	 * RGB and HSV.
+	 *
+	 * Decoding sRGB reads a 256-entry table. Encoding uses a fit of the sRGB
+	 * curve built from three square roots, which stays within 0.25 of a
+	 * byte step of the exact curve and maps every decoded byte back to
+	 * itself. Each batch function gives the same bytes as its scalar
+	 * counterpart; the batch versions work on four colours per iteration.
+	 */
+	namespace ColorSpace
+	{
+		/**
+		 * Linear values of the 256 sRGB byte values, from the exact sRGB curve.
+		 */
+		inline const std::array<float, 256>& SrgbDecodeTable()
+		{
+			static const std::array<float, 256> table = [] {
+				std::array<float, 256> t = {};
+				for (int i = 0; i < 256; i++) {
+					double c = i / 255.0;
+					t[i] = (float)(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+				}
+				return t;
+			}();
+			return table;
+		}
+
+		inline float SrgbToLinear(uint8_t channel)
+		{
+			return SrgbDecodeTable()[channel];
+		}
+
+		/**
+		 * Encodes a linear value in [0, 1] on the sRGB curve, returning a
+		 * value in [0, 1]. Input outside the range is clamped.
+		 */
+		inline float LinearToSrgb(float linear)
+		{
+			float x = std::min(std::max(linear, 0.0f), 1.0f);
+			float s1 = std::sqrt(x);
+			float s2 = std::sqrt(s1);
+			float s3 = std::sqrt(s2);
+			float curve = ((0.662002687f * s1 + 0.684122060f * s2) - 0.323583601f * s3) - 0.0225411470f * x;
+			float encoded = x <= 0.0031308f ? 12.92f * x : curve;
+			return std::min(std::max(encoded, 0.0f), 1.0f);
+		}
+
+		/**
+		 * Decodes r, g and b to linear light. Alpha is not gamma encoded and
+		 * is only scaled to [0, 1].
+		 */
+		inline Vector4 SrgbToLinear(Color color)
+		{
+			return { SrgbToLinear(color.r), SrgbToLinear(color.g), SrgbToLinear(color.b), color.a / 255.0f };
+		}
+
+		inline Color LinearToSrgb(const Vector4& linear)
+		{
+			return {
+				(uint8_t)(LinearToSrgb(linear.x) * 255.0f + 0.5f),
+				(uint8_t)(LinearToSrgb(linear.y) * 255.0f + 0.5f),
+				(uint8_t)(LinearToSrgb(linear.z) * 255.0f + 0.5f),
+				Color::ToByte(linear.w)
+			};
+		}
+
+		inline HSV RgbToHsv(Color color)
+		{
+			float r = color.r, g = color.g, b = color.b;
+			float max = std::max(std::max(r, g), b);
+			float min = std::min(std::min(r, g), b);
+			float delta = max - min;
+
+			float hue = 0;
+			if (delta > 0) {
+				if (max == r) { hue = (g - b) / delta; }
+				else if (max == g) { hue = (b - r) / delta + 2.0f; }
+				else { hue = (r - g) / delta + 4.0f; }
+				hue *= 60.0f;
+				if (hue < 0) { hue += 360.0f; }
+			}
+			return { hue, max > 0 ? delta / max : 0.0f, max / 255.0f, color.a / 255.0f };
+		}
+
+		/**
+		 * Converts to RGB. Hue must be in [0, 360).
+		 */
+		inline Color HsvToRgb(const HSV& hsv)
+		{
+			float sixths = hsv.h / 60.0f;
+			return {
+				Color::ToByte(Detail::HsvChannel(5.0f, sixths, hsv.s, hsv.v)),
+				Color::ToByte(Detail::HsvChannel(3.0f, sixths, hsv.s, hsv.v)),
+				Color::ToByte(Detail::HsvChannel(1.0f, sixths, hsv.s, hsv.v)),
+				Color::ToByte(hsv.a)
+			};
+		}
+
+		/**
+		 * out[i] = SrgbToLinear(in[i])
+		 */
+		inline void SrgbToLinear(const Color* in, Vector4* out, size_t count)
+		{
+			const float* table = SrgbDecodeTable().data();
+			for (size_t i = 0; i < count; i++) {
+				out[i] = { table[in[i].r], table[in[i].g], table[in[i].b], in[i].a / 255.0f };
+			}
+		}
+
+		/**
+		 * out[i] = LinearToSrgb(in[i])
+		 */
+		inline void LinearToSrgb(const Vector4* in, Color* out, size_t count)
+		{
+			const Simd::Float4 zero = Simd::Zero(), one = Simd::Splat(1.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 r = in[i + 0].simd, g = in[i + 1].simd;
+				Simd::Float4 b = in[i + 2].simd, a = in[i + 3].simd;
+				Simd::Transpose(r, g, b, a);
+
+				Detail::StoreColors4(out + i, {
+					Detail::EncodeSrgb4(r), Detail::EncodeSrgb4(g), Detail::EncodeSrgb4(b),
+					Simd::Mul(Simd::Min(Simd::Max(a, zero), one), Simd::Splat(255.0f)) });
+			}
+			for (; i < count; i++) {
+				out[i] = LinearToSrgb(in[i]);
+			}
+		}
+
+		/**
+		 * Interpolates between sRGB colours in linear light, so fades keep
+		 * their brightness instead of dipping through darker midtones.
+		 * Alpha is interpolated directly.
+		 */
+		inline void LerpLinear(const Color* start, const Color* end, float t, Color* out, size_t count)
+		{
+			const float* table = SrgbDecodeTable().data();
+			Vector4 linear[4];
+
+			for (size_t i = 0; i < count; i += 4) {
+				size_t batch = std::min<size_t>(4, count - i);
+				for (size_t j = 0; j < batch; j++) {
+					Vector4 s = { table[start[i + j].r], table[start[i + j].g], table[start[i + j].b], start[i + j].a / 255.0f };
+					Vector4 e = { table[end[i + j].r], table[end[i + j].g], table[end[i + j].b], end[i + j].a / 255.0f };
+					linear[j] = s + (e - s) * t;
+				}
+				LinearToSrgb(linear, out + i, batch);
+			}
+		}
+
+		/**
+		 * out[i] = RgbToHsv(in[i])
+		 */
+		inline void RgbToHsv(const Color* in, HSV* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 c = Detail::LoadColors4(in + i);
+				Detail::HSV4 hsv = Detail::RgbToHsv4(c);
+				Simd::Float4 h = hsv.h, s = hsv.s, v = hsv.v;
+				Simd::Float4 a = Simd::Div(c.a, Simd::Splat(255.0f));
+
+				Simd::Transpose(h, s, v, a);
+				Simd::StoreUnaligned(&out[i + 0].h, h);
+				Simd::StoreUnaligned(&out[i + 1].h, s);
+				Simd::StoreUnaligned(&out[i + 2].h, v);
+				Simd::StoreUnaligned(&out[i + 3].h, a);
+			}
+			for (; i < count; i++) {
+				out[i] = RgbToHsv(in[i]);
+			}
+		}
+
+		/**
+		 * out[i] = HsvToRgb(in[i]). Hues must be in [0, 360).
+		 */
+		inline void HsvToRgb(const HSV* in, Color* out, size_t count)
+		{
+			const Simd::Float4 zero = Simd::Zero(), one = Simd::Splat(1.0f);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 h = Simd::LoadUnaligned(&in[i + 0].h), s = Simd::LoadUnaligned(&in[i + 1].h);
+				Simd::Float4 v = Simd::LoadUnaligned(&in[i + 2].h), a = Simd::LoadUnaligned(&in[i + 3].h);
+				Simd::Transpose(h, s, v, a);
+
+				a = Simd::Mul(Simd::Min(Simd::Max(a, zero), one), Simd::Splat(255.0f));
+				Detail::StoreColors4(out + i, Detail::HsvToRgb4({ h, s, v }, a));
+			}
+			for (; i < count; i++) {
+				out[i] = HsvToRgb(in[i]);
+			}
+		}
+
+		/**
+		 * Rotates the hue of every colour, keeping saturation, value and
+		 * alpha, without writing out the intermediate HSV values.
+		 *
+		 * @param in The colours to shift.
+		 * @param degrees The rotation, which may be any size or sign.
+		 * @param out Destination for the shifted colours, holding at least count colours.
+		 * @param count The number of colours.
+		 */
+		inline void ShiftHue(const Color* in, float degrees, Color* out, size_t count)
+		{
+			float shift = std::fmod(degrees, 360.0f);
+			if (shift < 0) { shift += 360.0f; }
+
+			auto wrap = [](float hue) { return hue >= 360.0f ? hue - 360.0f : hue; };
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Detail::ColorChannels4 c = Detail::LoadColors4(in + i);
+				Detail::HSV4 hsv = Detail::RgbToHsv4(c);
+				const Simd::Float4 full = Simd::Splat(360.0f);
+				hsv.h = Simd::Add(hsv.h, Simd::Splat(shift));
+				hsv.h = Simd::Select(Simd::CmpGe(hsv.h, full), Simd::Sub(hsv.h, full), hsv.h);
+				Detail::StoreColors4(out + i, Detail::HsvToRgb4(hsv, c.a));
+			}
+			for (; i < count; i++) {
+				HSV hsv = RgbToHsv(in[i]);
+				hsv.h = wrap(hsv.h + shift);
+				Color shifted = HsvToRgb(hsv);
+				shifted.a = in[i].a;
+				out[i] = shifted;
+			}
+		}
+	}
+}
@@ -0,0 +1,289 @@
+#pragma once
+#include "VectorN.h"
+#include "Simd.h"
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MathClasses
+{
+	/**
+	 * A Q16.16 fixed-point number: a signed 32-bit integer counting 1/65536ths.
+	 *
+	 * Every operation is integer arithmetic with fixed rounding, so results
+	 * are bit-identical across compilers, optimisation flags and CPUs. Use
+	 * it for lockstep simulation, where replays must match exactly.
+	 *
+	 * The range is [-32768, 32768) with a step of about 1.5e-5. Addition and
+	 * subtraction wrap on overflow, products round to nearest (ties up) and
+	 * quotients truncate toward zero. Dividing by zero saturates.
+	 *
+	 * Integers convert implicitly and exactly. Floats only convert
+	 * explicitly, so float math cannot leak into a simulation unnoticed.
+	 */
+	struct Fixed32
+	{
+		static constexpr int FractionBits = 16;
+		static constexpr int32_t One = 1 << FractionBits;
+
+		int32_t raw;
+
+		Fixed32() = default;
+
+		template<std::integral I>
+		constexpr Fixed32(I value) : raw((int32_t)((uint32_t)value << FractionBits)) {}
+
+		/**
+		 * Rounds a float to the nearest Q16.16 value, saturating outside the range.
+		 */
+		explicit constexpr Fixed32(float value) : Fixed32((double)value) {}
+
+		explicit constexpr Fixed32(double value) : raw(FromDouble(value)) {}
+
+		static constexpr Fixed32 FromRaw(int32_t inRaw) {
+			Fixed32 f = 0;
+			f.raw = inRaw;
+			return f;
+		}
+
+		constexpr float ToFloat() const { return (float)raw / (float)One; }
+		constexpr double ToDouble() const { return (double)raw / (double)One; }
+		explicit constexpr operator float() const { return ToFloat(); }
+		explicit constexpr operator double() const { return ToDouble(); }
+
+		constexpr Fixed32 operator +(Fixed32 rhs) const {
+			return FromRaw((int32_t)((uint32_t)raw + (uint32_t)rhs.raw));
+		}
+		constexpr Fixed32 operator -(Fixed32 rhs) const {
+			return FromRaw((int32_t)((uint32_t)raw - (uint32_t)rhs.raw));
+		}
+		constexpr Fixed32 operator *(Fixed32 rhs) const {
+			return FromRaw((int32_t)((((int64_t)raw * rhs.raw) + (One / 2)) >> FractionBits));
+		}
+		constexpr Fixed32 operator /(Fixed32 rhs) const {
+			if (rhs.raw == 0) {
+				return FromRaw(raw >= 0 ? INT32_MAX : INT32_MIN);
+			}
+			return FromRaw((int32_t)(((int64_t)raw * One) / rhs.raw));
+		}
+		constexpr Fixed32 operator -() const {
+			return FromRaw((int32_t)(0u - (uint32_t)raw));
+		}
+
+		constexpr Fixed32& operator +=(Fixed32 rhs) { return *this = *this + rhs; }
+		constexpr Fixed32& operator -=(Fixed32 rhs) { return *this = *this - rhs; }
+		constexpr Fixed32& operator *=(Fixed32 rhs) { return *this = *this * rhs; }
+		constexpr Fixed32& operator /=(Fixed32 rhs) { return *this = *this / rhs; }
+
+		constexpr bool operator ==(const Fixed32& rhs) const = default;
+		constexpr auto operator <=>(const Fixed32& rhs) const = default;
+
+		std::string ToString() const {
+			return std::to_string(ToDouble());
+		}
+
+	private:
+		static constexpr int32_t FromDouble(double value) {
+			double scaled = value * One;
+			if (scaled >= 2147483647.0) { return INT32_MAX; }
+			if (scaled <= -2147483648.0) { return INT32_MIN; }
+			return (int32_t)(scaled + (scaled >= 0 ? 0.5 : -0.5));
+		}
+	};
+
+	static_assert(sizeof(Fixed32) == 4, "Fixed32 must be stored as one 32-bit integer");
+
+	namespace FixedConstants
+	{
+		inline constexpr Fixed32 Pi = Fixed32::FromRaw(205887);
+		inline constexpr Fixed32 HalfPi = Fixed32::FromRaw(102944);
+		inline constexpr Fixed32 TwoPi = Fixed32::FromRaw(411775);
+	}
+
+	/**
+	 * Returns the square root, rounded down to the Q16.16 step. Negative
+	 * input returns zero.
+	 */
+	constexpr Fixed32 Sqrt(Fixed32 value)
+	{
+		if (value.raw <= 0) {
+			return 0;
+		}
+
+		// integer square root of raw * 2^16, one result bit per step
+		uint64_t remainder = (uint64_t)value.raw << Fixed32::FractionBits;
+		uint64_t result = 0;
+		uint64_t bit = (uint64_t)1 << 62;
+		while (bit > remainder) {
+			bit >>= 2;
+		}
+		while (bit != 0) {
+			if (remainder >= result + bit) {
+				remainder -= result + bit;
+				result = (result >> 1) + bit;
+			}
+			else {
+				result >>= 1;
+			}
+			bit >>= 2;
+		}
+		return Fixed32::FromRaw((int32_t)result);
+	}
+
+	namespace Detail
+	{
+		/**
+		 * Entries per full turn in the fixed-point sine table.
+		 */
+		constexpr int32_t SinTableSteps = 1024;
+
+		constexpr double SinSeries(double x)
+		{
+			double term = x, sum = x;
+			for (int n = 1; n < 12; n++) {
+				term *= -(x * x) / ((2.0 * n) * (2.0 * n + 1.0));
+				sum += term;
+			}
+			return sum;
+		}
+
+		/**
+		 * sin over the first quarter turn in Q16.16, built at compile time.
+		 * The series is accurate far beyond the 16 stored bits, so every
+		 * compiler rounds it to the same table; a test checks its checksum.
+		 */
+		constexpr std::array<int32_t, SinTableSteps / 4 + 1> MakeSinQuarterTable()
+		{
+			std::array<int32_t, SinTableSteps / 4 + 1> table = {};
+			for (int32_t i = 0; i <= SinTableSteps / 4; i++) {
+				double angle = i * (3.14159265358979323846 * 2.0 / SinTableSteps);
+				table[i] = (int32_t)(SinSeries(angle) * Fixed32::One + 0.5);
+			}
+			return table;
+		}
+
+		inline constexpr std::array<int32_t, SinTableSteps / 4 + 1> SinQuarterTable = MakeSinQuarterTable();
+
+		constexpr int32_t SinTableLookup(int32_t step)
+		{
+			constexpr int32_t quarter = SinTableSteps / 4;
+			int32_t k = step & (quarter - 1);
+			switch ((step / quarter) & 3) {
+			case 0: return SinQuarterTable[k];
+			case 1: return SinQuarterTable[quarter - k];
+			case 2: return -SinQuarterTable[k];
+			default: return -SinQuarterTable[quarter - k];
+			}
+		}
+
+		/**
+		 * Linearly interpolates the table at an angle measured in table
+		 * steps, in Q16.16. The error is below one Q16.16 step.
+		 */
+		constexpr int32_t SinTableInterpolate(int64_t steps)
+		{
+			int32_t step = (int32_t)((steps >> Fixed32::FractionBits) & (SinTableSteps - 1));
+			int64_t fraction = steps & (Fixed32::One - 1);
+			int32_t s0 = SinTableLookup(step);
+			int32_t s1 = SinTableLookup((step + 1) & (SinTableSteps - 1));
+			return s0 + (int32_t)((((int64_t)(s1 - s0) * fraction) + (Fixed32::One / 2)) >> Fixed32::FractionBits);
+		}
+
+		/**
+		 * Converts radians to table steps in Q16.16.
+		 */
+		constexpr int64_t RadiansToSinTableSteps(Fixed32 angle)
+		{
+			// SinTableSteps / (2 * pi) in Q16.16
+			constexpr int64_t stepsPerRadian = 10680708;
+			return ((int64_t)angle.raw * stepsPerRadian) >> Fixed32::FractionBits;
+		}
+	}
+
+	/**
+	 * Writes the sine and cosine of an angle in radians, from a 1024-step
+	 * table with linear interpolation. Bit-identical on every platform.
+	 */
+	constexpr void SinCos(Fixed32 angle, Fixed32& outSin, Fixed32& outCos)
+	{
+		int64_t steps = Detail::RadiansToSinTableSteps(angle);
+		outSin = Fixed32::FromRaw(Detail::SinTableInterpolate(steps));
+		outCos = Fixed32::FromRaw(Detail::SinTableInterpolate(steps + ((int64_t)Detail::SinTableSteps / 4) * Fixed32::One));
+	}
+
+	constexpr Fixed32 Sin(Fixed32 angle)
+	{
+		return Fixed32::FromRaw(Detail::SinTableInterpolate(Detail::RadiansToSinTableSteps(angle)));
+	}
+
+	constexpr Fixed32 Cos(Fixed32 angle)
+	{
+		Fixed32 s = 0, c = 0;
+		SinCos(angle, s, c);
+		return c;
+	}
+
+	/**
+	 * A 2D fixed-point vector for lockstep simulation. See VectorN for its
+	 * operations; lengths use the integer Sqrt above. MagnitudeSqr overflows
+	 * for vectors longer than about 181, so normalise short vectors such as
+	 * directions and velocities.
+	 */
+	using Vector2fx = VectorN<Fixed32, 2>;
+
+	/*
+	 * Kernels over arrays of Fixed32, four lanes per iteration. Results are
+	 * bit-identical to the scalar operators, and outputs may alias inputs.
+	 */
+	namespace FixedKernels
+	{
+		/**
+		 * out[i] = a[i] + b[i]
+		 */
+		inline void Add(const Fixed32* a, const Fixed32* b, Fixed32* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::StoreUnaligned(&out[i].raw, Simd::Add(Simd::LoadUnaligned(&a[i].raw), Simd::LoadUnaligned(&b[i].raw)));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		/**
+		 * out[i] = a[i] * b[i]
+		 */
+		inline void Mul(const Fixed32* a, const Fixed32* b, Fixed32* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::StoreUnaligned(&out[i].raw, Simd::MulQ16(Simd::LoadUnaligned(&a[i].raw), Simd::LoadUnaligned(&b[i].raw)));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		/**
+		 * out[i] = a[i] + b[i] * scalar, such as integrating positions by
+		 * velocity over a fixed time step.
+		 */
+		inline void AddScaled(const Fixed32* a, const Fixed32* b, Fixed32 scalar, Fixed32* out, size_t count)
+		{
+			const Simd::Int4 s = Simd::SplatInt(scalar.raw);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Int4 scaled = Simd::MulQ16(Simd::LoadUnaligned(&b[i].raw), s);
+				Simd::StoreUnaligned(&out[i].raw, Simd::Add(Simd::LoadUnaligned(&a[i].raw), scaled));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] + b[i] * scalar;
+			}
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+
+namespace MathClasses
+{
+	/**
+	 * An IEEE 754 half-precision float, used to store vectors in half the
+	 * memory of float.
+	 *
+	 * Half converts to and from float implicitly, so arithmetic on it is
+	 * carried out in float and rounded back to half when stored. Like
+	 * float, a default-constructed Half is uninitialised.
+	 */
+	struct Half
+	{
+		uint16_t bits;
+
+		Half() = default;
+		constexpr Half(float value) : bits(FromFloat(value)) {}
+
+		constexpr operator float() const { return ToFloat(bits); }
+
+		/**
+		 * Returns the Half with the given bit pattern.
+		 */
+		static constexpr Half FromBits(uint16_t inBits) {
+			Half h = 0.0f;
+			h.bits = inBits;
+			return h;
+		}
+
+		/**
+		 * Converts a float to the bit pattern of the nearest Half, rounding
+		 * ties to even. Values too large for a Half become infinity and NaNs
+		 * stay NaN.
+		 */
+		static constexpr uint16_t FromFloat(float value) {
+			uint32_t f = std::bit_cast<uint32_t>(value);
+			uint32_t sign = (f >> 16) & 0x8000u;
+			uint32_t magnitude = f & 0x7FFFFFFFu;
+
+			if (magnitude >= 0x7F800000u) {
+				// infinity, or a NaN kept quiet
+				return (uint16_t)(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x200u : 0));
+			}
+			if (magnitude >= 0x477FF000u) {
+				// 65520 and above round past the largest Half
+				return (uint16_t)(sign | 0x7C00u);
+			}
+			if (magnitude < 0x38800000u) {
+				// below the smallest normal Half: adding 0.5 lines the Half
+				// subnormal step up with the float's last bit, so the FPU
+				// does the rounding
+				float shifted = std::bit_cast<float>(magnitude) + 0.5f;
+				return (uint16_t)(sign | (std::bit_cast<uint32_t>(shifted) - 0x3F000000u));
+			}
+
+			// rebias the exponent from 127 to 15, then round the 13 dropped
+			// mantissa bits to nearest even
+			uint32_t odd = (magnitude >> 13) & 1u;
+			magnitude += 0xC8000FFFu + odd;
+			return (uint16_t)(sign | (magnitude >> 13));
+		}
+
+		/**
+		 * Converts the bit pattern of a Half to float. Every Half is exactly
+		 * representable as a float.
+		 */
+		static constexpr float ToFloat(uint16_t h) {
+			uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+			uint32_t exponent = (h >> 10) & 0x1Fu;
+			uint32_t mantissa = h & 0x3FFu;
+
+			if (exponent == 0) {
+				// zero or subnormal: mantissa * 2^-24
+				float value = (float)mantissa * 5.9604644775390625e-8f;
+				return sign != 0 ? -value : value;
+			}
+			if (exponent == 31) {
+				return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+			}
+			return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+		}
+	};
+
+	static_assert(sizeof(Half) == 2, "Half must be stored in 16 bits");
+}
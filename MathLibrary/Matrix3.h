@@ -1,6 +1,13 @@
 #pragma once
 #include "Vector2.h"
 #include "Vector3.h"
+#include "VectorStream.h"
+#include "Simd.h"
+
+#include <cassert>
+
+#include <cstddef>
+#include <string>
 
 namespace MathClasses
 {
@@ -21,11 +28,10 @@ namespace MathClasses
 		/**
 		 * Initializes all members to zero
 		 */
-		Matrix3();
+		constexpr Matrix3() : Matrix3(0, 0, 0, 0, 0, 0, 0, 0, 0) {}
 
-		Matrix3(float inM1, float inM2, float inM3, float inM4, float inM5, float inM6, float inM7, float inM8, float inM9) {
-			m1 = inM1; m2 = inM2; m3 = inM3; m4 = inM4; m5 = inM5; m6 = inM6; m7 = inM7; m8 = inM8; m9 = inM9;
-		}
+		constexpr Matrix3(float inM1, float inM2, float inM3, float inM4, float inM5, float inM6, float inM7, float inM8, float inM9)
+			: m1(inM1), m2(inM2), m3(inM3), m4(inM4), m5(inM5), m6(inM6), m7(inM7), m8(inM8), m9(inM9) {}
 
 		Matrix3(float* inArr) {
 			for (int i = 0; i < 9; i++) {
@@ -33,11 +39,11 @@ namespace MathClasses
 			}
 		}
 
-		static Matrix3 MakeIdentity() {
+		static constexpr Matrix3 MakeIdentity() {
 			return { 1.0f,0,0,0,1.0f,0,0,0,1.0f };
 		}
 
-		Matrix3 operator *(Matrix3 rhs) const {
+		constexpr Matrix3 operator *(Matrix3 rhs) const {
 			Matrix3 temp = *this;
 			Vector3 r1 = { m1,m4,m7 };
 			Vector3 r2 = { m2,m5,m8 };
@@ -60,7 +66,10 @@ namespace MathClasses
 		 * @param rhs The other Matrix.
 		 * @return The reference to this Matrix after multiplication.
 		 */
-		Matrix3& operator *=(Matrix3 rhs);
+		constexpr Matrix3& operator *=(Matrix3 rhs) {
+			*this = *this * rhs;
+			return *this;
+		}
 
 		/**
 		 * Multiplies this matrix against the given Vector3, treating it like
@@ -69,7 +78,13 @@ namespace MathClasses
 		 * @param rhs The vector
 		 * @return The product of multiplying the 3x3 by a 3x1
 		 */
-		Vector3 operator *(Vector3 rhs) const;
+		constexpr Vector3 operator *(Vector3 rhs) const {
+			return {
+				(m1 * rhs.x) + (m4 * rhs.y) + (m7 * rhs.z),
+				(m2 * rhs.x) + (m5 * rhs.y) + (m8 * rhs.z),
+				(m3 * rhs.x) + (m6 * rhs.y) + (m9 * rhs.z)
+			};
+		}
 
 		/**
 		 * Multiplies this matrix against the given Vector2, treating it like
@@ -79,7 +94,192 @@ namespace MathClasses
 		 * @return The product of multiplying the 3x3 by a 3x1, then truncating
 		 *		   it to a 2x1.
 		 */
-		Vector2 operator *(Vector2 rhs) const;
+		constexpr Vector2 operator *(Vector2 rhs) const {
+			return {
+				(m1 * rhs.x) + (m4 * rhs.y) + m7,
+				(m2 * rhs.x) + (m5 * rhs.y) + m8
+			};
+		}
+
+		/**
+		 * Transforms an array of points, treating each like a 3x1 matrix
+		 * whose third element is 1.0, exactly as operator*(Vector2) does.
+		 *
+		 * The matrix is held in registers for the whole call and four points
+		 * are transformed per iteration. The output may be the same array as
+		 * the input.
+		 *
+		 * @param in The points to transform.
+		 * @param out Destination for the transformed points, holding at least count points.
+		 * @param count The number of points.
+		 */
+		void TransformPoints(const Vector2* in, Vector2* out, size_t count) const {
+			// Each register holds two points (x0, y0, x1, y1), so the columns
+			// are laid out twice to line up with them.
+			const Simd::Float4 col0 = Simd::Set(m1, m2, m1, m2);
+			const Simd::Float4 col1 = Simd::Set(m4, m5, m4, m5);
+			const Simd::Float4 col2 = Simd::Set(m7, m8, m7, m8);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 a = Simd::LoadUnaligned(&in[i].x);
+				Simd::Float4 b = Simd::LoadUnaligned(&in[i + 2].x);
+
+				Simd::Float4 ra = Simd::MulAdd(col0, Simd::DuplicateEven(a), Simd::MulAdd(col1, Simd::DuplicateOdd(a), col2));
+				Simd::Float4 rb = Simd::MulAdd(col0, Simd::DuplicateEven(b), Simd::MulAdd(col1, Simd::DuplicateOdd(b), col2));
+
+				Simd::StoreUnaligned(&out[i].x, ra);
+				Simd::StoreUnaligned(&out[i + 2].x, rb);
+			}
+			for (; i < count; i++) {
+				out[i] = *this * in[i];
+			}
+		}
+
+		/**
+		 * Transforms points stored inside a larger interleaved structure,
+		 * such as a vertex buffer where each vertex also carries texture
+		 * coordinates or colour.
+		 *
+		 * @param in Pointer to the X component of the first input point. Y must follow X.
+		 * @param inStride Distance in bytes between consecutive input points.
+		 * @param out Pointer to the X component of the first output point.
+		 * @param outStride Distance in bytes between consecutive output points.
+		 * @param count The number of points.
+		 */
+		void TransformPoints(const float* in, size_t inStride, float* out, size_t outStride, size_t count) const {
+			const Simd::Float4 c0x = Simd::Splat(m1), c0y = Simd::Splat(m2);
+			const Simd::Float4 c1x = Simd::Splat(m4), c1y = Simd::Splat(m5);
+			const Simd::Float4 c2x = Simd::Splat(m7), c2y = Simd::Splat(m8);
+
+			const char* src = reinterpret_cast<const char*>(in);
+			char* dst = reinterpret_cast<char*>(out);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const float* p0 = reinterpret_cast<const float*>(src + (inStride * (i + 0)));
+				const float* p1 = reinterpret_cast<const float*>(src + (inStride * (i + 1)));
+				const float* p2 = reinterpret_cast<const float*>(src + (inStride * (i + 2)));
+				const float* p3 = reinterpret_cast<const float*>(src + (inStride * (i + 3)));
+
+				// gather four points into an X register and a Y register
+				Simd::Float4 x = Simd::Set(p0[0], p1[0], p2[0], p3[0]);
+				Simd::Float4 y = Simd::Set(p0[1], p1[1], p2[1], p3[1]);
+
+				alignas(16) float rx[4];
+				alignas(16) float ry[4];
+				Simd::Store(rx, Simd::MulAdd(c0x, x, Simd::MulAdd(c1x, y, c2x)));
+				Simd::Store(ry, Simd::MulAdd(c0y, x, Simd::MulAdd(c1y, y, c2y)));
+
+				for (size_t j = 0; j < 4; j++) {
+					float* q = reinterpret_cast<float*>(dst + (outStride * (i + j)));
+					q[0] = rx[j];
+					q[1] = ry[j];
+				}
+			}
+			for (; i < count; i++) {
+				const float* p = reinterpret_cast<const float*>(src + (inStride * i));
+				float* q = reinterpret_cast<float*>(dst + (outStride * i));
+				Vector2 result = *this * Vector2(p[0], p[1]);
+				q[0] = result.x;
+				q[1] = result.y;
+			}
+		}
+
+		/**
+		 * Returns the determinant of this matrix.
+		 *
+		 * @return The determinant, which is zero if the matrix has no inverse.
+		 */
+		float Determinant() const {
+			return (m1 * ((m5 * m9) - (m8 * m6))) - (m4 * ((m2 * m9) - (m8 * m3))) + (m7 * ((m2 * m6) - (m5 * m3)));
+		}
+
+		/**
+		 * Returns the inverse of this matrix.
+		 *
+		 * The rows of the inverse are the cross products of pairs of columns
+		 * divided by the determinant, computed in SIMD registers.
+		 *
+		 * @return The inverse, or a zero matrix if the determinant is zero.
+		 */
+		Matrix3 Inverted() const {
+			Simd::Float4 c0 = Simd::Set(m1, m2, m3, 0);
+			Simd::Float4 c1 = Simd::Set(m4, m5, m6, 0);
+			Simd::Float4 c2 = Simd::Set(m7, m8, m9, 0);
+
+			Simd::Float4 r0 = Simd::Cross3(c1, c2);
+			Simd::Float4 r1 = Simd::Cross3(c2, c0);
+			Simd::Float4 r2 = Simd::Cross3(c0, c1);
+			Simd::Float4 det = Simd::Dot4(c0, r0);
+			if (Simd::GetX(det) == 0) {
+				return Matrix3();
+			}
+
+			Simd::Float4 invDet = Simd::Div(Simd::Splat(1.0f), det);
+			r0 = Simd::Mul(r0, invDet);
+			r1 = Simd::Mul(r1, invDet);
+			r2 = Simd::Mul(r2, invDet);
+			Simd::Float4 r3 = Simd::Zero();
+			Simd::Transpose(r0, r1, r2, r3);
+
+			alignas(16) float cols[12];
+			Simd::Store(cols, r0);
+			Simd::Store(cols + 4, r1);
+			Simd::Store(cols + 8, r2);
+			return { cols[0], cols[1], cols[2], cols[4], cols[5], cols[6], cols[8], cols[9], cols[10] };
+		}
+
+		/**
+		 * Returns the inverse of a 2D transform made of a translation,
+		 * rotation and scale, as built by MakeTranslation, MakeRotateZ and
+		 * MakeScale for use with 2-D math.
+		 *
+		 * The axes are transposed into rows, each divided by its squared
+		 * length to undo scale, and the translation is rotated back and
+		 * negated. No cofactor expansion is needed. Matrices with shear or
+		 * a projective third row need Inverted() instead.
+		 *
+		 * @return The inverse transform.
+		 */
+		Matrix3 AffineInverted() const {
+			float invX = 1.0f / ((m1 * m1) + (m2 * m2));
+			float invY = 1.0f / ((m4 * m4) + (m5 * m5));
+			float c0x = m1 * invX, c0y = m4 * invY;
+			float c1x = m2 * invX, c1y = m5 * invY;
+			return {
+				c0x, c0y, 0,
+				c1x, c1y, 0,
+				-((c0x * m7) + (c1x * m8)), -((c0y * m7) + (c1y * m8)), 1.0f
+			};
+		}
+
+		/**
+		 * Inverts an array of matrices. See Inverted().
+		 *
+		 * @param in The matrices to invert.
+		 * @param out Destination for the inverses. May be the same array as in.
+		 * @param count The number of matrices.
+		 */
+		static void Invert(const Matrix3* in, Matrix3* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = in[i].Inverted();
+			}
+		}
+
+		/**
+		 * Inverts an array of 2D translation, rotation and scale transforms.
+		 * See AffineInverted().
+		 *
+		 * @param in The matrices to invert.
+		 * @param out Destination for the inverses. May be the same array as in.
+		 * @param count The number of matrices.
+		 */
+		static void AffineInvert(const Matrix3* in, Matrix3* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = in[i].AffineInverted();
+			}
+		}
 
 		/**
 		 * Returns true if every component is exactly equal to the other.
@@ -89,7 +289,11 @@ namespace MathClasses
 		 * @param rhs The other Matrix.
 		 * @return True if equal, otherwise false.
 		 */
-		bool operator == (const Matrix3& rhs) const;
+		constexpr bool operator == (const Matrix3& rhs) const {
+			return m1 == rhs.m1 && m2 == rhs.m2 && m3 == rhs.m3 &&
+				   m4 == rhs.m4 && m5 == rhs.m5 && m6 == rhs.m6 &&
+				   m7 == rhs.m7 && m8 == rhs.m8 && m9 == rhs.m9;
+		}
 
 		/**
 		 * Returns true if any component is not exactly equal to the other.
@@ -97,7 +301,9 @@ namespace MathClasses
 		 * @param rhs The other Matrix.
 		 * @return True if equal, otherwise false.
 		 */
-		bool operator != (const Matrix3& rhs) const;
+		constexpr bool operator != (const Matrix3& rhs) const {
+			return !(*this == rhs);
+		}
 
 		/**
 		 * Returns true if every component is approximately equal to the other.
@@ -105,14 +311,21 @@ namespace MathClasses
 		 * @param rhs The other Matrix.
 		 * @return True if equal, otherwise false.
 		 */
-		bool Equals(const Matrix3& rhs, float Tolerance = MAX_FLOAT_DELTA) const;
+		bool Equals(const Matrix3& rhs, float Tolerance = MAX_FLOAT_DELTA) const {
+			for (int i = 0; i < 9; i++) {
+				if (std::abs(v[i] - rhs.v[i]) >= Tolerance) { return false; }
+			}
+			return true;
+		}
 
 		/**
 		 * Returns this as a formatted string.
 		 *
 		 * @return A comma separated Vector with its components.
 		 */
-		std::string ToString() const;
+		std::string ToString() const {
+			return "[" + axis[0].ToString() + "], [" + axis[1].ToString() + "], [" + axis[2].ToString() + "]";
+		}
 
 		/**
 		 * Transform Factory Functions
@@ -133,7 +346,9 @@ namespace MathClasses
 
 		  * @return The translation matrix.
 		  */
-		static Matrix3 MakeTranslation(float x, float y);
+		static constexpr Matrix3 MakeTranslation(float x, float y) {
+			return { 1.0f, 0, 0, 0, 1.0f, 0, x, y, 1.0f };
+		}
 
 		/**
 		 * Creates a translation matrix that translates on the given X and Y
@@ -144,7 +359,9 @@ namespace MathClasses
 		 * @param vec A Vector containing the amount to translate by on the X, Y, and Z axes.
 		 * @return The translation matrix.
 		 */
-		static Matrix3 MakeTranslation(Vector2 vec);
+		static constexpr Matrix3 MakeTranslation(Vector2 vec) {
+			return MakeTranslation(vec.x, vec.y);
+		}
 
 		/**
 		 * Creates a translation matrix that translates on the given X, Y, and
@@ -157,7 +374,9 @@ namespace MathClasses
 		 * @param z Amount to translate by on the Z-axis.
 		 * @return The translation matrix.
 		 */
-		static Matrix3 MakeTranslation(float x, float y, float z);
+		static constexpr Matrix3 MakeTranslation(float x, float y, float z) {
+			return { 1.0f, 0, 0, 0, 1.0f, 0, x, y, z };
+		}
 
 		/**
 		 * Creates a translation matrix that translates on the given X, Y, and
@@ -168,7 +387,9 @@ namespace MathClasses
 		 * @param vec A Vector containing the amount to translate by on the X, Y, and Z axes.
 		 * @return The translation matrix.
 		 */
-		static Matrix3 MakeTranslation(Vector3 vec);
+		static constexpr Matrix3 MakeTranslation(Vector3 vec) {
+			return MakeTranslation(vec.x, vec.y, vec.z);
+		}
 
 		/**
 		 * Creates a rotation matrix that rotates around the X-axis
@@ -176,7 +397,12 @@ namespace MathClasses
 		 * @param Rotation around the X-axis, expressed in radians.
 		 * @return The rotation matrix.
 		 */
-		static Matrix3 MakeRotateX(float a);
+		template<Precision P = DefaultPrecision>
+		static Matrix3 MakeRotateX(float a) {
+			float s, c;
+			SinCos<P>(a, s, c);
+			return { 1.0f, 0, 0, 0, c, s, 0, -s, c };
+		}
 
 		/**
 		 * Creates a rotation matrix that rotates around the Y-axis
@@ -184,7 +410,12 @@ namespace MathClasses
 		 * @param Rotation around the Y-axis, expressed in radians.
 		 * @return The rotation matrix.
 		 */
-		static Matrix3 MakeRotateY(float a);
+		template<Precision P = DefaultPrecision>
+		static Matrix3 MakeRotateY(float a) {
+			float s, c;
+			SinCos<P>(a, s, c);
+			return { c, 0, -s, 0, 1.0f, 0, s, 0, c };
+		}
 
 		/**
 		 * Creates a rotation matrix that rotates around the Z-axis
@@ -192,19 +423,40 @@ namespace MathClasses
 		 * @param Rotation around the Z-axis, expressed in radians.
 		 * @return The rotation matrix.
 		 */
-		static Matrix3 MakeRotateZ(float a);
+		template<Precision P = DefaultPrecision>
+		static Matrix3 MakeRotateZ(float a) {
+			float s, c;
+			SinCos<P>(a, s, c);
+			return { c, s, 0, -s, c, 0, 0, 0, 1.0f };
+		}
 
 		/**
 		 * Creates a rotation matrix that applies a pitch, yaw, roll rotation
 		 *
-		 * Combined in a pitch, then yaw, then roll.
+		 * Combined in a pitch, then yaw, then roll, giving the same matrix as
+		 * MakeRotateZ(roll) * MakeRotateY(yaw) * MakeRotateX(pitch). The
+		 * product is expanded by hand, so only one sine and cosine is taken
+		 * per axis and no intermediate matrices are built.
 		 *
 		 * @param pitch Amount to pitch, expressed in radians.
 		 * @param yaw	Amount to yaw, expressed in radians.
 		 * @param roll	Amount to roll, expressed in radians.
 		 * @return The rotation matrix.
 		 */
-		static Matrix3 MakeEuler(float pitch, float yaw, float roll);
+		template<Precision P = DefaultPrecision>
+		static Matrix3 MakeEuler(float pitch, float yaw, float roll) {
+			float sx, cx, sy, cy, sz, cz;
+			SinCos<P>(pitch, sx, cx);
+			SinCos<P>(yaw, sy, cy);
+			SinCos<P>(roll, sz, cz);
+
+			float czsy = cz * sy, szsy = sz * sy;
+			return {
+				cz * cy, sz * cy, -sy,
+				(czsy * sx) - (sz * cx), (szsy * sx) + (cz * cx), cy * sx,
+				(czsy * cx) + (sz * sx), (szsy * cx) - (cz * sx), cy * cx
+			};
+		}
 
 		/**
 		 * Creates a rotation matrix that applies a pitch, yaw, roll rotation
@@ -213,7 +465,10 @@ namespace MathClasses
 		 * @param rot Vector containing how much to pitch (X), yaw (Y), and roll (Z)
 		 * @return The rotation matrix.
 		 */
-		static Matrix3 MakeEuler(Vector3 rot);
+		template<Precision P = DefaultPrecision>
+		static Matrix3 MakeEuler(Vector3 rot) {
+			return MakeEuler<P>(rot.x, rot.y, rot.z);
+		}
 
 		/**
 		 * Creates a scaling matrix that applies to the X and Y axes.
@@ -226,7 +481,9 @@ namespace MathClasses
 		 * @param yScale Scalar for the Y-axis.
 		 * @return The scaling matrix.
 		 */
-		static Matrix3 MakeScale(float xScale, float yScale);
+		static constexpr Matrix3 MakeScale(float xScale, float yScale) {
+			return { xScale, 0, 0, 0, yScale, 0, 0, 0, 1.0f };
+		}
 
 		/**
 		 * Creates a scaling matrix that applies to the X, Y, and Z axis with
@@ -238,7 +495,9 @@ namespace MathClasses
 		 * @param yScale Scalar for the Y-axis.
 		 * @return The scaling matrix.
 		 */
-		static Matrix3 MakeScale(float xScale, float yScale, float zScale);
+		static constexpr Matrix3 MakeScale(float xScale, float yScale, float zScale) {
+			return { xScale, 0, 0, 0, yScale, 0, 0, 0, zScale };
+		}
 
 		/**
 		 * Creates a scaling matrix that applies to the X, Y, and Z axis with
@@ -251,7 +510,65 @@ namespace MathClasses
 		 * @param scale Scale factor expressed as a Vector.
 		 * @return The scaling matrix.
 		 */
-		static Matrix3 MakeScale(Vector3 scale);
+		static constexpr Matrix3 MakeScale(Vector3 scale) {
+			return MakeScale(scale.x, scale.y, scale.z);
+		}
+
+		/**
+		 * Creates a 2D transform that scales, then rotates, then translates,
+		 * giving the same matrix as
+		 * MakeTranslation(translation) * MakeRotateZ(rotation) * MakeScale(scale.x, scale.y)
+		 * without building or multiplying the three matrices.
+		 *
+		 * For use with 2-D math.
+		 *
+		 * @param translation Amount to translate by on the X and Y axes.
+		 * @param rotation Rotation around the Z-axis, expressed in radians.
+		 * @param scale Scalar for the X and Y axes.
+		 * @return The transform matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix3 MakeTRS(Vector2 translation, float rotation, Vector2 scale) {
+			float s, c;
+			SinCos<P>(rotation, s, c);
+			return {
+				c * scale.x, s * scale.x, 0,
+				-s * scale.y, c * scale.y, 0,
+				translation.x, translation.y, 1.0f
+			};
+		}
+
+		/**
+		 * Builds a 2D transform for every element of a set of
+		 * structure-of-arrays inputs. See MakeTRS(Vector2, float, Vector2).
+		 *
+		 * Suited to rebuilding the local matrix of every moving object in a
+		 * scene each frame, with the positions and scales kept in streams.
+		 *
+		 * @param translations The translation of each transform.
+		 * @param rotations The rotation of each transform in radians, holding translations.Size() angles.
+		 * @param scales The scale of each transform.
+		 * @param out Destination for the transforms, holding at least translations.Size() matrices.
+		 */
+		template<Precision P = DefaultPrecision>
+		static void MakeTRS(const Vector2Stream& translations, const float* rotations, const Vector2Stream& scales, Matrix3* out) {
+			assert(translations.Size() == scales.Size());
+			const size_t count = translations.Size();
+			const float* tx = translations.x.data();
+			const float* ty = translations.y.data();
+			const float* sx = scales.x.data();
+			const float* sy = scales.y.data();
+
+			for (size_t i = 0; i < count; i++) {
+				float s, c;
+				SinCos<P>(rotations[i], s, c);
+				out[i] = {
+					c * sx[i], s * sx[i], 0,
+					-s * sy[i], c * sy[i], 0,
+					tx[i], ty[i], 1.0f
+				};
+			}
+		}
 
 		/*
 		 * OPTIONAL
@@ -265,7 +582,9 @@ namespace MathClasses
 		  *
 		  * @return The transposed matrix.
 		  */
-		Matrix3 Transposed() const;
+		constexpr Matrix3 Transposed() const {
+			return { m1, m4, m7, m2, m5, m8, m3, m6, m9 };
+		}
 
 		/**
 		 * Accesses the matrix as though it were an array of floats in columns.
@@ -273,7 +592,9 @@ namespace MathClasses
 		 * @param dim The index (accessed by "columns").
 		 * @return Returns a reference to the element at the requested index.
 		 */
-		float& operator [](int dim);
+		float& operator [](int dim) {
+			return v[dim];
+		}
 
 		/**
 		 * Accesses the matrix as though it were an array of floats in columns.
@@ -281,20 +602,26 @@ namespace MathClasses
 		 * @param dim The index (accessed by "columns").
 		 * @return Returns a const reference to the element at the requested index.
 		 */
-		const float& operator [](int dim) const;
+		const float& operator [](int dim) const {
+			return v[dim];
+		}
 
 		/**
 		 * Casts the matrix as though it were an array of floats in columns.
 		 *
 		 * @return Returns a float* pointing to the first element of the "array".
 		 */
-		operator float* ();
+		operator float* () {
+			return v;
+		}
 
 		/**
 		 * Casts the matrix as though it were an array of floats in columns.
 		 *
 		 * @return Returns a const float* pointing to the first element of the "array".
 		 */
-		operator const float* () const;
+		operator const float* () const {
+			return v;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+#include "Fixed32.h"
+#include "Simd.h"
+
+#include <cstddef>
+#include <string>
+
+namespace MathClasses
+{
+	/**
+	 * A 3x3 column-major matrix of Q16.16 fixed-point values, laid out like
+	 * Matrix3, for 2D transforms in lockstep simulation.
+	 *
+	 * Every product rounds each multiply separately and adds with integer
+	 * wrap-around. That makes the result independent of evaluation order, so
+	 * TransformPoints gives bit-identical results to operator* on every
+	 * SIMD backend.
+	 */
+	struct Matrix3fx
+	{
+		// A plain array rather than Matrix3's union of named members:
+		// anonymous structs cannot hold members with constructors.
+		Fixed32 v[9];
+
+		/**
+		 * Initializes all members to zero
+		 */
+		constexpr Matrix3fx() : Matrix3fx(0, 0, 0, 0, 0, 0, 0, 0, 0) {}
+
+		constexpr Matrix3fx(Fixed32 inM1, Fixed32 inM2, Fixed32 inM3, Fixed32 inM4, Fixed32 inM5, Fixed32 inM6, Fixed32 inM7, Fixed32 inM8, Fixed32 inM9)
+			: v{ inM1, inM2, inM3, inM4, inM5, inM6, inM7, inM8, inM9 } {}
+
+		static constexpr Matrix3fx MakeIdentity() {
+			return { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+		}
+
+		constexpr Matrix3fx operator *(const Matrix3fx& rhs) const {
+			Matrix3fx result;
+			for (int c = 0; c < 3; c++) {
+				for (int r = 0; r < 3; r++) {
+					result.v[c * 3 + r] = (v[r] * rhs.v[c * 3]) + (v[3 + r] * rhs.v[c * 3 + 1]) + (v[6 + r] * rhs.v[c * 3 + 2]);
+				}
+			}
+			return result;
+		}
+
+		/**
+		 * Assigns and returns the result of this Matrix multiplied against the
+		 * other Matrix.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return The reference to this Matrix after multiplication.
+		 */
+		constexpr Matrix3fx& operator *=(const Matrix3fx& rhs) {
+			*this = *this * rhs;
+			return *this;
+		}
+
+		/**
+		 * Multiplies this matrix against the given point, treating it like a
+		 * 3x1 matrix whose third element is 1.
+		 *
+		 * @param rhs The point
+		 * @return The transformed point.
+		 */
+		constexpr Vector2fx operator *(Vector2fx rhs) const {
+			return {
+				(v[0] * rhs.x) + (v[3] * rhs.y) + v[6],
+				(v[1] * rhs.x) + (v[4] * rhs.y) + v[7]
+			};
+		}
+
+		/**
+		 * Transforms an array of points exactly as operator*(Vector2fx)
+		 * does, four points per iteration. The output may be the same array
+		 * as the input.
+		 *
+		 * @param in The points to transform.
+		 * @param out Destination for the transformed points, holding at least count points.
+		 * @param count The number of points.
+		 */
+		void TransformPoints(const Vector2fx* in, Vector2fx* out, size_t count) const {
+			// Each register holds two points (x0, y0, x1, y1), as in
+			// Matrix3::TransformPoints.
+			const Simd::Int4 col0 = Simd::SetInt(v[0].raw, v[1].raw, v[0].raw, v[1].raw);
+			const Simd::Int4 col1 = Simd::SetInt(v[3].raw, v[4].raw, v[3].raw, v[4].raw);
+			const Simd::Int4 col2 = Simd::SetInt(v[6].raw, v[7].raw, v[6].raw, v[7].raw);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Int4 a = Simd::LoadUnaligned(&in[i].x.raw);
+				Simd::Int4 b = Simd::LoadUnaligned(&in[i + 2].x.raw);
+
+				Simd::Int4 ra = Simd::Add(Simd::Add(Simd::MulQ16(col0, Simd::DuplicateEven(a)), Simd::MulQ16(col1, Simd::DuplicateOdd(a))), col2);
+				Simd::Int4 rb = Simd::Add(Simd::Add(Simd::MulQ16(col0, Simd::DuplicateEven(b)), Simd::MulQ16(col1, Simd::DuplicateOdd(b))), col2);
+
+				Simd::StoreUnaligned(&out[i].x.raw, ra);
+				Simd::StoreUnaligned(&out[i + 2].x.raw, rb);
+			}
+			for (; i < count; i++) {
+				out[i] = *this * in[i];
+			}
+		}
+
+		/**
+		 * Returns true if every component is exactly equal to the other.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		constexpr bool operator == (const Matrix3fx& rhs) const {
+			for (int i = 0; i < 9; i++) {
+				if (v[i] != rhs.v[i]) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Returns true if any component is not exactly equal to the other.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if not equal, otherwise false.
+		 */
+		constexpr bool operator != (const Matrix3fx& rhs) const {
+			return !(*this == rhs);
+		}
+
+		/**
+		 * Returns true if every component is exactly equal to the other.
+		 * Fixed-point results are deterministic, so there is no tolerance.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		constexpr bool Equals(const Matrix3fx& rhs) const {
+			return *this == rhs;
+		}
+
+		/**
+		 * Returns this as a formatted string.
+		 *
+		 * @return The three columns, comma separated.
+		 */
+		std::string ToString() const {
+			std::string result;
+			for (int c = 0; c < 3; c++) {
+				result += (c == 0 ? "[" : "], [") + v[c * 3].ToString() + ", " + v[c * 3 + 1].ToString() + ", " + v[c * 3 + 2].ToString();
+			}
+			return result + "]";
+		}
+
+		/**
+		 * Creates a translation matrix for 2-D math.
+		 *
+		 * @param translation Amount to translate by on the X and Y axes.
+		 * @return The translation matrix.
+		 */
+		static constexpr Matrix3fx MakeTranslation(Vector2fx translation) {
+			return { 1, 0, 0, 0, 1, 0, translation.x, translation.y, 1 };
+		}
+
+		/**
+		 * Creates a rotation matrix that rotates around the Z-axis, using the
+		 * table-based Sin and Cos.
+		 *
+		 * @param a Rotation around the Z-axis, expressed in radians.
+		 * @return The rotation matrix.
+		 */
+		static constexpr Matrix3fx MakeRotateZ(Fixed32 a) {
+			Fixed32 s = 0, c = 0;
+			SinCos(a, s, c);
+			return { c, s, 0, -s, c, 0, 0, 0, 1 };
+		}
+
+		/**
+		 * Creates a scaling matrix for 2-D math.
+		 *
+		 * @param xScale Scalar for the X-axis.
+		 * @param yScale Scalar for the Y-axis.
+		 * @return The scaling matrix.
+		 */
+		static constexpr Matrix3fx MakeScale(Fixed32 xScale, Fixed32 yScale) {
+			return { xScale, 0, 0, 0, yScale, 0, 0, 0, 1 };
+		}
+
+		/**
+		 * Creates a transform that scales, then rotates, then translates,
+		 * matching Matrix3::MakeTRS.
+		 *
+		 * @param translation Amount to translate by on the X and Y axes.
+		 * @param rotation Rotation around the Z-axis, expressed in radians.
+		 * @param scale Scalar for the X and Y axes.
+		 * @return The transform matrix.
+		 */
+		static constexpr Matrix3fx MakeTRS(Vector2fx translation, Fixed32 rotation, Vector2fx scale) {
+			Fixed32 s = 0, c = 0;
+			SinCos(rotation, s, c);
+			return {
+				c * scale.x, s * scale.x, 0,
+				-s * scale.y, c * scale.y, 0,
+				translation.x, translation.y, 1
+			};
+		}
+
+		/**
+		 * Transposes the matrix, turning its columns into rows.
+		 *
+		 * @return The transposed matrix.
+		 */
+		constexpr Matrix3fx Transposed() const {
+			return { v[0], v[3], v[6], v[1], v[4], v[7], v[2], v[5], v[8] };
+		}
+
+		/**
+		 * Accesses the matrix as though it were an array in columns.
+		 *
+		 * @param dim The index (accessed by "columns").
+		 * @return Returns a reference to the element at the requested index.
+		 */
+		Fixed32& operator [](int dim) {
+			return v[dim];
+		}
+
+		const Fixed32& operator [](int dim) const {
+			return v[dim];
+		}
+	};
+}
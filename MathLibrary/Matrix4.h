@@ -0,0 +1,605 @@
+#pragma once
+#include "Vector3.h"
+#include "Vector4.h"
+#include "VectorStream.h"
+#include "Simd.h"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+namespace MathClasses
+{
+	/**
+	 * A column-major 4x4 matrix whose columns are each held in one SIMD
+	 * register.
+	 *
+	 * Like Vector4, the constexpr operations fall back to the named elements
+	 * when evaluated at compile time.
+	 */
+	struct Matrix4
+	{
+		union
+		{
+			struct
+			{
+				float m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16;
+			};
+
+			float v[16];
+			float mm[4][4];
+			Vector4 axis[4];
+			Simd::Float4 cols[4];
+		};
+
+		/**
+		 * Initializes all members to zero
+		 */
+		constexpr Matrix4() : Matrix4(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0) {}
+
+		constexpr Matrix4(float inM1, float inM2, float inM3, float inM4,
+						  float inM5, float inM6, float inM7, float inM8,
+						  float inM9, float inM10, float inM11, float inM12,
+						  float inM13, float inM14, float inM15, float inM16)
+			: m1(inM1), m2(inM2), m3(inM3), m4(inM4), m5(inM5), m6(inM6), m7(inM7), m8(inM8),
+			  m9(inM9), m10(inM10), m11(inM11), m12(inM12), m13(inM13), m14(inM14), m15(inM15), m16(inM16) {}
+
+		Matrix4(const float* inArr) {
+			for (int i = 0; i < 4; i++) {
+				cols[i] = Simd::LoadUnaligned(inArr + (i * 4));
+			}
+		}
+
+		Matrix4(Simd::Float4 col0, Simd::Float4 col1, Simd::Float4 col2, Simd::Float4 col3) {
+			cols[0] = col0; cols[1] = col1; cols[2] = col2; cols[3] = col3;
+		}
+
+		static constexpr Matrix4 MakeIdentity() {
+			return { 1.0f, 0, 0, 0, 0, 1.0f, 0, 0, 0, 0, 1.0f, 0, 0, 0, 0, 1.0f };
+		}
+
+		/**
+		 * Returns the product of this Matrix and the other Matrix.
+		 *
+		 * Each column of the result is a linear combination of this Matrix's
+		 * columns, weighted by the matching column of the other Matrix, so
+		 * the whole product is 16 broadcast multiply-adds.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return The product of the two matrices.
+		 */
+		constexpr Matrix4 operator *(const Matrix4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				const std::array<float, 16> a = Elements(), b = rhs.Elements();
+				std::array<float, 16> r = {};
+				for (int c = 0; c < 4; c++) {
+					for (int row = 0; row < 4; row++) {
+						for (int k = 0; k < 4; k++) {
+							r[c * 4 + row] += a[k * 4 + row] * b[c * 4 + k];
+						}
+					}
+				}
+				return FromElements(r);
+			}
+
+			Matrix4 result;
+			for (int c = 0; c < 4; c++) {
+				Simd::Float4 col = Simd::Mul(cols[0], Simd::Splat(rhs.mm[c][0]));
+				col = Simd::MulAdd(cols[1], Simd::Splat(rhs.mm[c][1]), col);
+				col = Simd::MulAdd(cols[2], Simd::Splat(rhs.mm[c][2]), col);
+				result.cols[c] = Simd::MulAdd(cols[3], Simd::Splat(rhs.mm[c][3]), col);
+			}
+			return result;
+		}
+
+		/**
+		 * Assigns and returns the result of this Matrix multiplied against the
+		 * other Matrix.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return The reference to this Matrix after multiplication.
+		 */
+		constexpr Matrix4& operator *=(const Matrix4& rhs) {
+			*this = *this * rhs;
+			return *this;
+		}
+
+		/**
+		 * Multiplies this matrix against the given Vector4, treating it like
+		 * a 4x1 matrix.
+		 *
+		 * @param rhs The vector
+		 * @return The product of multiplying the 4x4 by a 4x1
+		 */
+		constexpr Vector4 operator *(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				const std::array<float, 16> a = Elements();
+				return Vector4(
+					a[0] * rhs.x + a[4] * rhs.y + a[8] * rhs.z + a[12] * rhs.w,
+					a[1] * rhs.x + a[5] * rhs.y + a[9] * rhs.z + a[13] * rhs.w,
+					a[2] * rhs.x + a[6] * rhs.y + a[10] * rhs.z + a[14] * rhs.w,
+					a[3] * rhs.x + a[7] * rhs.y + a[11] * rhs.z + a[15] * rhs.w);
+			}
+
+			Simd::Float4 result = Simd::Mul(cols[0], Simd::Splat(rhs.x));
+			result = Simd::MulAdd(cols[1], Simd::Splat(rhs.y), result);
+			result = Simd::MulAdd(cols[2], Simd::Splat(rhs.z), result);
+			return Vector4(Simd::MulAdd(cols[3], Simd::Splat(rhs.w), result));
+		}
+
+		/**
+		 * Returns the determinant of this matrix.
+		 *
+		 * @return The determinant, which is zero if the matrix has no inverse.
+		 */
+		float Determinant() const {
+			Simd::Float4 a = Simd::ZeroW(cols[0]), b = Simd::ZeroW(cols[1]);
+			Simd::Float4 c = Simd::ZeroW(cols[2]), d = Simd::ZeroW(cols[3]);
+			Simd::Float4 s = Simd::Cross3(a, b);
+			Simd::Float4 t = Simd::Cross3(c, d);
+			Simd::Float4 u = Simd::Sub(Simd::Mul(a, Simd::Splat(m8)), Simd::Mul(b, Simd::Splat(m4)));
+			Simd::Float4 v = Simd::Sub(Simd::Mul(c, Simd::Splat(m16)), Simd::Mul(d, Simd::Splat(m12)));
+			return Simd::GetX(Simd::Add(Simd::Dot4(s, v), Simd::Dot4(t, u)));
+		}
+
+		/**
+		 * Returns the inverse of this matrix.
+		 *
+		 * Uses Cramer's rule in the form of cross products between the
+		 * columns' XYZ parts (see Lengyel, "Foundations of Game Engine
+		 * Development"), so it runs entirely in registers.
+		 *
+		 * @return The inverse, or a zero matrix if the determinant is zero.
+		 */
+		Matrix4 Inverted() const {
+			// columns without their bottom row, and the bottom row itself
+			Simd::Float4 a = Simd::ZeroW(cols[0]), b = Simd::ZeroW(cols[1]);
+			Simd::Float4 c = Simd::ZeroW(cols[2]), d = Simd::ZeroW(cols[3]);
+			Simd::Float4 x = Simd::Splat(m4), y = Simd::Splat(m8), z = Simd::Splat(m12), w = Simd::Splat(m16);
+
+			Simd::Float4 s = Simd::Cross3(a, b);
+			Simd::Float4 t = Simd::Cross3(c, d);
+			Simd::Float4 u = Simd::Sub(Simd::Mul(a, y), Simd::Mul(b, x));
+			Simd::Float4 v = Simd::Sub(Simd::Mul(c, w), Simd::Mul(d, z));
+
+			Simd::Float4 det = Simd::Add(Simd::Dot4(s, v), Simd::Dot4(t, u));
+			if (Simd::GetX(det) == 0) {
+				return Matrix4();
+			}
+			Simd::Float4 invDet = Simd::Div(Simd::Splat(1.0f), det);
+
+			// the XYZ parts of each row have a zero W, so the W term is added
+			// through a unit W register
+			const Simd::Float4 unitW = Simd::Set(0, 0, 0, 1.0f);
+			Simd::Float4 r0 = Simd::MulAdd(Simd::Neg(Simd::Dot4(b, t)), unitW, Simd::MulAdd(t, y, Simd::Cross3(b, v)));
+			Simd::Float4 r1 = Simd::MulAdd(Simd::Dot4(a, t), unitW, Simd::Sub(Simd::Cross3(v, a), Simd::Mul(t, x)));
+			Simd::Float4 r2 = Simd::MulAdd(Simd::Neg(Simd::Dot4(d, s)), unitW, Simd::MulAdd(s, w, Simd::Cross3(d, u)));
+			Simd::Float4 r3 = Simd::MulAdd(Simd::Dot4(c, s), unitW, Simd::Sub(Simd::Cross3(u, c), Simd::Mul(s, z)));
+
+			Matrix4 result(Simd::Mul(r0, invDet), Simd::Mul(r1, invDet), Simd::Mul(r2, invDet), Simd::Mul(r3, invDet));
+			Simd::Transpose(result.cols[0], result.cols[1], result.cols[2], result.cols[3]);
+			return result;
+		}
+
+		/**
+		 * Returns the inverse of a transform made of a translation, rotation
+		 * and scale, such as MakeTranslation * MakeEuler * MakeScale.
+		 *
+		 * The axes are transposed into rows, each divided by its squared
+		 * length to undo scale, and the translation is rotated back and
+		 * negated. No cofactor expansion is needed. Matrices with shear or
+		 * a projection need Inverted() instead.
+		 *
+		 * @return The inverse transform.
+		 */
+		Matrix4 AffineInverted() const {
+			Simd::Float4 r0 = Simd::ZeroW(cols[0]);
+			Simd::Float4 r1 = Simd::ZeroW(cols[1]);
+			Simd::Float4 r2 = Simd::ZeroW(cols[2]);
+			r0 = Simd::Div(r0, Simd::Dot4(r0, r0));
+			r1 = Simd::Div(r1, Simd::Dot4(r1, r1));
+			r2 = Simd::Div(r2, Simd::Dot4(r2, r2));
+			Simd::Float4 r3 = Simd::Zero();
+			Simd::Transpose(r0, r1, r2, r3);
+
+			Simd::Float4 translation = Simd::Mul(r0, Simd::Splat(m13));
+			translation = Simd::MulAdd(r1, Simd::Splat(m14), translation);
+			translation = Simd::MulAdd(r2, Simd::Splat(m15), translation);
+			return Matrix4(r0, r1, r2, Simd::Sub(Simd::Set(0, 0, 0, 1.0f), translation));
+		}
+
+		/**
+		 * Inverts an array of matrices. See Inverted().
+		 *
+		 * @param in The matrices to invert.
+		 * @param out Destination for the inverses. May be the same array as in.
+		 * @param count The number of matrices.
+		 */
+		static void Invert(const Matrix4* in, Matrix4* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = in[i].Inverted();
+			}
+		}
+
+		/**
+		 * Inverts an array of translation, rotation and scale transforms.
+		 * See AffineInverted().
+		 *
+		 * @param in The matrices to invert.
+		 * @param out Destination for the inverses. May be the same array as in.
+		 * @param count The number of matrices.
+		 */
+		static void AffineInvert(const Matrix4* in, Matrix4* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = in[i].AffineInverted();
+			}
+		}
+
+		/**
+		 * Returns true if every component is exactly equal to the other.
+		 *
+		 * See also: Equals() for approximate equality.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		constexpr bool operator == (const Matrix4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Elements() == rhs.Elements();
+			}
+			return Simd::AllEqual(cols[0], rhs.cols[0]) && Simd::AllEqual(cols[1], rhs.cols[1]) &&
+				   Simd::AllEqual(cols[2], rhs.cols[2]) && Simd::AllEqual(cols[3], rhs.cols[3]);
+		}
+
+		/**
+		 * Returns true if any component is not exactly equal to the other.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		constexpr bool operator != (const Matrix4& rhs) const {
+			return !(*this == rhs);
+		}
+
+		/**
+		 * Returns true if every component is approximately equal to the other.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		bool Equals(const Matrix4& rhs, float Tolerance = MAX_FLOAT_DELTA) const {
+			const Simd::Float4 tol = Simd::Splat(Tolerance);
+			for (int i = 0; i < 4; i++) {
+				if (!Simd::AllLess(Simd::Abs(Simd::Sub(cols[i], rhs.cols[i])), tol)) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Returns this as a formatted string.
+		 *
+		 * @return A comma separated Vector with its components.
+		 */
+		std::string ToString() const {
+			return "[" + axis[0].ToString() + "], [" + axis[1].ToString() + "], [" +
+				   axis[2].ToString() + "], [" + axis[3].ToString() + "]";
+		}
+
+		/**
+		 * Transform Factory Functions
+		 */
+
+		/**
+		 * Creates a translation matrix that translates on the given X, Y, and
+		 * Z-axes.
+		 *
+		 * @param x Amount to translate by on the X-axis.
+		 * @param y Amount to translate by on the Y-axis.
+		 * @param z Amount to translate by on the Z-axis.
+		 * @return The translation matrix.
+		 */
+		static constexpr Matrix4 MakeTranslation(float x, float y, float z) {
+			return { 1.0f, 0, 0, 0, 0, 1.0f, 0, 0, 0, 0, 1.0f, 0, x, y, z, 1.0f };
+		}
+
+		/**
+		 * Creates a translation matrix that translates on the given X, Y, and
+		 * Z-axes.
+		 *
+		 * @param vec A Vector containing the amount to translate by on the X, Y, and Z axes.
+		 * @return The translation matrix.
+		 */
+		static constexpr Matrix4 MakeTranslation(Vector3 vec) {
+			return MakeTranslation(vec.x, vec.y, vec.z);
+		}
+
+		/**
+		 * Creates a rotation matrix that rotates around the X-axis
+		 *
+		 * @param Rotation around the X-axis, expressed in radians.
+		 * @return The rotation matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix4 MakeRotateX(float a) {
+			float s, c;
+			SinCos<P>(a, s, c);
+			return { 1.0f, 0, 0, 0, 0, c, s, 0, 0, -s, c, 0, 0, 0, 0, 1.0f };
+		}
+
+		/**
+		 * Creates a rotation matrix that rotates around the Y-axis
+		 *
+		 * @param Rotation around the Y-axis, expressed in radians.
+		 * @return The rotation matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix4 MakeRotateY(float a) {
+			float s, c;
+			SinCos<P>(a, s, c);
+			return { c, 0, -s, 0, 0, 1.0f, 0, 0, s, 0, c, 0, 0, 0, 0, 1.0f };
+		}
+
+		/**
+		 * Creates a rotation matrix that rotates around the Z-axis
+		 *
+		 * @param Rotation around the Z-axis, expressed in radians.
+		 * @return The rotation matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix4 MakeRotateZ(float a) {
+			float s, c;
+			SinCos<P>(a, s, c);
+			return { c, s, 0, 0, -s, c, 0, 0, 0, 0, 1.0f, 0, 0, 0, 0, 1.0f };
+		}
+
+		/**
+		 * Creates a rotation matrix that applies a pitch, yaw, roll rotation
+		 *
+		 * Combined in a pitch, then yaw, then roll, giving the same matrix as
+		 * MakeRotateZ(roll) * MakeRotateY(yaw) * MakeRotateX(pitch). The
+		 * product is expanded by hand, so only one sine and cosine is taken
+		 * per axis and no intermediate matrices are built.
+		 *
+		 * @param pitch Amount to pitch, expressed in radians.
+		 * @param yaw	Amount to yaw, expressed in radians.
+		 * @param roll	Amount to roll, expressed in radians.
+		 * @return The rotation matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix4 MakeEuler(float pitch, float yaw, float roll) {
+			return MakeTRS<P>(Vector3(0, 0, 0), Vector3(pitch, yaw, roll), Vector3(1.0f, 1.0f, 1.0f));
+		}
+
+		/**
+		 * Creates a rotation matrix that applies a pitch, yaw, roll rotation
+		 * expressed as the X, Y, and Z components of a Vector.
+		 *
+		 * @param rot Vector containing how much to pitch (X), yaw (Y), and roll (Z)
+		 * @return The rotation matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix4 MakeEuler(Vector3 rot) {
+			return MakeEuler<P>(rot.x, rot.y, rot.z);
+		}
+
+		/**
+		 * Creates a scaling matrix that applies to the X, Y, and Z axis.
+		 *
+		 * @param xScale Scalar for the X-axis.
+		 * @param yScale Scalar for the Y-axis.
+		 * @param zScale Scalar for the Z-axis.
+		 * @return The scaling matrix.
+		 */
+		static constexpr Matrix4 MakeScale(float xScale, float yScale, float zScale) {
+			return { xScale, 0, 0, 0, 0, yScale, 0, 0, 0, 0, zScale, 0, 0, 0, 0, 1.0f };
+		}
+
+		/**
+		 * Creates a scaling matrix that applies to the X, Y, and Z axis,
+		 * expressed as the components of a Vector's X, Y, and Z.
+		 *
+		 * @param scale Scale factor expressed as a Vector.
+		 * @return The scaling matrix.
+		 */
+		static constexpr Matrix4 MakeScale(Vector3 scale) {
+			return MakeScale(scale.x, scale.y, scale.z);
+		}
+
+		/**
+		 * Creates a transform that scales, then rotates, then translates,
+		 * giving the same matrix as
+		 * MakeTranslation(translation) * MakeEuler(rotation) * MakeScale(scale)
+		 * without building or multiplying the intermediate matrices.
+		 *
+		 * @param translation Amount to translate by on the X, Y, and Z axes.
+		 * @param rotation Vector containing how much to pitch (X), yaw (Y), and roll (Z) in radians.
+		 * @param scale Scalar for the X, Y, and Z axes.
+		 * @return The transform matrix.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Matrix4 MakeTRS(Vector3 translation, Vector3 rotation, Vector3 scale) {
+			float sx, cx, sy, cy, sz, cz;
+			SinCos<P>(rotation.x, sx, cx);
+			SinCos<P>(rotation.y, sy, cy);
+			SinCos<P>(rotation.z, sz, cz);
+
+			// the columns of MakeEuler, each multiplied by its axis' scale
+			float czsy = cz * sy, szsy = sz * sy;
+			return {
+				cz * cy * scale.x, sz * cy * scale.x, -sy * scale.x, 0,
+				((czsy * sx) - (sz * cx)) * scale.y, ((szsy * sx) + (cz * cx)) * scale.y, cy * sx * scale.y, 0,
+				((czsy * cx) + (sz * sx)) * scale.z, ((szsy * cx) - (cz * sx)) * scale.z, cy * cx * scale.z, 0,
+				translation.x, translation.y, translation.z, 1.0f
+			};
+		}
+
+		/**
+		 * Creates a right-handed perspective projection looking down -Z that
+		 * maps the view volume to clip space with depth from -w to w, the
+		 * OpenGL convention raylib uses.
+		 *
+		 * @param fovY The vertical field of view in radians.
+		 * @param aspect The width of the view divided by its height.
+		 * @param nearPlane The distance to the near clipping plane, greater than zero.
+		 * @param farPlane The distance to the far clipping plane.
+		 * @return The projection matrix.
+		 */
+		static Matrix4 MakePerspective(float fovY, float aspect, float nearPlane, float farPlane) {
+			float f = 1.0f / std::tan(fovY * 0.5f);
+			float depth = 1.0f / (nearPlane - farPlane);
+			return {
+				f / aspect, 0, 0, 0,
+				0, f, 0, 0,
+				0, 0, (farPlane + nearPlane) * depth, -1.0f,
+				0, 0, 2.0f * farPlane * nearPlane * depth, 0
+			};
+		}
+
+		/**
+		 * Builds a transform for every element of a set of structure-of-arrays
+		 * inputs. See MakeTRS(Vector3, Vector3, Vector3).
+		 *
+		 * Four transforms are built per iteration: their matrix elements are
+		 * computed side by side in SIMD registers, one register per element,
+		 * and transposed into the columns of the four matrices.
+		 *
+		 * @param translations The translation of each transform.
+		 * @param rotations The pitch (X), yaw (Y), and roll (Z) of each transform in radians.
+		 * @param scales The scale of each transform.
+		 * @param out Destination for the transforms, holding at least translations.Size() matrices.
+		 */
+		template<Precision P = DefaultPrecision>
+		static void MakeTRS(const Vector3Stream& translations, const Vector3Stream& rotations, const Vector3Stream& scales, Matrix4* out) {
+			assert(translations.Size() == rotations.Size() && translations.Size() == scales.Size());
+			const size_t count = translations.Size();
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				alignas(16) float sines[3][4];
+				alignas(16) float cosines[3][4];
+				for (size_t j = 0; j < 4; j++) {
+					SinCos<P>(rotations.x[i + j], sines[0][j], cosines[0][j]);
+					SinCos<P>(rotations.y[i + j], sines[1][j], cosines[1][j]);
+					SinCos<P>(rotations.z[i + j], sines[2][j], cosines[2][j]);
+				}
+				Simd::Float4 sx = Simd::Load(sines[0]), cx = Simd::Load(cosines[0]);
+				Simd::Float4 sy = Simd::Load(sines[1]), cy = Simd::Load(cosines[1]);
+				Simd::Float4 sz = Simd::Load(sines[2]), cz = Simd::Load(cosines[2]);
+				Simd::Float4 scaleX = Simd::LoadUnaligned(scales.x.data() + i);
+				Simd::Float4 scaleY = Simd::LoadUnaligned(scales.y.data() + i);
+				Simd::Float4 scaleZ = Simd::LoadUnaligned(scales.z.data() + i);
+
+				Simd::Float4 czsy = Simd::Mul(cz, sy), szsy = Simd::Mul(sz, sy);
+				Simd::Float4 c0[4] = {
+					Simd::Mul(Simd::Mul(cz, cy), scaleX),
+					Simd::Mul(Simd::Mul(sz, cy), scaleX),
+					Simd::Neg(Simd::Mul(sy, scaleX)),
+					Simd::Zero()
+				};
+				Simd::Float4 c1[4] = {
+					Simd::Mul(Simd::Sub(Simd::Mul(czsy, sx), Simd::Mul(sz, cx)), scaleY),
+					Simd::Mul(Simd::MulAdd(szsy, sx, Simd::Mul(cz, cx)), scaleY),
+					Simd::Mul(Simd::Mul(cy, sx), scaleY),
+					Simd::Zero()
+				};
+				Simd::Float4 c2[4] = {
+					Simd::Mul(Simd::MulAdd(czsy, cx, Simd::Mul(sz, sx)), scaleZ),
+					Simd::Mul(Simd::Sub(Simd::Mul(szsy, cx), Simd::Mul(cz, sx)), scaleZ),
+					Simd::Mul(Simd::Mul(cy, cx), scaleZ),
+					Simd::Zero()
+				};
+				Simd::Float4 c3[4] = {
+					Simd::LoadUnaligned(translations.x.data() + i),
+					Simd::LoadUnaligned(translations.y.data() + i),
+					Simd::LoadUnaligned(translations.z.data() + i),
+					Simd::Splat(1.0f)
+				};
+
+				// each register holds one element of four matrices; transposing
+				// turns them into one column of each matrix
+				Simd::Transpose(c0[0], c0[1], c0[2], c0[3]);
+				Simd::Transpose(c1[0], c1[1], c1[2], c1[3]);
+				Simd::Transpose(c2[0], c2[1], c2[2], c2[3]);
+				Simd::Transpose(c3[0], c3[1], c3[2], c3[3]);
+				for (size_t j = 0; j < 4; j++) {
+					out[i + j] = Matrix4(c0[j], c1[j], c2[j], c3[j]);
+				}
+			}
+			for (; i < count; i++) {
+				out[i] = MakeTRS<P>(translations.Get(i), rotations.Get(i), scales.Get(i));
+			}
+		}
+
+		/**
+		 * Transposes the matrix, swapping the values along the diagonal defined
+		 * as m1, m6, m11, m16.
+		 *
+		 * In other words, it turns its columns into rows.
+		 *
+		 * @return The transposed matrix.
+		 */
+		constexpr Matrix4 Transposed() const {
+			if (std::is_constant_evaluated()) {
+				return { m1, m5, m9, m13, m2, m6, m10, m14, m3, m7, m11, m15, m4, m8, m12, m16 };
+			}
+
+			Matrix4 result = *this;
+			Simd::Transpose(result.cols[0], result.cols[1], result.cols[2], result.cols[3]);
+			return result;
+		}
+
+		/**
+		 * Accesses the matrix as though it were an array of floats in columns.
+		 *
+		 * @param dim The index (accessed by "columns").
+		 * @return Returns a reference to the element at the requested index.
+		 */
+		float& operator [](int dim) {
+			return v[dim];
+		}
+
+		/**
+		 * Accesses the matrix as though it were an array of floats in columns.
+		 *
+		 * @param dim The index (accessed by "columns").
+		 * @return Returns a const reference to the element at the requested index.
+		 */
+		const float& operator [](int dim) const {
+			return v[dim];
+		}
+
+		/**
+		 * Casts the matrix as though it were an array of floats in columns.
+		 *
+		 * @return Returns a float* pointing to the first element of the "array".
+		 */
+		operator float* () {
+			return v;
+		}
+
+		/**
+		 * Casts the matrix as though it were an array of floats in columns.
+		 *
+		 * @return Returns a const float* pointing to the first element of the "array".
+		 */
+		operator const float* () const {
+			return v;
+		}
+
+	private:
+		/* The elements in column order, read through the named members so
+		 * this is usable in constant expressions. */
+		constexpr std::array<float, 16> Elements() const {
+			return { m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16 };
+		}
+
+		static constexpr Matrix4 FromElements(const std::array<float, 16>& e) {
+			return { e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7], e[8], e[9], e[10], e[11], e[12], e[13], e[14], e[15] };
+		}
+	};
+
+	static_assert(sizeof(Matrix4) == 64 && alignof(Matrix4) == 16, "Matrix4 must map exactly onto four SIMD registers");
+}
@@ -0,0 +1,369 @@
+#pragma once
+#include "VectorN.h"
+#include "Vector3.h"
+#include "Matrix4.h"
+
+#include <cmath>
+#include <string>
+
+namespace MathClasses
+{
+	/**
+	 * A column-major 4x4 matrix of doubles, laid out like Matrix4.
+	 *
+	 * Used to store transforms in large worlds, where float positions lose
+	 * precision far from the origin. Rendering and physics still run on
+	 * Matrix4: convert with ToMatrix4(origin), which moves the origin,
+	 * usually the camera position, to zero before narrowing to float.
+	 */
+	struct Matrix4d
+	{
+		union
+		{
+			struct
+			{
+				double m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16;
+			};
+
+			double v[16];
+			double mm[4][4];
+			Vector4d axis[4];
+		};
+
+		/**
+		 * Initializes all members to zero
+		 */
+		constexpr Matrix4d() : Matrix4d(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0) {}
+
+		constexpr Matrix4d(double inM1, double inM2, double inM3, double inM4,
+						   double inM5, double inM6, double inM7, double inM8,
+						   double inM9, double inM10, double inM11, double inM12,
+						   double inM13, double inM14, double inM15, double inM16)
+			: m1(inM1), m2(inM2), m3(inM3), m4(inM4), m5(inM5), m6(inM6), m7(inM7), m8(inM8),
+			  m9(inM9), m10(inM10), m11(inM11), m12(inM12), m13(inM13), m14(inM14), m15(inM15), m16(inM16) {}
+
+		/**
+		 * Widens a float matrix.
+		 */
+		explicit Matrix4d(const Matrix4& other) {
+			for (int i = 0; i < 16; i++) {
+				v[i] = other.v[i];
+			}
+		}
+
+		static constexpr Matrix4d MakeIdentity() {
+			return { 1.0, 0, 0, 0, 0, 1.0, 0, 0, 0, 0, 1.0, 0, 0, 0, 0, 1.0 };
+		}
+
+		/**
+		 * Returns the product of this Matrix and the other Matrix.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return The product of the two matrices.
+		 */
+		Matrix4d operator *(const Matrix4d& rhs) const {
+			Matrix4d result;
+			for (int c = 0; c < 4; c++) {
+				for (int row = 0; row < 4; row++) {
+					result.mm[c][row] = (mm[0][row] * rhs.mm[c][0]) + (mm[1][row] * rhs.mm[c][1]) +
+										(mm[2][row] * rhs.mm[c][2]) + (mm[3][row] * rhs.mm[c][3]);
+				}
+			}
+			return result;
+		}
+
+		/**
+		 * Assigns and returns the result of this Matrix multiplied against the
+		 * other Matrix.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return The reference to this Matrix after multiplication.
+		 */
+		Matrix4d& operator *=(const Matrix4d& rhs) {
+			*this = *this * rhs;
+			return *this;
+		}
+
+		/**
+		 * Multiplies this matrix against the given Vector4d, treating it like
+		 * a 4x1 matrix.
+		 *
+		 * @param rhs The vector
+		 * @return The product of multiplying the 4x4 by a 4x1
+		 */
+		Vector4d operator *(const Vector4d& rhs) const {
+			return {
+				(m1 * rhs.x) + (m5 * rhs.y) + (m9 * rhs.z) + (m13 * rhs.w),
+				(m2 * rhs.x) + (m6 * rhs.y) + (m10 * rhs.z) + (m14 * rhs.w),
+				(m3 * rhs.x) + (m7 * rhs.y) + (m11 * rhs.z) + (m15 * rhs.w),
+				(m4 * rhs.x) + (m8 * rhs.y) + (m12 * rhs.z) + (m16 * rhs.w)
+			};
+		}
+
+		/**
+		 * Transforms a position, treating it like a 4x1 matrix whose fourth
+		 * element is 1.0. The matrix is assumed to be affine.
+		 *
+		 * @param point The position.
+		 * @return The transformed position.
+		 */
+		Vector3d TransformPoint(const Vector3d& point) const {
+			return {
+				(m1 * point.x) + (m5 * point.y) + (m9 * point.z) + m13,
+				(m2 * point.x) + (m6 * point.y) + (m10 * point.z) + m14,
+				(m3 * point.x) + (m7 * point.y) + (m11 * point.z) + m15
+			};
+		}
+
+		/**
+		 * Returns the translation held in the fourth column.
+		 */
+		Vector3d GetTranslation() const {
+			return { m13, m14, m15 };
+		}
+
+		/**
+		 * Narrows this matrix to float with the given point moved to the
+		 * origin, for rendering relative to a camera.
+		 *
+		 * The translation is made relative in double before rounding, so an
+		 * object near the camera keeps full float precision however far both
+		 * are from the world origin.
+		 *
+		 * @param origin The point that becomes the origin, usually the camera position.
+		 * @return The relative matrix in float.
+		 */
+		Matrix4 ToMatrix4(const Vector3d& origin) const {
+			return {
+				(float)m1, (float)m2, (float)m3, (float)m4,
+				(float)m5, (float)m6, (float)m7, (float)m8,
+				(float)m9, (float)m10, (float)m11, (float)m12,
+				(float)(m13 - (origin.x * m16)), (float)(m14 - (origin.y * m16)), (float)(m15 - (origin.z * m16)), (float)m16
+			};
+		}
+
+		/**
+		 * Narrows an array of matrices to float relative to the origin. See
+		 * ToMatrix4(const Vector3d&).
+		 *
+		 * @param in The matrices to convert.
+		 * @param out Destination for the relative matrices, holding at least count matrices.
+		 * @param count The number of matrices.
+		 * @param origin The point that becomes the origin, usually the camera position.
+		 */
+		static void ToMatrix4(const Matrix4d* in, Matrix4* out, size_t count, const Vector3d& origin) {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = in[i].ToMatrix4(origin);
+			}
+		}
+
+		/**
+		 * Returns true if every component is exactly equal to the other.
+		 *
+		 * See also: Equals() for approximate equality.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		bool operator == (const Matrix4d& rhs) const {
+			for (int i = 0; i < 16; i++) {
+				if (v[i] != rhs.v[i]) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Returns true if any component is not exactly equal to the other.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if not equal, otherwise false.
+		 */
+		bool operator != (const Matrix4d& rhs) const {
+			return !(*this == rhs);
+		}
+
+		/**
+		 * Returns true if every component is approximately equal to the other.
+		 *
+		 * @param rhs The other Matrix.
+		 * @return True if equal, otherwise false.
+		 */
+		bool Equals(const Matrix4d& rhs, double Tolerance = MAX_FLOAT_DELTA) const {
+			for (int i = 0; i < 16; i++) {
+				if (std::abs(v[i] - rhs.v[i]) >= Tolerance) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * Returns this as a formatted string.
+		 *
+		 * @return A comma separated Vector with its components.
+		 */
+		std::string ToString() const {
+			return "[" + axis[0].ToString() + "], [" + axis[1].ToString() + "], [" +
+				   axis[2].ToString() + "], [" + axis[3].ToString() + "]";
+		}
+
+		/**
+		 * Transform Factory Functions
+		 */
+
+		/**
+		 * Creates a translation matrix that translates on the given X, Y, and
+		 * Z-axes.
+		 *
+		 * @param x Amount to translate by on the X-axis.
+		 * @param y Amount to translate by on the Y-axis.
+		 * @param z Amount to translate by on the Z-axis.
+		 * @return The translation matrix.
+		 */
+		static constexpr Matrix4d MakeTranslation(double x, double y, double z) {
+			return { 1.0, 0, 0, 0, 0, 1.0, 0, 0, 0, 0, 1.0, 0, x, y, z, 1.0 };
+		}
+
+		/**
+		 * Creates a translation matrix that translates on the given X, Y, and
+		 * Z-axes.
+		 *
+		 * @param vec A Vector containing the amount to translate by on the X, Y, and Z axes.
+		 * @return The translation matrix.
+		 */
+		static constexpr Matrix4d MakeTranslation(const Vector3d& vec) {
+			return MakeTranslation(vec.x, vec.y, vec.z);
+		}
+
+		/**
+		 * Creates a scaling matrix that applies to the X, Y, and Z axis.
+		 *
+		 * @param xScale Scalar for the X-axis.
+		 * @param yScale Scalar for the Y-axis.
+		 * @param zScale Scalar for the Z-axis.
+		 * @return The scaling matrix.
+		 */
+		static constexpr Matrix4d MakeScale(double xScale, double yScale, double zScale) {
+			return { xScale, 0, 0, 0, 0, yScale, 0, 0, 0, 0, zScale, 0, 0, 0, 0, 1.0 };
+		}
+
+		/**
+		 * Creates a rotation matrix that applies a pitch, yaw, roll rotation,
+		 * matching Matrix4::MakeEuler.
+		 *
+		 * @param pitch Amount to pitch, expressed in radians.
+		 * @param yaw	Amount to yaw, expressed in radians.
+		 * @param roll	Amount to roll, expressed in radians.
+		 * @return The rotation matrix.
+		 */
+		static Matrix4d MakeEuler(double pitch, double yaw, double roll) {
+			return MakeTRS(Vector3d(0, 0, 0), Vector3d(pitch, yaw, roll), Vector3d(1.0, 1.0, 1.0));
+		}
+
+		/**
+		 * Creates a transform that scales, then rotates, then translates,
+		 * matching Matrix4::MakeTRS.
+		 *
+		 * @param translation Amount to translate by on the X, Y, and Z axes.
+		 * @param rotation Vector containing how much to pitch (X), yaw (Y), and roll (Z) in radians.
+		 * @param scale Scalar for the X, Y, and Z axes.
+		 * @return The transform matrix.
+		 */
+		static Matrix4d MakeTRS(const Vector3d& translation, const Vector3d& rotation, const Vector3d& scale) {
+			double sx = std::sin(rotation.x), cx = std::cos(rotation.x);
+			double sy = std::sin(rotation.y), cy = std::cos(rotation.y);
+			double sz = std::sin(rotation.z), cz = std::cos(rotation.z);
+
+			double czsy = cz * sy, szsy = sz * sy;
+			return {
+				cz * cy * scale.x, sz * cy * scale.x, -sy * scale.x, 0,
+				((czsy * sx) - (sz * cx)) * scale.y, ((szsy * sx) + (cz * cx)) * scale.y, cy * sx * scale.y, 0,
+				((czsy * cx) + (sz * sx)) * scale.z, ((szsy * cx) - (cz * sx)) * scale.z, cy * cx * scale.z, 0,
+				translation.x, translation.y, translation.z, 1.0
+			};
+		}
+
+		/**
+		 * Transposes the matrix, swapping the values along the diagonal defined
+		 * as m1, m6, m11, m16.
+		 *
+		 * @return The transposed matrix.
+		 */
+		constexpr Matrix4d Transposed() const {
+			return { m1, m5, m9, m13, m2, m6, m10, m14, m3, m7, m11, m15, m4, m8, m12, m16 };
+		}
+
+		/**
+		 * Accesses the matrix as though it were an array of doubles in columns.
+		 *
+		 * @param dim The index (accessed by "columns").
+		 * @return Returns a reference to the element at the requested index.
+		 */
+		double& operator [](int dim) {
+			return v[dim];
+		}
+
+		/**
+		 * Accesses the matrix as though it were an array of doubles in columns.
+		 *
+		 * @param dim The index (accessed by "columns").
+		 * @return Returns a const reference to the element at the requested index.
+		 */
+		const double& operator [](int dim) const {
+			return v[dim];
+		}
+	};
+
+	/**
+	 * Returns a world position relative to the origin, narrowed to float.
+	 *
+	 * @param position The position in world space.
+	 * @param origin The point that becomes the origin, usually the camera position.
+	 * @return The relative position.
+	 */
+	inline Vector3 Rebase(const Vector3d& position, const Vector3d& origin) {
+		return { (float)(position.x - origin.x), (float)(position.y - origin.y), (float)(position.z - origin.z) };
+	}
+
+	/**
+	 * Converts an array of world positions to float positions relative to
+	 * the origin, once per frame before the float kernels run.
+	 *
+	 * The subtraction is done in double and only the small relative result
+	 * is rounded. Two positions (six doubles) are subtracted and narrowed per
+	 * three double registers, and four positions are written per iteration
+	 * as three float registers. The output may not alias the input.
+	 *
+	 * @param positions The positions in world space.
+	 * @param out Destination for the relative positions, holding at least count positions.
+	 * @param count The number of positions.
+	 * @param origin The point that becomes the origin, usually the camera position.
+	 */
+	inline void Rebase(const Vector3d* positions, Vector3* out, size_t count, const Vector3d& origin) {
+		static_assert(sizeof(Vector3d) == 3 * sizeof(double) && sizeof(Vector3) == 3 * sizeof(float),
+					  "Rebase reads and writes the vectors as packed arrays");
+
+		// six consecutive doubles cover two positions: (x, y), (z, x), (y, z)
+		const Simd::Double2 originXY = Simd::Set(origin.x, origin.y);
+		const Simd::Double2 originZX = Simd::Set(origin.z, origin.x);
+		const Simd::Double2 originYZ = Simd::Set(origin.y, origin.z);
+
+		const double* src = positions[0].v;
+		float* dst = out[0].v;
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4, src += 12, dst += 12) {
+			Simd::Double2 d0 = Simd::Sub(Simd::LoadUnaligned(src + 0), originXY);
+			Simd::Double2 d1 = Simd::Sub(Simd::LoadUnaligned(src + 2), originZX);
+			Simd::Double2 d2 = Simd::Sub(Simd::LoadUnaligned(src + 4), originYZ);
+			Simd::Double2 d3 = Simd::Sub(Simd::LoadUnaligned(src + 6), originXY);
+			Simd::Double2 d4 = Simd::Sub(Simd::LoadUnaligned(src + 8), originZX);
+			Simd::Double2 d5 = Simd::Sub(Simd::LoadUnaligned(src + 10), originYZ);
+
+			Simd::StoreUnaligned(dst + 0, Simd::ToFloat4(d0, d1));
+			Simd::StoreUnaligned(dst + 4, Simd::ToFloat4(d2, d3));
+			Simd::StoreUnaligned(dst + 8, Simd::ToFloat4(d4, d5));
+		}
+		for (; i < count; i++) {
+			out[i] = Rebase(positions[i], origin);
+		}
+	}
+}
@@ -0,0 +1,363 @@
+#pragma once
+#include "Vector3.h"
+#include "VectorStream.h"
+#include "Half.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace MathClasses
+{
+	/**
+	 * A 3D vector stored as three 16-bit integers, each counting steps
+	 * across a QuantisationBox. Six bytes instead of Vector3's twelve.
+	 */
+	using Vector3q16 = VectorN<uint16_t, 3>;
+
+	/**
+	 * The range that Vector3q16 values are quantised against. Each axis of
+	 * the box is split into 65535 even steps, so precision is the box
+	 * extent divided by 65535; keep boxes tight around the data.
+	 */
+	struct QuantisationBox
+	{
+		static constexpr float Steps = 65535.0f;
+
+		Vector3 min;
+		Vector3 step;
+		Vector3 inverseStep;
+
+		QuantisationBox() : QuantisationBox(Vector3(0, 0, 0), Vector3(1, 1, 1)) {}
+
+		/**
+		 * @param inMin The smallest corner of the box.
+		 * @param inMax The largest corner of the box.
+		 */
+		QuantisationBox(Vector3 inMin, Vector3 inMax) : min(inMin) {
+			for (int i = 0; i < 3; i++) {
+				float extent = inMax[i] - inMin[i];
+				step[i] = extent / Steps;
+				inverseStep[i] = extent > 0 ? Steps / extent : 0.0f;
+			}
+		}
+
+		/**
+		 * Returns the nearest quantised point. Points outside the box are
+		 * clamped to its surface.
+		 */
+		Vector3q16 Pack(Vector3 v) const {
+			return { Quantise(v.x, min.x, inverseStep.x), Quantise(v.y, min.y, inverseStep.y), Quantise(v.z, min.z, inverseStep.z) };
+		}
+
+		Vector3 Unpack(Vector3q16 q) const {
+			return { min.x + (float)q.x * step.x, min.y + (float)q.y * step.y, min.z + (float)q.z * step.z };
+		}
+
+		static uint16_t Quantise(float value, float min, float inverseStep) {
+			float scaled = std::min(std::max((value - min) * inverseStep, 0.0f), Steps);
+			return (uint16_t)(scaled + 0.5f);
+		}
+	};
+
+	/**
+	 * A unit vector in 4 bytes, a third of a Vector3: the direction is
+	 * projected onto an octahedron, which is unfolded into a square and
+	 * stored as two 16-bit signed normalised coordinates. The decoded
+	 * direction is within 0.04 degrees of the original.
+	 */
+	struct OctahedralNormal
+	{
+		static constexpr float Scale = 32767.0f;
+
+		int16_t u, v;
+
+		/**
+		 * Encodes a direction. The input does not need to be normalised,
+		 * but must not be zero.
+		 */
+		static OctahedralNormal Encode(Vector3 n) {
+			float inverse = 1.0f / std::max((std::abs(n.x) + std::abs(n.y)) + std::abs(n.z), FLT_MIN);
+			float px = n.x * inverse;
+			float py = n.y * inverse;
+			if (n.z < 0) {
+				// fold the lower half over the diagonals
+				float fx = std::copysign(1.0f - std::abs(py), px);
+				float fy = std::copysign(1.0f - std::abs(px), py);
+				px = fx;
+				py = fy;
+			}
+			return { Snorm(px), Snorm(py) };
+		}
+
+		/**
+		 * Returns the encoded direction as a unit vector.
+		 */
+		Vector3 Decode() const {
+			float x = (float)u * (1.0f / Scale);
+			float y = (float)v * (1.0f / Scale);
+			float z = (1.0f - std::abs(x)) - std::abs(y);
+			float t = std::max(-z, 0.0f);
+			x -= std::copysign(t, x);
+			y -= std::copysign(t, y);
+			float inverse = 1.0f / std::sqrt(((x * x) + (y * y)) + (z * z));
+			return { x * inverse, y * inverse, z * inverse };
+		}
+
+		bool operator ==(const OctahedralNormal& rhs) const { return u == rhs.u && v == rhs.v; }
+		bool operator !=(const OctahedralNormal& rhs) const { return !(*this == rhs); }
+
+	private:
+		static int16_t Snorm(float value) {
+			return (int16_t)(value * Scale + std::copysign(0.5f, value));
+		}
+	};
+
+	static_assert(sizeof(Vector3q16) == 6 && sizeof(OctahedralNormal) == 4, "packed vectors must not be padded");
+
+	namespace Detail
+	{
+		/**
+		 * Four-lane version of Half::FromFloat, giving the same bits.
+		 */
+		inline Simd::Int4 FloatToHalfBits(Simd::Float4 value)
+		{
+			using namespace Simd;
+			Int4 f = AsInt(value);
+			Int4 magnitude = And(f, SplatInt(0x7FFFFFFF));
+			Int4 sign = ShiftRight<16>(And(f, SplatInt((int32_t)0x80000000u)));
+
+			Int4 isNaN = CmpGt(magnitude, SplatInt(0x7F800000));
+			Int4 overflows = CmpGt(magnitude, SplatInt(0x477FEFFF));
+			Int4 isSubnormal = CmpGt(SplatInt(0x38800000), magnitude);
+
+			Int4 special = Select(isNaN, SplatInt(0x7E00), SplatInt(0x7C00));
+			Int4 subnormal = Sub(AsInt(Add(AsFloat(magnitude), Splat(0.5f))), SplatInt(0x3F000000));
+			Int4 odd = And(ShiftRight<13>(magnitude), SplatInt(1));
+			Int4 normal = ShiftRight<13>(Add(Add(magnitude, SplatInt((int32_t)0xC8000FFFu)), odd));
+
+			return Or(sign, Select(overflows, special, Select(isSubnormal, subnormal, normal)));
+		}
+
+		/**
+		 * Four-lane version of Half::ToFloat. Each lane holds one Half in
+		 * its low 16 bits.
+		 */
+		inline Simd::Float4 HalfBitsToFloat(Simd::Int4 bits)
+		{
+			using namespace Simd;
+			Int4 sign = ShiftLeft<16>(And(bits, SplatInt(0x8000)));
+			Int4 exponent = And(bits, SplatInt(0x7C00));
+			Int4 shifted = ShiftLeft<13>(And(bits, SplatInt(0x7FFF)));
+
+			Int4 normal = Add(shifted, SplatInt(112 << 23));
+			Int4 special = Add(shifted, SplatInt(224 << 23));
+			// a subnormal's mantissa is read as the fraction of a float
+			// whose exponent makes its leading one worth 2^-14, then the
+			// leading one is subtracted
+			Int4 subnormal = AsInt(Sub(AsFloat(Add(shifted, SplatInt(113 << 23))), AsFloat(SplatInt(113 << 23))));
+
+			Int4 result = Select(CmpEq(exponent, SplatInt(0x7C00)), special, Select(CmpEq(exponent, SplatInt(0)), subnormal, normal));
+			return AsFloat(Or(result, sign));
+		}
+
+		inline Simd::Float4 CopySign(Simd::Float4 magnitude, Simd::Float4 sign)
+		{
+			const Simd::Float4 signBit = Simd::Splat(-0.0f);
+			return Simd::Or(Simd::AndNot(signBit, magnitude), Simd::And(signBit, sign));
+		}
+	}
+
+	/*
+	 * Bulk conversion between Vector3Stream and packed arrays, four vectors
+	 * per iteration. The half conversions work on the bits and always match
+	 * the scalar ones. The others do the same float operations in the same
+	 * order, but a compiler allowed to fuse multiplies and adds (GCC or
+	 * Clang with -ffp-contract=fast, for example) may round the two paths
+	 * differently, moving a packed value by one step.
+	 */
+	namespace Packing
+	{
+		/**
+		 * Converts every vector in the stream to half precision.
+		 *
+		 * @param in The vectors to pack.
+		 * @param out Destination holding at least in.Size() vectors.
+		 */
+		inline void Pack(const Vector3Stream& in, Vector3h* out)
+		{
+			const size_t count = in.Size();
+			const float* x = in.x.data();
+			const float* y = in.y.data();
+			const float* z = in.z.data();
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				alignas(16) int32_t hx[4], hy[4], hz[4];
+				Simd::StoreUnaligned(hx, Detail::FloatToHalfBits(Simd::LoadUnaligned(x + i)));
+				Simd::StoreUnaligned(hy, Detail::FloatToHalfBits(Simd::LoadUnaligned(y + i)));
+				Simd::StoreUnaligned(hz, Detail::FloatToHalfBits(Simd::LoadUnaligned(z + i)));
+				for (size_t j = 0; j < 4; j++) {
+					out[i + j] = { Half::FromBits((uint16_t)hx[j]), Half::FromBits((uint16_t)hy[j]), Half::FromBits((uint16_t)hz[j]) };
+				}
+			}
+			for (; i < count; i++) {
+				out[i] = { Half(x[i]), Half(y[i]), Half(z[i]) };
+			}
+		}
+
+		/**
+		 * Expands half-precision vectors into a stream, resizing it to count.
+		 */
+		inline void Unpack(const Vector3h* in, size_t count, Vector3Stream& out)
+		{
+			out.Resize(count);
+			float* x = out.x.data();
+			float* y = out.y.data();
+			float* z = out.z.data();
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const Vector3h* p = in + i;
+				Simd::StoreUnaligned(x + i, Detail::HalfBitsToFloat(Simd::SetInt(p[0].x.bits, p[1].x.bits, p[2].x.bits, p[3].x.bits)));
+				Simd::StoreUnaligned(y + i, Detail::HalfBitsToFloat(Simd::SetInt(p[0].y.bits, p[1].y.bits, p[2].y.bits, p[3].y.bits)));
+				Simd::StoreUnaligned(z + i, Detail::HalfBitsToFloat(Simd::SetInt(p[0].z.bits, p[1].z.bits, p[2].z.bits, p[3].z.bits)));
+			}
+			for (; i < count; i++) {
+				x[i] = in[i].x;
+				y[i] = in[i].y;
+				z[i] = in[i].z;
+			}
+		}
+
+		/**
+		 * Quantises every vector in the stream against a box. See
+		 * QuantisationBox::Pack.
+		 *
+		 * @param in The vectors to pack.
+		 * @param box The range to quantise against.
+		 * @param out Destination holding at least in.Size() vectors.
+		 */
+		inline void Pack(const Vector3Stream& in, const QuantisationBox& box, Vector3q16* out)
+		{
+			const size_t count = in.Size();
+			const float* components[3] = { in.x.data(), in.y.data(), in.z.data() };
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				alignas(16) int32_t q[3][4];
+				for (int axis = 0; axis < 3; axis++) {
+					Simd::Float4 scaled = Simd::Mul(Simd::Sub(Simd::LoadUnaligned(components[axis] + i), Simd::Splat(box.min[axis])), Simd::Splat(box.inverseStep[axis]));
+					scaled = Simd::Min(Simd::Max(scaled, Simd::Zero()), Simd::Splat(QuantisationBox::Steps));
+					Simd::StoreUnaligned(q[axis], Simd::ConvertToInt(Simd::Add(scaled, Simd::Splat(0.5f))));
+				}
+				for (size_t j = 0; j < 4; j++) {
+					out[i + j] = { (uint16_t)q[0][j], (uint16_t)q[1][j], (uint16_t)q[2][j] };
+				}
+			}
+			for (; i < count; i++) {
+				out[i] = box.Pack({ components[0][i], components[1][i], components[2][i] });
+			}
+		}
+
+		/**
+		 * Expands quantised vectors into a stream, resizing it to count.
+		 */
+		inline void Unpack(const Vector3q16* in, size_t count, const QuantisationBox& box, Vector3Stream& out)
+		{
+			out.Resize(count);
+			float* components[3] = { out.x.data(), out.y.data(), out.z.data() };
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const Vector3q16* p = in + i;
+				for (int axis = 0; axis < 3; axis++) {
+					Simd::Float4 q = Simd::ConvertToFloat(Simd::SetInt(p[0][axis], p[1][axis], p[2][axis], p[3][axis]));
+					Simd::StoreUnaligned(components[axis] + i, Simd::Add(Simd::Splat(box.min[axis]), Simd::Mul(q, Simd::Splat(box.step[axis]))));
+				}
+			}
+			for (; i < count; i++) {
+				Vector3 v = box.Unpack(in[i]);
+				components[0][i] = v.x;
+				components[1][i] = v.y;
+				components[2][i] = v.z;
+			}
+		}
+
+		/**
+		 * Encodes every direction in the stream. See OctahedralNormal::Encode.
+		 *
+		 * @param in The directions to pack.
+		 * @param out Destination holding at least in.Size() normals.
+		 */
+		inline void PackNormals(const Vector3Stream& in, OctahedralNormal* out)
+		{
+			const size_t count = in.Size();
+			const Simd::Float4 one = Simd::Splat(1.0f);
+			const Simd::Float4 half = Simd::Splat(0.5f);
+			const Simd::Float4 scale = Simd::Splat(OctahedralNormal::Scale);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 x = Simd::LoadUnaligned(in.x.data() + i);
+				Simd::Float4 y = Simd::LoadUnaligned(in.y.data() + i);
+				Simd::Float4 z = Simd::LoadUnaligned(in.z.data() + i);
+
+				Simd::Float4 length = Simd::Add(Simd::Add(Simd::Abs(x), Simd::Abs(y)), Simd::Abs(z));
+				Simd::Float4 inverse = Simd::Div(one, Simd::Max(length, Simd::Splat(FLT_MIN)));
+				Simd::Float4 px = Simd::Mul(x, inverse);
+				Simd::Float4 py = Simd::Mul(y, inverse);
+
+				Simd::Float4 lower = Simd::CmpLt(z, Simd::Zero());
+				Simd::Float4 fx = Detail::CopySign(Simd::Sub(one, Simd::Abs(py)), px);
+				Simd::Float4 fy = Detail::CopySign(Simd::Sub(one, Simd::Abs(px)), py);
+				px = Simd::Select(lower, fx, px);
+				py = Simd::Select(lower, fy, py);
+
+				alignas(16) int32_t u[4], v[4];
+				Simd::StoreUnaligned(u, Simd::ConvertToInt(Simd::Add(Simd::Mul(px, scale), Detail::CopySign(half, px))));
+				Simd::StoreUnaligned(v, Simd::ConvertToInt(Simd::Add(Simd::Mul(py, scale), Detail::CopySign(half, py))));
+				for (size_t j = 0; j < 4; j++) {
+					out[i + j] = { (int16_t)u[j], (int16_t)v[j] };
+				}
+			}
+			for (; i < count; i++) {
+				out[i] = OctahedralNormal::Encode(in.Get(i));
+			}
+		}
+
+		/**
+		 * Decodes normals into a stream of unit vectors, resizing it to count.
+		 */
+		inline void UnpackNormals(const OctahedralNormal* in, size_t count, Vector3Stream& out)
+		{
+			out.Resize(count);
+			const Simd::Float4 one = Simd::Splat(1.0f);
+			const Simd::Float4 inverseScale = Simd::Splat(1.0f / OctahedralNormal::Scale);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const OctahedralNormal* p = in + i;
+				Simd::Float4 x = Simd::Mul(Simd::ConvertToFloat(Simd::SetInt(p[0].u, p[1].u, p[2].u, p[3].u)), inverseScale);
+				Simd::Float4 y = Simd::Mul(Simd::ConvertToFloat(Simd::SetInt(p[0].v, p[1].v, p[2].v, p[3].v)), inverseScale);
+				Simd::Float4 z = Simd::Sub(Simd::Sub(one, Simd::Abs(x)), Simd::Abs(y));
+
+				Simd::Float4 t = Simd::Max(Simd::Neg(z), Simd::Zero());
+				x = Simd::Sub(x, Detail::CopySign(t, x));
+				y = Simd::Sub(y, Detail::CopySign(t, y));
+
+				Simd::Float4 lengthSqr = Simd::Add(Simd::Add(Simd::Mul(x, x), Simd::Mul(y, y)), Simd::Mul(z, z));
+				Simd::Float4 inverse = Simd::Div(one, Simd::Sqrt(lengthSqr));
+				Simd::StoreUnaligned(out.x.data() + i, Simd::Mul(x, inverse));
+				Simd::StoreUnaligned(out.y.data() + i, Simd::Mul(y, inverse));
+				Simd::StoreUnaligned(out.z.data() + i, Simd::Mul(z, inverse));
+			}
+			for (; i < count; i++) {
+				out.Set(i, in[i].Decode());
+			}
+		}
+	}
+}
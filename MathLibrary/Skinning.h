@@ -0,0 +1,227 @@
+#pragma once
+#include "Matrix4.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace MathClasses
+{
+	/**
+	 * The bone influences of a set of vertices, as structure-of-arrays: for
+	 * each of the four influence slots k, bone[k][i] indexes the palette
+	 * and weight[k][i] scales that bone's contribution to vertex i.
+	 *
+	 * A vertex's weights should sum to one. Vertices with fewer than four
+	 * influences give the unused slots a weight of zero, and skinning skips
+	 * them. The first slot is always read, so its bone index must be valid.
+	 */
+	struct SkinWeightStream
+	{
+		static constexpr size_t MaxInfluences = 4;
+
+		std::array<std::vector<uint16_t>, MaxInfluences> bone;
+		std::array<std::vector<float>, MaxInfluences> weight;
+
+		SkinWeightStream() {}
+		explicit SkinWeightStream(size_t count) { Resize(count); }
+
+		size_t Size() const { return bone[0].size(); }
+
+		void Resize(size_t count) {
+			for (size_t k = 0; k < MaxInfluences; k++) { bone[k].resize(count); weight[k].resize(count); }
+		}
+
+		void Reserve(size_t count) {
+			for (size_t k = 0; k < MaxInfluences; k++) { bone[k].reserve(count); weight[k].reserve(count); }
+		}
+
+		void Clear() {
+			for (size_t k = 0; k < MaxInfluences; k++) { bone[k].clear(); weight[k].clear(); }
+		}
+
+		void PushBack(const std::array<uint16_t, MaxInfluences>& bones, const std::array<float, MaxInfluences>& weights) {
+			for (size_t k = 0; k < MaxInfluences; k++) { bone[k].push_back(bones[k]); weight[k].push_back(weights[k]); }
+		}
+	};
+
+	/*
+	 * Linear blend skinning against a palette of bone matrices, each the
+	 * bone's current transform multiplied by its inverse bind pose.
+	 *
+	 * Each vertex blends its bone matrices column by column in SIMD
+	 * registers, so the palette is read one whole column per load rather
+	 * than gathered element by element across vertices. Four vertices are
+	 * blended per iteration and transposed back into the output streams.
+	 *
+	 * Normals are transformed by the blended upper 3x3 and renormalised,
+	 * which is exact for rotation and uniform scale; palettes with
+	 * non-uniform scale bend normals slightly.
+	 */
+	namespace Skinning
+	{
+		namespace Detail
+		{
+			/**
+			 * Blends the palette matrices of vertex i and transforms its
+			 * position (with w = 1) and normal (with w = 0).
+			 */
+			inline void SkinVertex(const Matrix4* palette, const SkinWeightStream& influences, size_t i,
+								   Vector3 position, Vector3 normal, Simd::Float4& outPosition, Simd::Float4& outNormal)
+			{
+				Simd::Float4 cols[4];
+				{
+					const Matrix4& m = palette[influences.bone[0][i]];
+					Simd::Float4 w = Simd::Splat(influences.weight[0][i]);
+					for (size_t c = 0; c < 4; c++) { cols[c] = Simd::Mul(m.cols[c], w); }
+				}
+				for (size_t k = 1; k < SkinWeightStream::MaxInfluences; k++) {
+					float weight = influences.weight[k][i];
+					if (weight == 0) { continue; }
+					const Matrix4& m = palette[influences.bone[k][i]];
+					Simd::Float4 w = Simd::Splat(weight);
+					for (size_t c = 0; c < 4; c++) { cols[c] = Simd::MulAdd(m.cols[c], w, cols[c]); }
+				}
+
+				Simd::Float4 n = Simd::Mul(cols[0], Simd::Splat(normal.x));
+				n = Simd::MulAdd(cols[1], Simd::Splat(normal.y), n);
+				outNormal = Simd::MulAdd(cols[2], Simd::Splat(normal.z), n);
+
+				Simd::Float4 p = Simd::MulAdd(cols[0], Simd::Splat(position.x), cols[3]);
+				p = Simd::MulAdd(cols[1], Simd::Splat(position.y), p);
+				outPosition = Simd::MulAdd(cols[2], Simd::Splat(position.z), p);
+			}
+
+			inline void StoreNormalised(Simd::Float4 x, Simd::Float4 y, Simd::Float4 z, Vector3Stream& out, size_t i)
+			{
+				Simd::Float4 length = Simd::Sqrt(Simd::MulAdd(z, z, Simd::MulAdd(y, y, Simd::Mul(x, x))));
+				Simd::StoreUnaligned(out.x.data() + i, Simd::Div(x, length));
+				Simd::StoreUnaligned(out.y.data() + i, Simd::Div(y, length));
+				Simd::StoreUnaligned(out.z.data() + i, Simd::Div(z, length));
+			}
+		}
+
+		/**
+		 * Skins vertices [begin, end). The output streams must already hold
+		 * at least end vertices, and may not be the input streams.
+		 *
+		 * @param palette The bone matrices indexed by influences.bone.
+		 * @param influences The bone indices and weights of every vertex.
+		 * @param positions The bind-pose positions.
+		 * @param normals The bind-pose normals.
+		 * @param outPositions Destination for the skinned positions.
+		 * @param outNormals Destination for the skinned, unit-length normals.
+		 * @param begin The first vertex to skin.
+		 * @param end One past the last vertex to skin.
+		 */
+		inline void SkinRange(const Matrix4* palette, const SkinWeightStream& influences,
+							  const Vector3Stream& positions, const Vector3Stream& normals,
+							  Vector3Stream& outPositions, Vector3Stream& outNormals, size_t begin, size_t end)
+		{
+			assert(end <= influences.Size() && end <= positions.Size() && end <= normals.Size());
+			assert(end <= outPositions.Size() && end <= outNormals.Size());
+
+			size_t i = begin;
+			for (; i + 4 <= end; i += 4) {
+				Simd::Float4 p[4], n[4];
+				for (size_t j = 0; j < 4; j++) {
+					Detail::SkinVertex(palette, influences, i + j, positions.Get(i + j), normals.Get(i + j), p[j], n[j]);
+				}
+
+				Simd::Transpose(p[0], p[1], p[2], p[3]);
+				Simd::StoreUnaligned(outPositions.x.data() + i, p[0]);
+				Simd::StoreUnaligned(outPositions.y.data() + i, p[1]);
+				Simd::StoreUnaligned(outPositions.z.data() + i, p[2]);
+
+				Simd::Transpose(n[0], n[1], n[2], n[3]);
+				Detail::StoreNormalised(n[0], n[1], n[2], outNormals, i);
+			}
+			for (; i < end; i++) {
+				Simd::Float4 p, n;
+				Detail::SkinVertex(palette, influences, i, positions.Get(i), normals.Get(i), p, n);
+
+				alignas(16) float lanes[4];
+				Simd::Store(lanes, p);
+				outPositions.Set(i, { lanes[0], lanes[1], lanes[2] });
+				Simd::Store(lanes, n);
+				float length = std::sqrt(lanes[2] * lanes[2] + (lanes[1] * lanes[1] + lanes[0] * lanes[0]));
+				outNormals.Set(i, { lanes[0] / length, lanes[1] / length, lanes[2] / length });
+			}
+		}
+
+		/**
+		 * Skins every vertex on the calling thread, resizing the outputs to
+		 * match. See SkinRange().
+		 */
+		inline void Skin(const Matrix4* palette, const SkinWeightStream& influences,
+						 const Vector3Stream& positions, const Vector3Stream& normals,
+						 Vector3Stream& outPositions, Vector3Stream& outNormals)
+		{
+			outPositions.Resize(positions.Size());
+			outNormals.Resize(positions.Size());
+			SkinRange(palette, influences, positions, normals, outPositions, outNormals, 0, positions.Size());
+		}
+
+		/**
+		 * Skins every vertex across several threads, with the same results
+		 * as Skin(). Threads take chunks of vertices from a shared counter,
+		 * so uneven progress balances itself, and chunk boundaries are
+		 * multiples of four so every full group runs the SIMD path. If a
+		 * thread cannot be started, the calling thread does its share.
+		 *
+		 * @param chunkSize The number of vertices per chunk, rounded up to a multiple of four.
+		 * @param threadCount The number of threads including the caller, or 0 for one per hardware thread.
+		 */
+		inline void SkinParallel(const Matrix4* palette, const SkinWeightStream& influences,
+								 const Vector3Stream& positions, const Vector3Stream& normals,
+								 Vector3Stream& outPositions, Vector3Stream& outNormals,
+								 size_t chunkSize = 4096, unsigned threadCount = 0)
+		{
+			const size_t count = positions.Size();
+			outPositions.Resize(count);
+			outNormals.Resize(count);
+
+			chunkSize = std::max<size_t>((chunkSize + 3) & ~size_t(3), 4);
+			const size_t chunks = (count + chunkSize - 1) / chunkSize;
+			if (threadCount == 0) {
+				threadCount = std::max(1u, std::thread::hardware_concurrency());
+			}
+			threadCount = (unsigned)std::min<size_t>(threadCount, chunks);
+			if (threadCount <= 1) {
+				SkinRange(palette, influences, positions, normals, outPositions, outNormals, 0, count);
+				return;
+			}
+
+			std::atomic<size_t> next{ 0 };
+			auto work = [&] {
+				for (size_t chunk = next++; chunk < chunks; chunk = next++) {
+					size_t begin = chunk * chunkSize;
+					SkinRange(palette, influences, positions, normals, outPositions, outNormals, begin, std::min(begin + chunkSize, count));
+				}
+			};
+
+			std::vector<std::thread> workers;
+			workers.reserve(threadCount - 1);
+			try {
+				for (unsigned t = 1; t < threadCount; t++) {
+					workers.emplace_back(work);
+				}
+			} catch (...) {
+				// out of threads; the workers already started and this thread share the chunks left
+			}
+			work();
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+	}
+}
@@ -1,6 +1,9 @@
 #pragma once
+#include "Precision.h"
+#include "Simd.h"
 
 #include <cmath>
+#include <cstddef>
 
 namespace MathClasses
 {
@@ -23,18 +26,278 @@ namespace MathClasses
 		return std::abs(a - b) < Threshold;
 	}
 
+	template<Precision P = DefaultPrecision>
 	inline float AngleFrom2D(float x, float y)
 	{
-		return atan2(y, x);
+		return Atan2<P>(y, x);
 	}
 
 	template<typename T, typename A>
-	T Lerp(const T& Start, const T& End, const A& Alpha)
+	constexpr T Lerp(const T& Start, const T& End, const A& Alpha)
 	{
 		T Dist = End - Start;
 		return Start + Dist * Alpha;
 	}
 
+	/**
+	 * The inverse of Lerp: how far value lies from start towards end, where
+	 * 0 is start and 1 is end. The result is not clamped.
+	 */
+	template<typename T>
+	constexpr T InverseLerp(const T& start, const T& end, const T& value)
+	{
+		return (value - start) / (end - start);
+	}
+
+	/**
+	 * Hermite interpolation from 0 to 1 as value moves from edge0 to edge1,
+	 * clamped to 0 and 1 outside the edges. When edge0 equals edge1 it is a
+	 * step: 0 at or below the edge and 1 above it.
+	 */
+	template<typename T>
+	constexpr T SmoothStep(const T& edge0, const T& edge1, const T& value)
+	{
+		T t = InverseLerp(edge0, edge1, value);
+		// written so the 0 / 0 from value == edge0 == edge1 clamps to 0
+		t = t > T(0) ? (t < T(1) ? t : T(1)) : T(0);
+		return t * t * (T(3) - T(2) * t);
+	}
+
+	/**
+	 * Maps value from the range [inStart, inEnd] onto [outStart, outEnd].
+	 * The result is not clamped.
+	 */
+	template<typename T>
+	constexpr T Remap(const T& inStart, const T& inEnd, const T& outStart, const T& outEnd, const T& value)
+	{
+		return Lerp(outStart, outEnd, InverseLerp(inStart, inEnd, value));
+	}
+
+	/*
+	 * Easing curves that map t in [0, 1] to [0, 1], for tweening.
+	 *
+	 * Each curve is a type with a scalar Apply and a four-wide Apply that
+	 * gives identical results, so one curve can be evaluated per call or
+	 * over a whole array with EaseArray<Curve>(). Input outside [0, 1] is
+	 * not clamped.
+	 */
+	namespace Easing
+	{
+		struct Linear
+		{
+			static float Apply(float t) { return t; }
+			static Simd::Float4 Apply(Simd::Float4 t) { return t; }
+		};
+
+		struct InQuad
+		{
+			static float Apply(float t) { return t * t; }
+			static Simd::Float4 Apply(Simd::Float4 t) { return Simd::Mul(t, t); }
+		};
+
+		struct OutQuad
+		{
+			static float Apply(float t)
+			{
+				float u = 1.0f - t;
+				return 1.0f - u * u;
+			}
+
+			static Simd::Float4 Apply(Simd::Float4 t)
+			{
+				const Simd::Float4 one = Simd::Splat(1.0f);
+				Simd::Float4 u = Simd::Sub(one, t);
+				return Simd::Sub(one, Simd::Mul(u, u));
+			}
+		};
+
+		struct InOutQuad
+		{
+			static float Apply(float t)
+			{
+				float u = 1.0f - t;
+				return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * u * u;
+			}
+
+			static Simd::Float4 Apply(Simd::Float4 t)
+			{
+				const Simd::Float4 one = Simd::Splat(1.0f), two = Simd::Splat(2.0f);
+				Simd::Float4 u = Simd::Sub(one, t);
+				Simd::Float4 in = Simd::Mul(Simd::Mul(two, t), t);
+				Simd::Float4 out = Simd::Sub(one, Simd::Mul(Simd::Mul(two, u), u));
+				return Simd::Select(Simd::CmpLt(t, Simd::Splat(0.5f)), in, out);
+			}
+		};
+
+		struct InCubic
+		{
+			static float Apply(float t) { return t * t * t; }
+			static Simd::Float4 Apply(Simd::Float4 t) { return Simd::Mul(Simd::Mul(t, t), t); }
+		};
+
+		struct OutCubic
+		{
+			static float Apply(float t)
+			{
+				float u = 1.0f - t;
+				return 1.0f - u * u * u;
+			}
+
+			static Simd::Float4 Apply(Simd::Float4 t)
+			{
+				const Simd::Float4 one = Simd::Splat(1.0f);
+				Simd::Float4 u = Simd::Sub(one, t);
+				return Simd::Sub(one, Simd::Mul(Simd::Mul(u, u), u));
+			}
+		};
+
+		struct InOutCubic
+		{
+			static float Apply(float t)
+			{
+				float u = 1.0f - t;
+				return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+			}
+
+			static Simd::Float4 Apply(Simd::Float4 t)
+			{
+				const Simd::Float4 one = Simd::Splat(1.0f), four = Simd::Splat(4.0f);
+				Simd::Float4 u = Simd::Sub(one, t);
+				Simd::Float4 in = Simd::Mul(Simd::Mul(Simd::Mul(four, t), t), t);
+				Simd::Float4 out = Simd::Sub(one, Simd::Mul(Simd::Mul(Simd::Mul(four, u), u), u));
+				return Simd::Select(Simd::CmpLt(t, Simd::Splat(0.5f)), in, out);
+			}
+		};
+
+		/**
+		 * t * t * (3 - 2t), the curve SmoothStep uses between its edges.
+		 */
+		struct SmoothStep
+		{
+			static float Apply(float t) { return t * t * (3.0f - 2.0f * t); }
+
+			static Simd::Float4 Apply(Simd::Float4 t)
+			{
+				Simd::Float4 slope = Simd::Sub(Simd::Splat(3.0f), Simd::Mul(Simd::Splat(2.0f), t));
+				return Simd::Mul(Simd::Mul(t, t), slope);
+			}
+		};
+
+		/**
+		 * Overshoots past 1 by about 10% before settling.
+		 */
+		struct OutBack
+		{
+			static constexpr float Overshoot = 1.70158f;
+
+			static float Apply(float t)
+			{
+				float u = t - 1.0f;
+				return 1.0f + (Overshoot + 1.0f) * u * u * u + Overshoot * u * u;
+			}
+
+			static Simd::Float4 Apply(Simd::Float4 t)
+			{
+				Simd::Float4 u = Simd::Sub(t, Simd::Splat(1.0f));
+				Simd::Float4 cubic = Simd::Mul(Simd::Mul(Simd::Mul(Simd::Splat(Overshoot + 1.0f), u), u), u);
+				Simd::Float4 square = Simd::Mul(Simd::Mul(Simd::Splat(Overshoot), u), u);
+				return Simd::Add(Simd::Add(Simd::Splat(1.0f), cubic), square);
+			}
+		};
+	}
+
+	/*
+	 * Array versions of the interpolation helpers above, for animating
+	 * thousands of values at once.
+	 *
+	 * Each processes four elements per iteration in a SIMD register and
+	 * finishes the remainder with the scalar function, giving the same
+	 * results as calling the scalar function per element. None require
+	 * aligned input, and the output may alias an input.
+	 */
+
+	/**
+	 * out[i] = Lerp(start[i], end[i], alpha[i])
+	 */
+	inline void LerpArray(const float* start, const float* end, const float* alpha, float* out, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			Simd::Float4 s = Simd::LoadUnaligned(start + i);
+			Simd::Float4 dist = Simd::Sub(Simd::LoadUnaligned(end + i), s);
+			Simd::StoreUnaligned(out + i, Simd::Add(s, Simd::Mul(dist, Simd::LoadUnaligned(alpha + i))));
+		}
+		for (; i < count; i++) {
+			out[i] = Lerp(start[i], end[i], alpha[i]);
+		}
+	}
+
+	/**
+	 * out[i] = InverseLerp(start, end, value[i])
+	 */
+	inline void InverseLerpArray(float start, float end, const float* value, float* out, size_t count)
+	{
+		const Simd::Float4 s = Simd::Splat(start), range = Simd::Splat(end - start);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			Simd::StoreUnaligned(out + i, Simd::Div(Simd::Sub(Simd::LoadUnaligned(value + i), s), range));
+		}
+		for (; i < count; i++) {
+			out[i] = InverseLerp(start, end, value[i]);
+		}
+	}
+
+	/**
+	 * out[i] = SmoothStep(edge0, edge1, value[i])
+	 */
+	inline void SmoothStepArray(float edge0, float edge1, const float* value, float* out, size_t count)
+	{
+		const Simd::Float4 e0 = Simd::Splat(edge0), range = Simd::Splat(edge1 - edge0);
+		const Simd::Float4 zero = Simd::Zero(), one = Simd::Splat(1.0f);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			Simd::Float4 t = Simd::Div(Simd::Sub(Simd::LoadUnaligned(value + i), e0), range);
+			// a select rather than Max, so NaN clamps to 0 on every backend as it does in SmoothStep
+			t = Simd::Min(Simd::Select(Simd::CmpGt(t, zero), t, zero), one);
+			Simd::StoreUnaligned(out + i, Easing::SmoothStep::Apply(t));
+		}
+		for (; i < count; i++) {
+			out[i] = SmoothStep(edge0, edge1, value[i]);
+		}
+	}
+
+	/**
+	 * out[i] = Remap(inStart, inEnd, outStart, outEnd, value[i])
+	 */
+	inline void RemapArray(float inStart, float inEnd, float outStart, float outEnd, const float* value, float* out, size_t count)
+	{
+		const Simd::Float4 s = Simd::Splat(inStart), inRange = Simd::Splat(inEnd - inStart);
+		const Simd::Float4 o = Simd::Splat(outStart), outRange = Simd::Splat(outEnd - outStart);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			Simd::Float4 t = Simd::Div(Simd::Sub(Simd::LoadUnaligned(value + i), s), inRange);
+			Simd::StoreUnaligned(out + i, Simd::Add(o, Simd::Mul(outRange, t)));
+		}
+		for (; i < count; i++) {
+			out[i] = Remap(inStart, inEnd, outStart, outEnd, value[i]);
+		}
+	}
+
+	/**
+	 * out[i] = Curve::Apply(t[i]), e.g. EaseArray<Easing::OutCubic>(t, out, count).
+	 */
+	template<typename Curve>
+	inline void EaseArray(const float* t, float* out, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			Simd::StoreUnaligned(out + i, Curve::Apply(Simd::LoadUnaligned(t + i)));
+		}
+		for (; i < count; i++) {
+			out[i] = Curve::Apply(t[i]);
+		}
+	}
+
 	/* Constant for Pi
 	 *
 	 * @details Prefer C++ STDLIB
@@ -1,12 +1,35 @@
 #pragma once
 #include "Vector3.h"
-#include "Utils.h"
+#include "VectorN.h"
+#include "Simd.h"
+
+#include <type_traits>
 
 
 namespace MathClasses
 {
-	struct Vector4
+	/**
+	 * A 16-byte aligned 4-component vector stored in a single SIMD register,
+	 * specialising VectorN<float, 4>.
+	 *
+	 * The components remain addressable as x, y, z, w or as an array through
+	 * the union; every arithmetic operation goes through the register.
+	 *
+	 * Constructors initialise x, y, z and w so they can run at compile time.
+	 * Constexpr operations check std::is_constant_evaluated() and use the
+	 * named components there, since the register cannot be read in a
+	 * constant expression.
+	 */
+	using Vector4 = VectorN<float, 4>;
+
+	template<>
+	struct VectorN<float, 4>
 	{
+		using Component = float;
+		using Scalar = float;
+		using Real = float;
+		static constexpr size_t Dimension = 4;
+
 		union
 		{
 			struct
@@ -15,60 +38,83 @@ namespace MathClasses
 			};
 
 			float v[4];
+			Simd::Float4 simd;
 		};
 
-		Vector4() { x = y = z = w = 0; }
+		constexpr VectorN() : x(0), y(0), z(0), w(0) {}
+
+		constexpr VectorN(float inX, float inY, float inZ, float inW)
+			: x(inX), y(inY), z(inZ), w(inW) {}
 
-		Vector4(float inX, float inY, float inZ, float inW) 
-		{ x = inX; y = inY; z = inZ; w = inW; }
+		constexpr VectorN(const Vector3& vec3, float inW = 0)
+			: x(vec3.x), y(vec3.y), z(vec3.z), w(inW) {}
 
-		/* @todo Allow construction from Vector3 */
+		explicit VectorN(Simd::Float4 inSimd) : simd(inSimd) {}
+
+		constexpr operator Vector3() const { return Vector3(x, y, z); }
 
 		/**
 		 * @brief Returns the magnitude of this Vector
 		 * @return The magnitude of this Vector.
 		 */
 		float Magnitude() const {
-			if (w == 0) {
-				return sqrtf((x * x) + (y * y) + (z * z));
-			}
-			return (w * sqrtf((x * x) + (y * y) + (z * z)));
+			return Simd::GetX(Simd::Sqrt(Simd::Dot4(simd, simd)));
 		}
 		
-		float Dot(const Vector4& rhs) const {
-			return ((x * rhs.x) + (y * rhs.y) + (z * rhs.z) + (w * rhs.w));
+		constexpr float Dot(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return (x * rhs.x) + (y * rhs.y) + (z * rhs.z) + (w * rhs.w);
+			}
+			return Simd::GetX(Simd::Dot4(simd, rhs.simd));
 		}
-
-		Vector4 Cross(const Vector4& rhs) const {
-			Vector4 temp = *this;
-			temp.x = (y * temp.z) - (z * temp.y);
-			temp.y = (z * temp.x) - (x * temp.z);
-			temp.z = (x * temp.y) - (y * temp.x);
+		static constexpr float Dot(const Vector4& first, const Vector4& second) {
+			return first.Dot(second);
 		}
 
-		/* @todo static Vector3 Cross(const Vector4& first, const Vector4& second) */
+		/**
+		 * Returns the cross product of the X, Y and Z components. W is
+		 * always zero in the result.
+		 */
+		constexpr Vector4 Cross(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4((y * rhs.z) - (z * rhs.y), (z * rhs.x) - (x * rhs.z), (x * rhs.y) - (y * rhs.x), 0);
+			}
+			return Vector4(Simd::Cross3(simd, rhs.simd));
+		}
+		static constexpr Vector4 Cross(const Vector4& first, const Vector4& second) {
+			return first.Cross(second);
+		}
 
+		/**
+		 * Scales this Vector to unit length. Precision::Fast multiplies by
+		 * the register's reciprocal square root estimate instead of dividing
+		 * by the magnitude.
+		 */
+		template<Precision P = DefaultPrecision>
 		void Normalise() {
-			float mag = this->Magnitude();
-			x = (x / mag) * w; y = (y / mag) * w; z = (z / mag) * w; w = (w / mag) * w;
+			ScaleByInverseMagnitude<P>(Simd::Dot4(simd, simd));
 		}
 
+		template<Precision P = DefaultPrecision>
 		void SafeNormalise() {
-			if (this->Magnitude() != 0) {
-				Normalise();
+			Simd::Float4 magSqr = Simd::Dot4(simd, simd);
+			if (Simd::GetX(magSqr) != 0) {
+				ScaleByInverseMagnitude<P>(magSqr);
 			}
 			return;
 		}
 
+		template<Precision P = DefaultPrecision>
 		Vector4 Normalised() const {
 			Vector4 temp = *this;
-			temp.Normalise();
+			temp.Normalise<P>();
 			return temp;
 		}
 
+		template<Precision P = DefaultPrecision>
 		Vector4 SafeNormalised() const {
 			Vector4 temp = *this;
-			temp.SafeNormalise();
+			temp.SafeNormalise<P>();
 			return temp;
 		}
 
@@ -79,7 +125,12 @@ namespace MathClasses
 		 * @param rhs The other component.
 		 * @return The Vector containing the sums of the components.
 		 */
-		Vector4 operator +(const Vector4& rhs) const;
+		constexpr Vector4 operator +(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+			}
+			return Vector4(Simd::Add(simd, rhs.simd));
+		}
 
 		/**
 		 * Assigns and returns the result of this Vector added to the other
@@ -88,7 +139,12 @@ namespace MathClasses
 		 * @param rhs The other Vector.
 		 * @return The reference to this Vector after addition.
 		 */
-		Vector4& operator +=(const Vector4& rhs);
+		constexpr Vector4& operator +=(const Vector4& rhs) {
+			if (std::is_constant_evaluated()) {
+				return *this = *this + rhs;
+			}
+			simd = Simd::Add(simd, rhs.simd); return *this;
+		}
 
 		/**
 		 * Returns a Vector containing the difference of each component when
@@ -97,7 +153,12 @@ namespace MathClasses
 		 * @param rhs The other component.
 		 * @return The Vector containing the differences of the components.
 		 */
-		Vector4 operator -(const Vector4& rhs) const;
+		constexpr Vector4 operator -(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+			}
+			return Vector4(Simd::Sub(simd, rhs.simd));
+		}
 
 		/**
 		 * Returns a Vector containing the difference of each component when
@@ -106,7 +167,12 @@ namespace MathClasses
 		 * @param rhs The other component.
 		 * @return The Vector containing the differences of the components.
 		 */
-		Vector4& operator -=(const Vector4& rhs);
+		constexpr Vector4& operator -=(const Vector4& rhs) {
+			if (std::is_constant_evaluated()) {
+				return *this = *this - rhs;
+			}
+			simd = Simd::Sub(simd, rhs.simd); return *this;
+		}
 
 		/**
 		 * Assigns and returns this Vector scaled by the scalar value.
@@ -114,7 +180,12 @@ namespace MathClasses
 		 * @param rhs The scalar.
 		 * @return Reference to this Vector after scaling.
 		 */
-		Vector4 operator *(float rhs) const;
+		constexpr Vector4 operator *(float rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(x * rhs, y * rhs, z * rhs, w * rhs);
+			}
+			return Vector4(Simd::Mul(simd, Simd::Splat(rhs)));
+		}
 
 		/* @note (float * Vector4) implemented as a free-function below */
 
@@ -126,7 +197,12 @@ namespace MathClasses
 		 * @param rhs The other Vector.
 		 * @return True if equal, otherwise false.
 		 */
-		Vector4& operator *=(float rhs);
+		constexpr Vector4& operator *=(float rhs) {
+			if (std::is_constant_evaluated()) {
+				return *this = *this * rhs;
+			}
+			simd = Simd::Mul(simd, Simd::Splat(rhs)); return *this;
+		}
 
 		// @note (float * Vector4) implemented as a free-function below
 
@@ -136,7 +212,12 @@ namespace MathClasses
 		 * @param rhs The divisor.
 		 * @return The Vector after division.
 		 */
-		Vector4 operator /(float rhs) const;
+		constexpr Vector4 operator /(float rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(x / rhs, y / rhs, z / rhs, w / rhs);
+			}
+			return Vector4(Simd::Div(simd, Simd::Splat(rhs)));
+		}
 
 		/**
 		 * Assigns and returns this Vector after dividing its components.
@@ -144,7 +225,12 @@ namespace MathClasses
 		 * @param rhs The divisor.
 		 * @return Reference to this Vector after division.
 		 */
-		Vector4 operator /=(float rhs);
+		constexpr Vector4& operator /=(float rhs) {
+			if (std::is_constant_evaluated()) {
+				return *this = *this / rhs;
+			}
+			simd = Simd::Div(simd, Simd::Splat(rhs)); return *this;
+		}
 
 		/**
 		 * Returns true if every component is equal to the other in the other vector
@@ -153,7 +239,12 @@ namespace MathClasses
 		 * @param rhs The other Vector.
 		 * @return True if equal, otherwise false.
 		 */
-		bool operator == (const Vector4& rhs) const;
+		constexpr bool operator == (const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w;
+			}
+			return Simd::AllEqual(simd, rhs.simd);
+		}
 
 		/**
 		 * Returns true if any component is NOT equal to the other in the other vector
@@ -161,7 +252,9 @@ namespace MathClasses
 		 * @param rhs The other Vector.
 		 * @return True if inequal, otherwise false.
 		 */
-		bool operator != (const Vector4& rhs) const;
+		constexpr bool operator != (const Vector4& rhs) const {
+			return !(*this == rhs);
+		}
 
 		/**
 		 * Returns true if every component is approximately equal to the other in the other vector
@@ -171,9 +264,7 @@ namespace MathClasses
 		 * @return True if approximately equal, otherwise false.
 		 */
 		bool Equals(const Vector4& rhs, float Tolerance = MAX_FLOAT_DELTA) const {
-			Vector4 distance = { x - rhs.x,y - rhs.y,z - rhs.z,w - rhs.w };
-			distance.Absolute();
-			return((distance.x < Tolerance) && (distance.y < Tolerance) && (distance.z < Tolerance) && (distance.w < Tolerance));
+			return Simd::AllLess(Simd::Abs(Simd::Sub(simd, rhs.simd)), Simd::Splat(Tolerance));
 		}
 
 		/**
@@ -192,12 +283,16 @@ namespace MathClasses
 		/**
 		* Treats this Vector as an array of floats containing its components.
 		*/
-		operator float* ();
+		operator float* () {
+			return v;
+		}
 
 		/**
 		 * Treats this Vector as an const array of floats containing its components.
 		 */
-		operator const float* () const;
+		operator const float* () const {
+			return v;
+		}
 
 		/**
 		 * Returns a new Vector where each component is multiplied by the component from the other vector
@@ -205,7 +300,12 @@ namespace MathClasses
 		 * @param rhs The other vector.
 		 * @return The Vector with each components multiplied by the component from the other vector.
 		 */
-		Vector4 operator *(const Vector4& rhs) const;
+		constexpr Vector4 operator *(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w);
+			}
+			return Vector4(Simd::Mul(simd, rhs.simd));
+		}
 
 		/**
 		 * Assigns and returns this Vector where each component is multiplied by
@@ -214,7 +314,12 @@ namespace MathClasses
 		 * @param rhs The other Vector.
 		 * @return Reference to this Vector's components multiplied by the component from the other vector.
 		 */
-		Vector4& operator *=(const Vector4& rhs);
+		constexpr Vector4& operator *=(const Vector4& rhs) {
+			if (std::is_constant_evaluated()) {
+				return *this = *this * rhs;
+			}
+			simd = Simd::Mul(simd, rhs.simd); return *this;
+		}
 
 		/**
 		 * Returns a new Vector where each component is divided by the component from the other vector
@@ -222,7 +327,12 @@ namespace MathClasses
 		 * @param The other Vector.
 		 * @return A copy of this Vector's components divided by the component from the other vector.
 		 */
-		Vector4 operator /(const Vector4& rhs) const;
+		constexpr Vector4 operator /(const Vector4& rhs) const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(x / rhs.x, y / rhs.y, z / rhs.z, w / rhs.w);
+			}
+			return Vector4(Simd::Div(simd, rhs.simd));
+		}
 
 		/**
 		 * Assigns and returns this Vector after dividing it by the other vector
@@ -230,7 +340,12 @@ namespace MathClasses
 		 * @param rhs The other vector.
 		 * @return Reference to this Vector's components divided by the component from the other vector.
 		 */
-		Vector4& operator /=(const Vector4& rhs);
+		constexpr Vector4& operator /=(const Vector4& rhs) {
+			if (std::is_constant_evaluated()) {
+				return *this = *this / rhs;
+			}
+			simd = Simd::Div(simd, rhs.simd); return *this;
+		}
 
 		/**
 		 * Returns a copy of this Vector after negating its components.
@@ -238,7 +353,12 @@ namespace MathClasses
 		 * @param rhs The other vector.
 		 * @return A copy of this Vector after negating its components.
 		 */
-		Vector4 operator -() const;
+		constexpr Vector4 operator -() const {
+			if (std::is_constant_evaluated()) {
+				return Vector4(-x, -y, -z, -w);
+			}
+			return Vector4(Simd::Neg(simd));
+		}
 
 		/**
 		 * Returns a reference to one of the components of this Vector when
@@ -247,7 +367,9 @@ namespace MathClasses
 		 * @param dim The index or dimension (X would be 0, Y would be 1...)
 		 * @return Reference to the specified element.
 		 */
-		float& operator [](int dim);
+		float& operator [](int dim) {
+			return v[dim];
+		}
 
 		/**
 		 * Returns a constant reference to one of the components of this Vector when
@@ -256,7 +378,9 @@ namespace MathClasses
 		 * @param dim The index or dimension (X would be 0, Y would be 1...)
 		 * @return Constant reference to the specified element.
 		 */
-		const float& operator [](int dim) const;
+		const float& operator [](int dim) const {
+			return v[dim];
+		}
 
 		/**
 		 * Returns the Squared Magnitude of this Vector.
@@ -266,14 +390,48 @@ namespace MathClasses
 		 *
 		 * @return The squared magnitude of this Vector.
 		 */
-		float MagnitudeSqr() const;
+		constexpr float MagnitudeSqr() const {
+			if (std::is_constant_evaluated()) {
+				return Dot(*this);
+			}
+			return Simd::GetX(Simd::Dot4(simd, simd));
+		}
+
+		float Distance(const Vector4& other) const {
+			Simd::Float4 difference = Simd::Sub(simd, other.simd);
+			return Simd::GetX(Simd::Sqrt(Simd::Dot4(difference, difference)));
+		}
+		constexpr float DistanceSqr(const Vector4& other) const {
+			return (*this - other).MagnitudeSqr();
+		}
+		static float Distance(const Vector4& start, const Vector4& end) {
+			return start.Distance(end);
+		}
+		static constexpr float DistanceSqr(const Vector4& start, const Vector4& end) {
+			return start.DistanceSqr(end);
+		}
+
+	private:
+		template<Precision P>
+		void ScaleByInverseMagnitude(Simd::Float4 magSqr) {
+			if constexpr (P == Precision::Fast) {
+				simd = Simd::Mul(simd, Simd::RSqrtEstimate(magSqr));
+			}
+			else {
+				simd = Simd::Div(simd, Simd::Sqrt(magSqr));
+			}
+		}
 	};
 
+	static_assert(sizeof(Vector4) == 16 && alignof(Vector4) == 16, "Vector4 must map exactly onto one SIMD register");
+
 	/**
 	 * Returns a new Vector where each component is scaled by the scalar value
 	 * @param scalar The scalar.
 	 * @param vector The Vector.
 	 * @return The scaled Vector.
 	 */
-	inline Vector4 operator*(float scalar, const Vector4& vector);
+	constexpr Vector4 operator*(float scalar, const Vector4& vector) {
+		return vector * scalar;
+	}
 }
\ No newline at end of file
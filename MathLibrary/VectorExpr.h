@@ -0,0 +1,295 @@
+#pragma once
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "VectorStream.h"
+#include "Simd.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+/*
+ * Opt-in expression templates for the vector types and SoA streams.
+ *
+ * Wrapping an operand in Expr::Lazy() makes the arithmetic operators build
+ * a description of the expression instead of computing it, and the whole
+ * expression is evaluated in one pass by Expr::Evaluate or Expr::Assign:
+ *
+ *		Vector3 r = Expr::Evaluate<Vector3>(Expr::Lazy(a) + Expr::Lazy(b) * s - Expr::Lazy(c));
+ *		Expr::Assign(outStream, Expr::Lazy(aStream) + Expr::Lazy(bStream) * s - Expr::Lazy(cStream));
+ *
+ * On streams this replaces a chain of Vector3Stream::Add/Scale/Sub calls,
+ * each a full pass over memory with a temporary stream, with a single pass
+ * that keeps the intermediates in registers. A single Vector or a float in
+ * a stream expression is broadcast to every element.
+ *
+ * Expressions hold references to their operands, so evaluate them before
+ * any operand goes out of scope. Code that does not call Lazy() is
+ * unaffected.
+ */
+namespace MathClasses::Expr
+{
+	/**
+	 * Describes how an expression reads the components of a type.
+	 * Dimension 0 means a scalar that matches any dimension.
+	 */
+	template<typename T> struct Traits;
+
+	template<> struct Traits<Vector2> { static constexpr size_t Dimension = 2; static constexpr bool IsStream = false; };
+	template<> struct Traits<Vector3> { static constexpr size_t Dimension = 3; static constexpr bool IsStream = false; };
+	template<> struct Traits<Vector4> { static constexpr size_t Dimension = 4; static constexpr bool IsStream = false; };
+
+	template<> struct Traits<Vector2Stream>
+	{
+		static constexpr size_t Dimension = 2;
+		static constexpr bool IsStream = true;
+		static const float* Component(const Vector2Stream& s, size_t c) { return c == 0 ? s.x.data() : s.y.data(); }
+		static float* Component(Vector2Stream& s, size_t c) { return c == 0 ? s.x.data() : s.y.data(); }
+	};
+
+	template<> struct Traits<Vector3Stream>
+	{
+		static constexpr size_t Dimension = 3;
+		static constexpr bool IsStream = true;
+		static const float* Component(const Vector3Stream& s, size_t c) { return c == 0 ? s.x.data() : (c == 1 ? s.y.data() : s.z.data()); }
+		static float* Component(Vector3Stream& s, size_t c) { return c == 0 ? s.x.data() : (c == 1 ? s.y.data() : s.z.data()); }
+	};
+
+	/**
+	 * Base of every expression node. Each node provides:
+	 *	- At(c, i): component c of element i as a float.
+	 *	- Load(c, i): component c of elements i to i + 3 as a register.
+	 *	- Size(): the number of elements, or 0 if it broadcasts.
+	 */
+	template<typename E>
+	struct Expression
+	{
+		const E& Self() const { return static_cast<const E&>(*this); }
+	};
+
+	/**
+	 * Calls fn(std::integral_constant<size_t, C>) for C in [0, N), so the
+	 * component index is a constant in each call and the loop is always
+	 * unrolled.
+	 */
+	template<size_t N, typename Fn>
+	inline void ForEachComponent(Fn&& fn) {
+		[&]<size_t... C>(std::index_sequence<C...>) {
+			(fn(std::integral_constant<size_t, C>{}), ...);
+		}(std::make_index_sequence<N>{});
+	}
+
+	template<typename V>
+	struct VectorLeaf : Expression<VectorLeaf<V>>
+	{
+		static constexpr size_t Dimension = Traits<V>::Dimension;
+		const V& value;
+
+		explicit VectorLeaf(const V& inValue) : value(inValue) {}
+
+		float At(size_t c, size_t) const { return value[(int)c]; }
+		Simd::Float4 Load(size_t c, size_t) const { return Simd::Splat(value[(int)c]); }
+		size_t Size() const { return 0; }
+	};
+
+	template<typename S>
+	struct StreamLeaf : Expression<StreamLeaf<S>>
+	{
+		static constexpr size_t Dimension = Traits<S>::Dimension;
+		const float* components[Dimension];
+		size_t size;
+
+		explicit StreamLeaf(const S& stream) : size(stream.Size()) {
+			for (size_t c = 0; c < Dimension; c++) {
+				components[c] = Traits<S>::Component(stream, c);
+			}
+		}
+
+		float At(size_t c, size_t i) const { return components[c][i]; }
+		Simd::Float4 Load(size_t c, size_t i) const { return Simd::LoadUnaligned(components[c] + i); }
+		size_t Size() const { return size; }
+	};
+
+	struct ScalarLeaf : Expression<ScalarLeaf>
+	{
+		static constexpr size_t Dimension = 0;
+		float value;
+
+		explicit ScalarLeaf(float inValue) : value(inValue) {}
+
+		float At(size_t, size_t) const { return value; }
+		Simd::Float4 Load(size_t, size_t) const { return Simd::Splat(value); }
+		size_t Size() const { return 0; }
+	};
+
+	struct AddOp
+	{
+		static float Apply(float a, float b) { return a + b; }
+		static Simd::Float4 Apply(Simd::Float4 a, Simd::Float4 b) { return Simd::Add(a, b); }
+	};
+
+	struct SubOp
+	{
+		static float Apply(float a, float b) { return a - b; }
+		static Simd::Float4 Apply(Simd::Float4 a, Simd::Float4 b) { return Simd::Sub(a, b); }
+	};
+
+	struct MulOp
+	{
+		static float Apply(float a, float b) { return a * b; }
+		static Simd::Float4 Apply(Simd::Float4 a, Simd::Float4 b) { return Simd::Mul(a, b); }
+	};
+
+	struct DivOp
+	{
+		static float Apply(float a, float b) { return a / b; }
+		static Simd::Float4 Apply(Simd::Float4 a, Simd::Float4 b) { return Simd::Div(a, b); }
+	};
+
+	template<typename Op, typename L, typename R>
+	struct Binary : Expression<Binary<Op, L, R>>
+	{
+		static_assert(L::Dimension == R::Dimension || L::Dimension == 0 || R::Dimension == 0,
+					  "Both sides of a vector expression must have the same dimension");
+		static constexpr size_t Dimension = L::Dimension != 0 ? L::Dimension : R::Dimension;
+
+		L lhs;
+		R rhs;
+
+		Binary(const L& inLhs, const R& inRhs) : lhs(inLhs), rhs(inRhs) {}
+
+		float At(size_t c, size_t i) const { return Op::Apply(lhs.At(c, i), rhs.At(c, i)); }
+		Simd::Float4 Load(size_t c, size_t i) const { return Op::Apply(lhs.Load(c, i), rhs.Load(c, i)); }
+		size_t Size() const {
+			assert(lhs.Size() == 0 || rhs.Size() == 0 || lhs.Size() == rhs.Size());
+			return lhs.Size() != 0 ? lhs.Size() : rhs.Size();
+		}
+	};
+
+	template<typename E>
+	struct Negate : Expression<Negate<E>>
+	{
+		static constexpr size_t Dimension = E::Dimension;
+		E inner;
+
+		explicit Negate(const E& inInner) : inner(inInner) {}
+
+		float At(size_t c, size_t i) const { return -inner.At(c, i); }
+		Simd::Float4 Load(size_t c, size_t i) const { return Simd::Neg(inner.Load(c, i)); }
+		size_t Size() const { return inner.Size(); }
+	};
+
+	/**
+	 * Wraps a Vector or a stream so that arithmetic on it builds an
+	 * expression.
+	 *
+	 * @param value The Vector or stream, which must outlive the expression.
+	 * @return The expression leaf.
+	 */
+	template<typename T>
+	auto Lazy(const T& value) {
+		if constexpr (Traits<T>::IsStream) {
+			return StreamLeaf<T>(value);
+		}
+		else {
+			return VectorLeaf<T>(value);
+		}
+	}
+
+	template<typename L, typename R> Binary<AddOp, L, R> operator +(const Expression<L>& l, const Expression<R>& r) { return { l.Self(), r.Self() }; }
+	template<typename L, typename R> Binary<SubOp, L, R> operator -(const Expression<L>& l, const Expression<R>& r) { return { l.Self(), r.Self() }; }
+	template<typename L, typename R> Binary<MulOp, L, R> operator *(const Expression<L>& l, const Expression<R>& r) { return { l.Self(), r.Self() }; }
+	template<typename L, typename R> Binary<DivOp, L, R> operator /(const Expression<L>& l, const Expression<R>& r) { return { l.Self(), r.Self() }; }
+
+	template<typename L> Binary<AddOp, L, ScalarLeaf> operator +(const Expression<L>& l, float r) { return { l.Self(), ScalarLeaf(r) }; }
+	template<typename L> Binary<SubOp, L, ScalarLeaf> operator -(const Expression<L>& l, float r) { return { l.Self(), ScalarLeaf(r) }; }
+	template<typename L> Binary<MulOp, L, ScalarLeaf> operator *(const Expression<L>& l, float r) { return { l.Self(), ScalarLeaf(r) }; }
+	template<typename L> Binary<DivOp, L, ScalarLeaf> operator /(const Expression<L>& l, float r) { return { l.Self(), ScalarLeaf(r) }; }
+	template<typename R> Binary<MulOp, ScalarLeaf, R> operator *(float l, const Expression<R>& r) { return { ScalarLeaf(l), r.Self() }; }
+
+	template<typename E> Negate<E> operator -(const Expression<E>& e) { return Negate<E>(e.Self()); }
+
+	/**
+	 * Evaluates an expression of single vectors into a Vector.
+	 *
+	 * @param e The expression.
+	 * @return The result, computed component by component with no
+	 *		   intermediate Vectors.
+	 */
+	template<typename V, typename E>
+	V Evaluate(const Expression<E>& e) {
+		static_assert(!Traits<V>::IsStream, "Use Assign to evaluate into a stream");
+		static_assert(E::Dimension == Traits<V>::Dimension, "Expression dimension does not match the result type");
+		V out;
+		ForEachComponent<Traits<V>::Dimension>([&](auto c) { out[(int)c] = e.Self().At(c, 0); });
+		return out;
+	}
+
+	/**
+	 * Evaluates an expression into a Vector or a stream.
+	 *
+	 * Streams are resized to the expression's size and filled four elements
+	 * at a time per component, finishing the remainder with scalar code.
+	 * The output may be one of the expression's operands, since each
+	 * element only reads the same element of its inputs.
+	 *
+	 * @param out The Vector or stream to write.
+	 * @param e The expression.
+	 */
+	template<typename V, typename E>
+	void Assign(V& out, const Expression<E>& e) {
+		static_assert(E::Dimension == Traits<V>::Dimension, "Expression dimension does not match the result type");
+		const E& expr = e.Self();
+
+		if constexpr (Traits<V>::IsStream) {
+			const size_t count = expr.Size();
+			out.Resize(count);
+			ForEachComponent<Traits<V>::Dimension>([&](auto c) {
+				float* dst = Traits<V>::Component(out, c);
+				size_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					Simd::StoreUnaligned(dst + i, expr.Load(c, i));
+				}
+				for (; i < count; i++) {
+					dst[i] = expr.At(c, i);
+				}
+			});
+		}
+		else {
+			ForEachComponent<Traits<V>::Dimension>([&](auto c) { out[(int)c] = expr.At(c, 0); });
+		}
+	}
+
+	/**
+	 * Returns the dot product of two single-vector expressions without
+	 * evaluating either into a Vector.
+	 */
+	template<typename L, typename R>
+	float Dot(const Expression<L>& l, const Expression<R>& r) {
+		static_assert(L::Dimension == R::Dimension, "Both sides of a dot product must have the same dimension");
+		float sum = 0;
+		ForEachComponent<L::Dimension>([&](auto c) { sum += l.Self().At(c, 0) * r.Self().At(c, 0); });
+		return sum;
+	}
+
+	template<typename E>
+	float MagnitudeSqr(const Expression<E>& e) {
+		float sum = 0;
+		ForEachComponent<E::Dimension>([&](auto c) {
+			float component = e.Self().At(c, 0);
+			sum += component * component;
+		});
+		return sum;
+	}
+
+	/**
+	 * Returns the magnitude of a single-vector expression, e.g.
+	 * Magnitude(Lazy(a) - Lazy(b)) for the distance between two points.
+	 */
+	template<typename E>
+	float Magnitude(const Expression<E>& e) {
+		return sqrtf(MagnitudeSqr(e));
+	}
+}
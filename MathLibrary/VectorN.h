@@ -0,0 +1,427 @@
+#pragma once
+#include "Utils.h"
+#include "Half.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace MathClasses
+{
+	/**
+	 * The components of a VectorN. Vectors of two to four components name
+	 * them x, y, z and w, overlaid with the array v; longer vectors only
+	 * have the array.
+	 *
+	 * Constructors initialise the named components so they can run at
+	 * compile time.
+	 */
+	template<typename T, size_t N>
+	struct VectorStorage
+	{
+		T v[N];
+
+		constexpr VectorStorage() : v{} {}
+
+		template<typename... A>
+		constexpr VectorStorage(A... components) : v{ components... } {}
+	};
+
+	template<typename T>
+	struct VectorStorage<T, 2>
+	{
+		union
+		{
+			struct
+			{
+				T x, y;
+			};
+
+			T v[2];
+		};
+
+		constexpr VectorStorage() : x(0), y(0) {}
+		constexpr VectorStorage(T inX, T inY) : x(inX), y(inY) {}
+	};
+
+	template<typename T>
+	struct VectorStorage<T, 3>
+	{
+		union
+		{
+			struct
+			{
+				T x, y, z;
+			};
+
+			T v[3];
+		};
+
+		constexpr VectorStorage() : x(0), y(0), z(0) {}
+		constexpr VectorStorage(T inX, T inY, T inZ) : x(inX), y(inY), z(inZ) {}
+	};
+
+	template<typename T>
+	struct VectorStorage<T, 4>
+	{
+		union
+		{
+			struct
+			{
+				T x, y, z, w;
+			};
+
+			T v[4];
+		};
+
+		constexpr VectorStorage() : x(0), y(0), z(0), w(0) {}
+		constexpr VectorStorage(T inX, T inY, T inZ, T inW) : x(inX), y(inY), z(inZ), w(inW) {}
+	};
+
+	/**
+	 * Square root used by VectorN for lengths. Component types that are not
+	 * built in, such as Fixed32, provide their own overload next to the type.
+	 */
+	template<typename T>
+	inline T Sqrt(T value)
+	{
+		return std::sqrt(value);
+	}
+
+	/**
+	 * A vector of N components of type T.
+	 *
+	 * Every operation is written once here and expanded per component at
+	 * compile time, so each width and element type gets the same unrolled
+	 * code as a hand-written struct. Vector2 and Vector3 are this template
+	 * for float; Vector4 specialises it to keep its components in a SIMD
+	 * register.
+	 *
+	 * T may be a floating-point type, an integer type for grid coordinates,
+	 * or Half for compact storage. Arithmetic is done in the Scalar type,
+	 * which is float for Half and int for the narrow integer types, and the
+	 * result is converted back to T. Lengths and angles are measured in the
+	 * Real type, which is float for integer vectors.
+	 */
+	template<typename T, size_t N>
+	struct VectorN : VectorStorage<T, N>
+	{
+		static_assert(N >= 2, "VectorN needs at least two components");
+
+		using Component = T;
+		using Scalar = decltype(T() + T());
+		using Real = std::conditional_t<std::is_integral_v<Scalar>, float, Scalar>;
+		static constexpr size_t Dimension = N;
+
+		/**
+		 * Initializes all components to zero
+		 */
+		constexpr VectorN() = default;
+
+		constexpr VectorN(T inX, T inY) requires (N == 2) : VectorStorage<T, N>(inX, inY) {}
+		constexpr VectorN(T inX, T inY, T inZ) requires (N == 3) : VectorStorage<T, N>(inX, inY, inZ) {}
+		constexpr VectorN(T inX, T inY, T inZ, T inW) requires (N == 4) : VectorStorage<T, N>(inX, inY, inZ, inW) {}
+
+		/**
+		 * Extends a vector by one component, such as a 2D point to 3D.
+		 */
+		constexpr VectorN(const VectorN<T, N - 1>& rest, T last = T(0)) requires (N == 3 || N == 4)
+			: VectorN(FromIndices{}, rest, last, std::make_index_sequence<N - 1>{}) {}
+
+		/**
+		 * Converts every component from another element type, such as an
+		 * integer grid coordinate to a float position.
+		 */
+		template<typename U>
+		explicit constexpr VectorN(const VectorN<U, N>& other)
+			: VectorN(Map([&](auto i) { return T(other.Get(i)); })) {}
+
+#ifdef RAYLIB_CPP_INCLUDE_RAYLIB_CPP_HPP_
+
+		VectorN(const raylib::Vector2& RVector2) requires (N == 2 && std::is_same_v<T, float>) : VectorStorage<T, N>(RVector2.x, RVector2.y) {}
+		operator raylib::Vector2() const requires (N == 2 && std::is_same_v<T, float>) { return { this->x, this->y }; }
+
+#endif
+
+#ifdef RAYLIB_H
+		VectorN(const ::Vector2& RVector2) requires (N == 2 && std::is_same_v<T, float>) : VectorStorage<T, N>(RVector2.x, RVector2.y) {}
+		operator ::Vector2() const requires (N == 2 && std::is_same_v<T, float>) { return { this->x, this->y }; }
+#endif
+
+		/**
+		 * Drops the last component, such as a 3D point to 2D.
+		 */
+		template<size_t M> requires (M == N - 1 && N >= 3)
+		constexpr operator VectorN<T, M>() const {
+			return VectorN<T, M>::Map([&](auto i) { return Get(i); });
+		}
+
+		/**
+		 * Returns component I, where I is known at compile time.
+		 */
+		template<size_t I>
+		constexpr T& Get(std::integral_constant<size_t, I> = {}) {
+			static_assert(I < N, "Component index out of range");
+			if constexpr (N > 4) { return this->v[I]; }
+			else if constexpr (I == 0) { return this->x; }
+			else if constexpr (I == 1) { return this->y; }
+			else if constexpr (I == 2) { return this->z; }
+			else { return this->w; }
+		}
+
+		template<size_t I>
+		constexpr const T& Get(std::integral_constant<size_t, I> = {}) const {
+			return const_cast<VectorN*>(this)->Get<I>();
+		}
+
+		/**
+		 * Returns a vector whose component i is fn(i), with i passed as a
+		 * std::integral_constant so it can index with Get.
+		 */
+		template<typename Fn>
+		static constexpr VectorN Map(Fn&& fn) {
+			return [&]<size_t... I>(std::index_sequence<I...>) {
+				return VectorN(FromComponents{}, T(fn(std::integral_constant<size_t, I>{}))...);
+			}(std::make_index_sequence<N>{});
+		}
+
+		/**
+		 * Returns fn(0) + fn(1) + ... + fn(N - 1), added left to right.
+		 */
+		template<typename Fn>
+		static constexpr auto Sum(Fn&& fn) {
+			return [&]<size_t... I>(std::index_sequence<I...>) {
+				return (... + fn(std::integral_constant<size_t, I>{}));
+			}(std::make_index_sequence<N>{});
+		}
+
+		/**
+		 * Returns true if fn(i) is true for every component.
+		 */
+		template<typename Fn>
+		static constexpr bool All(Fn&& fn) {
+			return [&]<size_t... I>(std::index_sequence<I...>) {
+				return (... && fn(std::integral_constant<size_t, I>{}));
+			}(std::make_index_sequence<N>{});
+		}
+
+		Real Magnitude() const {
+			return Sqrt(Real(MagnitudeSqr()));
+		}
+		constexpr Scalar MagnitudeSqr() const {
+			return Dot(*this);
+		}
+
+		constexpr Scalar Dot(const VectorN& rhs) const {
+			return Sum([&](auto i) { return Scalar(Get(i)) * Scalar(rhs.Get(i)); });
+		}
+		static constexpr Scalar Dot(const VectorN& first, const VectorN& second) {
+			return first.Dot(second);
+		}
+
+		constexpr VectorN Cross(const VectorN& rhs) const requires (N == 3) {
+			return {
+				T((this->y * rhs.z) - (this->z * rhs.y)),
+				T((this->z * rhs.x) - (this->x * rhs.z)),
+				T((this->x * rhs.y) - (this->y * rhs.x))
+			};
+		}
+		static constexpr VectorN Cross(const VectorN& first, const VectorN& second) requires (N == 3) {
+			return first.Cross(second);
+		}
+
+		constexpr VectorN Perp() const requires (N == 2) {
+			return { T(-this->y), this->x };
+		}
+
+		/**
+		 * Scales this Vector to unit length. Precision::Fast multiplies by
+		 * an approximate reciprocal square root instead of dividing by the
+		 * magnitude.
+		 */
+		template<Precision P = DefaultPrecision>
+		void Normalise() requires (!std::is_integral_v<T>) {
+			if constexpr (P == Precision::Fast && std::is_same_v<Real, float>) {
+				Real inv = RSqrt<P>(MagnitudeSqr());
+				*this = Map([&](auto i) { return Get(i) * inv; });
+			}
+			else {
+				Real mag = Magnitude();
+				*this = Map([&](auto i) { return Get(i) / mag; });
+			}
+		}
+		template<Precision P = DefaultPrecision>
+		void SafeNormalise() requires (!std::is_integral_v<T>) {
+			if (MagnitudeSqr() != 0) { Normalise<P>(); }
+		}
+		template<Precision P = DefaultPrecision>
+		VectorN Normalised() const requires (!std::is_integral_v<T>) {
+			VectorN copy = *this; copy.Normalise<P>(); return copy;
+		}
+		template<Precision P = DefaultPrecision>
+		VectorN SafeNormalised() const requires (!std::is_integral_v<T>) {
+			VectorN copy = *this; copy.SafeNormalise<P>(); return copy;
+		}
+
+		/**
+		 * Makes every component of this Vector positive and returns a copy.
+		 */
+		constexpr VectorN Absolute() {
+			*this = Map([&](auto i) { return Get(i) < 0 ? T(-Get(i)) : Get(i); });
+			return *this;
+		}
+
+		constexpr VectorN operator +(const VectorN& rhs) const {
+			return Map([&](auto i) { return Get(i) + rhs.Get(i); });
+		}
+		constexpr VectorN& operator +=(const VectorN& rhs) {
+			return *this = *this + rhs;
+		}
+		constexpr VectorN operator -(const VectorN& rhs) const {
+			return Map([&](auto i) { return Get(i) - rhs.Get(i); });
+		}
+		constexpr VectorN& operator -=(const VectorN& rhs) {
+			return *this = *this - rhs;
+		}
+		constexpr VectorN operator *(const VectorN& rhs) const {
+			return Map([&](auto i) { return Get(i) * rhs.Get(i); });
+		}
+		constexpr VectorN& operator *=(const VectorN& rhs) {
+			return *this = *this * rhs;
+		}
+		constexpr VectorN operator /(const VectorN& rhs) const {
+			return Map([&](auto i) { return Get(i) / rhs.Get(i); });
+		}
+		constexpr VectorN& operator /=(const VectorN& rhs) {
+			return *this = *this / rhs;
+		}
+		constexpr VectorN operator *(T rhs) const {
+			return Map([&](auto i) { return Get(i) * rhs; });
+		}
+		constexpr VectorN& operator *=(T rhs) {
+			return *this = *this * rhs;
+		}
+		constexpr VectorN operator /(T rhs) const {
+			return Map([&](auto i) { return Get(i) / rhs; });
+		}
+		constexpr VectorN& operator /=(T rhs) {
+			return *this = *this / rhs;
+		}
+		constexpr VectorN operator -() const {
+			return Map([&](auto i) { return -Get(i); });
+		}
+
+		/**
+		 * Returns true if every component is approximately equal to the
+		 * other. Integer vectors compare exactly.
+		 */
+		constexpr bool operator == (const VectorN& rhs) const {
+			return Equals(rhs);
+		}
+		constexpr bool operator != (const VectorN& rhs) const {
+			return !(Equals(rhs));
+		}
+		constexpr bool Equals(const VectorN& rhs, Real Tolerance = Real(MAX_FLOAT_DELTA)) const {
+			return All([&](auto i) {
+				Real distance = Real(Scalar(Get(i)) - Scalar(rhs.Get(i)));
+				return (distance < 0 ? -distance : distance) < Tolerance;
+			});
+		}
+
+		std::string ToString() const {
+			std::string result;
+			for (size_t i = 0; i < N; i++) {
+				result += (i == 0 ? "" : ", ") + ComponentName(i) + ": " + ComponentToString(this->v[i]);
+			}
+			return result;
+		}
+
+		operator T* () {
+			return this->v;
+		}
+		operator const T* () const {
+			return this->v;
+		}
+		T& operator [](int dim) {
+			return this->v[dim];
+		}
+		const T& operator [](int dim) const {
+			return this->v[dim];
+		}
+
+		Real Distance(const VectorN& other) const {
+			return Sqrt(Real(DistanceSqr(other)));
+		}
+		constexpr Scalar DistanceSqr(const VectorN& other) const {
+			return (*this - other).MagnitudeSqr();
+		}
+		static Real Distance(const VectorN& start, const VectorN& end) {
+			return start.Distance(end);
+		}
+		static constexpr Scalar DistanceSqr(const VectorN& start, const VectorN& end) {
+			return start.DistanceSqr(end);
+		}
+
+		/**
+		 * Returns the angle of the line from the other point to this one.
+		 */
+		template<Precision P = DefaultPrecision>
+		Real AngleBetween(const VectorN& other) const requires (N == 2) {
+			Real dy = Real(this->y - other.y), dx = Real(this->x - other.x);
+			if constexpr (std::is_same_v<Real, float>) {
+				return Atan2<P>(dy, dx);
+			}
+			else {
+				return std::atan2(dy, dx);
+			}
+		}
+
+		/**
+		 * Returns the angle between the directions of this Vector and the other.
+		 */
+		Real AngleBetween(const VectorN& other) const requires (N == 3) {
+			return std::acos(Real(Dot(other)) / (Magnitude() * other.Magnitude()));
+		}
+
+	private:
+		struct FromComponents {};
+		struct FromIndices {};
+
+		template<typename... A>
+		constexpr VectorN(FromComponents, A... components) : VectorStorage<T, N>(components...) {}
+
+		template<size_t... I>
+		constexpr VectorN(FromIndices, const VectorN<T, N - 1>& rest, T last, std::index_sequence<I...>)
+			: VectorStorage<T, N>(rest.Get(std::integral_constant<size_t, I>{})..., last) {}
+
+		static std::string ComponentToString(const T& component) {
+			if constexpr (std::is_arithmetic_v<Scalar>) {
+				return std::to_string(Scalar(component));
+			}
+			else {
+				return component.ToString();
+			}
+		}
+
+		static std::string ComponentName(size_t i) {
+			return N <= 4 ? std::string(1, "xyzw"[i]) : "v" + std::to_string(i);
+		}
+	};
+
+	template<typename T, size_t N>
+	constexpr VectorN<T, N> operator *(std::type_identity_t<T> scalar, const VectorN<T, N>& vector) {
+		return vector * scalar;
+	}
+
+	using Vector2i = VectorN<int32_t, 2>;
+	using Vector3i = VectorN<int32_t, 3>;
+	using Vector2d = VectorN<double, 2>;
+	using Vector3d = VectorN<double, 3>;
+	using Vector4d = VectorN<double, 4>;
+	using Vector2h = VectorN<Half, 2>;
+	using Vector3h = VectorN<Half, 3>;
+	using Vector4h = VectorN<Half, 4>;
+}
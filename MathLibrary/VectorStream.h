@@ -0,0 +1,484 @@
+#pragma once
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Simd.h"
+#include "Utils.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace MathClasses
+{
+	/*
+	 * Kernels shared by the structure-of-arrays streams below.
+	 *
+	 * Each kernel works on N separate component arrays and processes four
+	 * elements per iteration in a SIMD register, finishing the remainder with
+	 * scalar code. None of them require aligned input, and every kernel allows
+	 * its output to alias one of its inputs.
+	 */
+	namespace StreamKernels
+	{
+		template<size_t N> using ConstComponents = std::array<const float*, N>;
+		template<size_t N> using Components = std::array<float*, N>;
+
+		/**
+		 * out[i] = a[i] + b[i]
+		 */
+		inline void Add(const float* a, const float* b, float* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::StoreUnaligned(out + i, Simd::Add(Simd::LoadUnaligned(a + i), Simd::LoadUnaligned(b + i)));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		/**
+		 * out[i] = a[i] - b[i]
+		 */
+		inline void Sub(const float* a, const float* b, float* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::StoreUnaligned(out + i, Simd::Sub(Simd::LoadUnaligned(a + i), Simd::LoadUnaligned(b + i)));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] - b[i];
+			}
+		}
+
+		/**
+		 * out[i] = a[i] * scalar
+		 */
+		inline void Scale(const float* a, float scalar, float* out, size_t count)
+		{
+			const Simd::Float4 s = Simd::Splat(scalar);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::StoreUnaligned(out + i, Simd::Mul(Simd::LoadUnaligned(a + i), s));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] * scalar;
+			}
+		}
+
+		/**
+		 * out[i] = a[i] + (b[i] * scalar)
+		 */
+		inline void AddScaled(const float* a, const float* b, float scalar, float* out, size_t count)
+		{
+			const Simd::Float4 s = Simd::Splat(scalar);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::StoreUnaligned(out + i, Simd::MulAdd(Simd::LoadUnaligned(b + i), s, Simd::LoadUnaligned(a + i)));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] + (b[i] * scalar);
+			}
+		}
+
+		/**
+		 * out[i] = a[i] + ((b[i] - a[i]) * alpha)
+		 */
+		inline void Lerp(const float* a, const float* b, float alpha, float* out, size_t count)
+		{
+			const Simd::Float4 t = Simd::Splat(alpha);
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 start = Simd::LoadUnaligned(a + i);
+				Simd::Float4 dist = Simd::Sub(Simd::LoadUnaligned(b + i), start);
+				Simd::StoreUnaligned(out + i, Simd::MulAdd(dist, t, start));
+			}
+			for (; i < count; i++) {
+				out[i] = a[i] + ((b[i] - a[i]) * alpha);
+			}
+		}
+
+		/**
+		 * out[i] = dot(a[i], b[i])
+		 */
+		template<size_t N>
+		inline void Dot(ConstComponents<N> a, ConstComponents<N> b, float* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 sum = Simd::Zero();
+				for (size_t c = 0; c < N; c++) {
+					sum = Simd::MulAdd(Simd::LoadUnaligned(a[c] + i), Simd::LoadUnaligned(b[c] + i), sum);
+				}
+				Simd::StoreUnaligned(out + i, sum);
+			}
+			for (; i < count; i++) {
+				float sum = 0;
+				for (size_t c = 0; c < N; c++) {
+					sum += a[c][i] * b[c][i];
+				}
+				out[i] = sum;
+			}
+		}
+
+		/**
+		 * out[i] = |a[i]|
+		 */
+		template<size_t N>
+		inline void Magnitude(ConstComponents<N> a, float* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 sum = Simd::Zero();
+				for (size_t c = 0; c < N; c++) {
+					Simd::Float4 v = Simd::LoadUnaligned(a[c] + i);
+					sum = Simd::MulAdd(v, v, sum);
+				}
+				Simd::StoreUnaligned(out + i, Simd::Sqrt(sum));
+			}
+			for (; i < count; i++) {
+				float sum = 0;
+				for (size_t c = 0; c < N; c++) {
+					sum += a[c][i] * a[c][i];
+				}
+				out[i] = sqrtf(sum);
+			}
+		}
+
+		/**
+		 * out[i] = |b[i] - a[i]|
+		 */
+		template<size_t N>
+		inline void Distance(ConstComponents<N> a, ConstComponents<N> b, float* out, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 sum = Simd::Zero();
+				for (size_t c = 0; c < N; c++) {
+					Simd::Float4 d = Simd::Sub(Simd::LoadUnaligned(b[c] + i), Simd::LoadUnaligned(a[c] + i));
+					sum = Simd::MulAdd(d, d, sum);
+				}
+				Simd::StoreUnaligned(out + i, Simd::Sqrt(sum));
+			}
+			for (; i < count; i++) {
+				float sum = 0;
+				for (size_t c = 0; c < N; c++) {
+					float d = b[c][i] - a[c][i];
+					sum += d * d;
+				}
+				out[i] = sqrtf(sum);
+			}
+		}
+
+		/**
+		 * Divides every element by its own magnitude, in place.
+		 *
+		 * Like Vector2::Normalise(), zero-length elements are not guarded, and
+		 * Precision::Fast multiplies by a reciprocal square root estimate.
+		 */
+		template<size_t N, Precision P = DefaultPrecision>
+		inline void Normalise(Components<N> a, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				Simd::Float4 v[N];
+				Simd::Float4 sum = Simd::Zero();
+				for (size_t c = 0; c < N; c++) {
+					v[c] = Simd::LoadUnaligned(a[c] + i);
+					sum = Simd::MulAdd(v[c], v[c], sum);
+				}
+				if constexpr (P == Precision::Fast) {
+					Simd::Float4 inv = Simd::RSqrtEstimate(sum);
+					for (size_t c = 0; c < N; c++) {
+						Simd::StoreUnaligned(a[c] + i, Simd::Mul(v[c], inv));
+					}
+				}
+				else {
+					Simd::Float4 mag = Simd::Sqrt(sum);
+					for (size_t c = 0; c < N; c++) {
+						Simd::StoreUnaligned(a[c] + i, Simd::Div(v[c], mag));
+					}
+				}
+			}
+			for (; i < count; i++) {
+				float sum = 0;
+				for (size_t c = 0; c < N; c++) {
+					sum += a[c][i] * a[c][i];
+				}
+				if constexpr (P == Precision::Fast) {
+					float inv = RSqrt<P>(sum);
+					for (size_t c = 0; c < N; c++) {
+						a[c][i] *= inv;
+					}
+				}
+				else {
+					float mag = sqrtf(sum);
+					for (size_t c = 0; c < N; c++) {
+						a[c][i] /= mag;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * A structure-of-arrays container of 2D vectors, storing every X in one
+	 * array and every Y in another so batched operations can run several
+	 * elements per instruction.
+	 *
+	 * Batched operations write to an output stream that is resized to match
+	 * the input. The output may be the same stream as one of the inputs.
+	 */
+	struct Vector2Stream
+	{
+		std::vector<float> x, y;
+
+		Vector2Stream() {}
+		explicit Vector2Stream(size_t count) : x(count), y(count) {}
+
+		size_t Size() const { return x.size(); }
+		void Resize(size_t count) { x.resize(count); y.resize(count); }
+		void Reserve(size_t count) { x.reserve(count); y.reserve(count); }
+		void Clear() { x.clear(); y.clear(); }
+
+		void PushBack(const Vector2& vec) { x.push_back(vec.x); y.push_back(vec.y); }
+		Vector2 Get(size_t i) const { return { x[i], y[i] }; }
+		void Set(size_t i, const Vector2& vec) { x[i] = vec.x; y[i] = vec.y; }
+
+		/**
+		 * Builds a stream from an array of Vector2.
+		 *
+		 * @param in The array of vectors.
+		 * @param count The number of vectors in the array.
+		 * @return The stream holding a copy of the vectors.
+		 */
+		static Vector2Stream FromArray(const Vector2* in, size_t count) {
+			Vector2Stream stream;
+			stream.Assign(in, count);
+			return stream;
+		}
+
+		/**
+		 * Replaces the contents of this stream with an array of Vector2,
+		 * reusing existing storage where possible.
+		 */
+		void Assign(const Vector2* in, size_t count) {
+			Resize(count);
+			float* outX = x.data();
+			float* outY = y.data();
+			for (size_t i = 0; i < count; i++) {
+				outX[i] = in[i].x;
+				outY[i] = in[i].y;
+			}
+		}
+
+		/**
+		 * Writes every element back into an array of Vector2 that holds at
+		 * least Size() elements.
+		 */
+		void ToArray(Vector2* out) const {
+			const float* inX = x.data();
+			const float* inY = y.data();
+			for (size_t i = 0; i < Size(); i++) {
+				out[i].x = inX[i];
+				out[i].y = inY[i];
+			}
+		}
+
+		static void Add(const Vector2Stream& a, const Vector2Stream& b, Vector2Stream& out) {
+			assert(a.Size() == b.Size());
+			out.Resize(a.Size());
+			StreamKernels::Add(a.x.data(), b.x.data(), out.x.data(), a.Size());
+			StreamKernels::Add(a.y.data(), b.y.data(), out.y.data(), a.Size());
+		}
+
+		static void Sub(const Vector2Stream& a, const Vector2Stream& b, Vector2Stream& out) {
+			assert(a.Size() == b.Size());
+			out.Resize(a.Size());
+			StreamKernels::Sub(a.x.data(), b.x.data(), out.x.data(), a.Size());
+			StreamKernels::Sub(a.y.data(), b.y.data(), out.y.data(), a.Size());
+		}
+
+		static void Scale(const Vector2Stream& a, float scalar, Vector2Stream& out) {
+			out.Resize(a.Size());
+			StreamKernels::Scale(a.x.data(), scalar, out.x.data(), a.Size());
+			StreamKernels::Scale(a.y.data(), scalar, out.y.data(), a.Size());
+		}
+
+		/**
+		 * out = a + (b * scalar), e.g. integrating positions by velocity.
+		 */
+		static void AddScaled(const Vector2Stream& a, const Vector2Stream& b, float scalar, Vector2Stream& out) {
+			assert(a.Size() == b.Size());
+			out.Resize(a.Size());
+			StreamKernels::AddScaled(a.x.data(), b.x.data(), scalar, out.x.data(), a.Size());
+			StreamKernels::AddScaled(a.y.data(), b.y.data(), scalar, out.y.data(), a.Size());
+		}
+
+		static void Lerp(const Vector2Stream& start, const Vector2Stream& end, float alpha, Vector2Stream& out) {
+			assert(start.Size() == end.Size());
+			out.Resize(start.Size());
+			StreamKernels::Lerp(start.x.data(), end.x.data(), alpha, out.x.data(), start.Size());
+			StreamKernels::Lerp(start.y.data(), end.y.data(), alpha, out.y.data(), start.Size());
+		}
+
+		/**
+		 * Interpolates each pair of elements by its own alpha, e.g. tweens
+		 * that started at different times. alpha must hold at least
+		 * start.Size() floats.
+		 */
+		static void Lerp(const Vector2Stream& start, const Vector2Stream& end, const float* alpha, Vector2Stream& out) {
+			assert(start.Size() == end.Size());
+			out.Resize(start.Size());
+			LerpArray(start.x.data(), end.x.data(), alpha, out.x.data(), start.Size());
+			LerpArray(start.y.data(), end.y.data(), alpha, out.y.data(), start.Size());
+		}
+
+		/**
+		 * Writes the dot product of each pair of elements to out, which must
+		 * hold at least a.Size() floats.
+		 */
+		static void Dot(const Vector2Stream& a, const Vector2Stream& b, float* out) {
+			assert(a.Size() == b.Size());
+			StreamKernels::Dot<2>({ a.x.data(), a.y.data() }, { b.x.data(), b.y.data() }, out, a.Size());
+		}
+
+		/**
+		 * Writes the distance between each pair of elements to out, which
+		 * must hold at least start.Size() floats.
+		 */
+		static void Distance(const Vector2Stream& start, const Vector2Stream& end, float* out) {
+			assert(start.Size() == end.Size());
+			StreamKernels::Distance<2>({ start.x.data(), start.y.data() }, { end.x.data(), end.y.data() }, out, start.Size());
+		}
+
+		/**
+		 * Writes the magnitude of each element to out, which must hold at
+		 * least Size() floats.
+		 */
+		void Magnitude(float* out) const {
+			StreamKernels::Magnitude<2>({ x.data(), y.data() }, out, Size());
+		}
+
+		template<Precision P = DefaultPrecision>
+		void Normalise() {
+			StreamKernels::Normalise<2, P>({ x.data(), y.data() }, Size());
+		}
+	};
+
+	/**
+	 * A structure-of-arrays container of 3D vectors. See Vector2Stream.
+	 */
+	struct Vector3Stream
+	{
+		std::vector<float> x, y, z;
+
+		Vector3Stream() {}
+		explicit Vector3Stream(size_t count) : x(count), y(count), z(count) {}
+
+		size_t Size() const { return x.size(); }
+		void Resize(size_t count) { x.resize(count); y.resize(count); z.resize(count); }
+		void Reserve(size_t count) { x.reserve(count); y.reserve(count); z.reserve(count); }
+		void Clear() { x.clear(); y.clear(); z.clear(); }
+
+		void PushBack(const Vector3& vec) { x.push_back(vec.x); y.push_back(vec.y); z.push_back(vec.z); }
+		Vector3 Get(size_t i) const { return { x[i], y[i], z[i] }; }
+		void Set(size_t i, const Vector3& vec) { x[i] = vec.x; y[i] = vec.y; z[i] = vec.z; }
+
+		static Vector3Stream FromArray(const Vector3* in, size_t count) {
+			Vector3Stream stream;
+			stream.Assign(in, count);
+			return stream;
+		}
+
+		void Assign(const Vector3* in, size_t count) {
+			Resize(count);
+			float* outX = x.data();
+			float* outY = y.data();
+			float* outZ = z.data();
+			for (size_t i = 0; i < count; i++) {
+				outX[i] = in[i].x;
+				outY[i] = in[i].y;
+				outZ[i] = in[i].z;
+			}
+		}
+
+		void ToArray(Vector3* out) const {
+			const float* inX = x.data();
+			const float* inY = y.data();
+			const float* inZ = z.data();
+			for (size_t i = 0; i < Size(); i++) {
+				out[i].x = inX[i];
+				out[i].y = inY[i];
+				out[i].z = inZ[i];
+			}
+		}
+
+		static void Add(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& out) {
+			assert(a.Size() == b.Size());
+			out.Resize(a.Size());
+			StreamKernels::Add(a.x.data(), b.x.data(), out.x.data(), a.Size());
+			StreamKernels::Add(a.y.data(), b.y.data(), out.y.data(), a.Size());
+			StreamKernels::Add(a.z.data(), b.z.data(), out.z.data(), a.Size());
+		}
+
+		static void Sub(const Vector3Stream& a, const Vector3Stream& b, Vector3Stream& out) {
+			assert(a.Size() == b.Size());
+			out.Resize(a.Size());
+			StreamKernels::Sub(a.x.data(), b.x.data(), out.x.data(), a.Size());
+			StreamKernels::Sub(a.y.data(), b.y.data(), out.y.data(), a.Size());
+			StreamKernels::Sub(a.z.data(), b.z.data(), out.z.data(), a.Size());
+		}
+
+		static void Scale(const Vector3Stream& a, float scalar, Vector3Stream& out) {
+			out.Resize(a.Size());
+			StreamKernels::Scale(a.x.data(), scalar, out.x.data(), a.Size());
+			StreamKernels::Scale(a.y.data(), scalar, out.y.data(), a.Size());
+			StreamKernels::Scale(a.z.data(), scalar, out.z.data(), a.Size());
+		}
+
+		static void AddScaled(const Vector3Stream& a, const Vector3Stream& b, float scalar, Vector3Stream& out) {
+			assert(a.Size() == b.Size());
+			out.Resize(a.Size());
+			StreamKernels::AddScaled(a.x.data(), b.x.data(), scalar, out.x.data(), a.Size());
+			StreamKernels::AddScaled(a.y.data(), b.y.data(), scalar, out.y.data(), a.Size());
+			StreamKernels::AddScaled(a.z.data(), b.z.data(), scalar, out.z.data(), a.Size());
+		}
+
+		static void Lerp(const Vector3Stream& start, const Vector3Stream& end, float alpha, Vector3Stream& out) {
+			assert(start.Size() == end.Size());
+			out.Resize(start.Size());
+			StreamKernels::Lerp(start.x.data(), end.x.data(), alpha, out.x.data(), start.Size());
+			StreamKernels::Lerp(start.y.data(), end.y.data(), alpha, out.y.data(), start.Size());
+			StreamKernels::Lerp(start.z.data(), end.z.data(), alpha, out.z.data(), start.Size());
+		}
+
+		static void Lerp(const Vector3Stream& start, const Vector3Stream& end, const float* alpha, Vector3Stream& out) {
+			assert(start.Size() == end.Size());
+			out.Resize(start.Size());
+			LerpArray(start.x.data(), end.x.data(), alpha, out.x.data(), start.Size());
+			LerpArray(start.y.data(), end.y.data(), alpha, out.y.data(), start.Size());
+			LerpArray(start.z.data(), end.z.data(), alpha, out.z.data(), start.Size());
+		}
+
+		static void Dot(const Vector3Stream& a, const Vector3Stream& b, float* out) {
+			assert(a.Size() == b.Size());
+			StreamKernels::Dot<3>({ a.x.data(), a.y.data(), a.z.data() }, { b.x.data(), b.y.data(), b.z.data() }, out, a.Size());
+		}
+
+		static void Distance(const Vector3Stream& start, const Vector3Stream& end, float* out) {
+			assert(start.Size() == end.Size());
+			StreamKernels::Distance<3>({ start.x.data(), start.y.data(), start.z.data() }, { end.x.data(), end.y.data(), end.z.data() }, out, start.Size());
+		}
+
+		void Magnitude(float* out) const {
+			StreamKernels::Magnitude<3>({ x.data(), y.data(), z.data() }, out, Size());
+		}
+
+		template<Precision P = DefaultPrecision>
+		void Normalise() {
+			StreamKernels::Normalise<3, P>({ x.data(), y.data(), z.data() }, Size());
+		}
+	};
+}
@@ -22,6 +22,14 @@
 
 #include "raylib-cpp.hpp"
 
+#include "Broadphase.h"
+#include "RaylibRenderer.h"
+#include "SpriteLayer.h"
+#include "SpriteObject.h"
+
+#include <cstdint>
+#include <vector>
+
 int main() {
     // Initialization
     //--------------------------------------------------------------------------------------
@@ -31,13 +39,62 @@ int main() {
     raylib::Window window(screenWidth, screenHeight, "raylib [core] example - basic window");
 
     SetTargetFPS(60);
+
+    // A field of sprites several screens across; only those overlapping the
+    // camera's view are drawn each frame
+    RaylibRenderer renderer;
+    raylib::Image checked = raylib::Image::Checked(32, 32, 8, 8, raylib::Color::SkyBlue(), raylib::Color::DarkBlue());
+    uint32_t texture = renderer.AddTexture(raylib::Texture(checked));
+
+    const float worldSize = 4000.0f;
+    std::vector<SpriteObject> sprites;
+    for (int i = 0; i < 4000; i++) {
+        float x = (float)GetRandomValue(0, (int)worldSize);
+        float y = (float)GetRandomValue(0, (int)worldSize);
+        sprites.emplace_back(texture, MathClasses::Vector2(32, 32), MathClasses::Vector2(x, y));
+        sprites.back().SetRotation((float)GetRandomValue(0, 628) * 0.01f);
+    }
+
+    // the layer keeps pointers into the vector, so it is only filled once
+    // the vector has stopped growing
+    SpriteLayer layer;
+    for (SpriteObject& sprite : sprites) {
+        layer.Add(sprite);
+    }
+
+    // sprites whose centres are closer than their width count as touching
+    const float touchDistance = 32.0f;
+    MathClasses::SpatialHashGrid grid(touchDistance, 8192);
+    std::vector<MathClasses::Vector2> positions(sprites.size());
+    std::vector<MathClasses::IndexPair> touching;
+
+    MathClasses::Vector2 camera(worldSize * 0.5f, worldSize * 0.5f);
     //--------------------------------------------------------------------------------------
 
     // Main game loop
     while (!window.ShouldClose()) {   // Detect window close button or ESC key
         // Update
         //----------------------------------------------------------------------------------
-        // Update your variables here
+        float step = 400.0f * GetFrameTime();
+        if (IsKeyDown(KEY_RIGHT)) camera.x += step;
+        if (IsKeyDown(KEY_LEFT)) camera.x -= step;
+        if (IsKeyDown(KEY_DOWN)) camera.y += step;
+        if (IsKeyDown(KEY_UP)) camera.y -= step;
+
+        // only every tenth sprite spins, so most cached rectangles stay valid
+        for (size_t i = 0; i < sprites.size(); i += 10) {
+            sprites[i].Rotate(GetFrameTime());
+        }
+        layer.Update();
+
+        for (size_t i = 0; i < sprites.size(); i++) {
+            positions[i] = sprites[i].Position();
+        }
+        grid.Build(positions.data(), positions.size());
+        grid.FindPairs(touchDistance, touching);
+
+        MathClasses::AABB2 view(camera, camera + MathClasses::Vector2((float)screenWidth, (float)screenHeight));
+        const std::vector<uint32_t>& visible = layer.Cull(view);
         //----------------------------------------------------------------------------------
 
         // Draw
@@ -45,11 +102,17 @@ int main() {
         BeginDrawing();
         {
             window.ClearBackground(RAYWHITE);
-            textColor.DrawText("Congrats! You created your first window!", 190, 200, 20);
+
+            raylib::Camera2D view2D(::Vector2{ 0, 0 }, ::Vector2{ camera.x, camera.y });
+            view2D.BeginMode();
+            layer.Draw(renderer, visible);
+            view2D.EndMode();
+
+            textColor.DrawText(TextFormat("Drawing %i of %i sprites, %i pairs touching (arrow keys to move)", (int)visible.size(), (int)layer.Size(), (int)touching.size()), 10, 10, 20);
         }
         EndDrawing();
         //----------------------------------------------------------------------------------
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,10 +1,14 @@
 #pragma once
 //#include "Vector2.h";
 
+class Renderer;
+
 class Object {
 public:
 	//aie::Vector2 Position;
 
+	virtual ~Object() {}
+
 	virtual void Update() {}
-	virtual void Draw() {}
-};
\ No newline at end of file
+	virtual void Draw(Renderer& /*renderer*/) {}
+};
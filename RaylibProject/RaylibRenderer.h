@@ -0,0 +1,43 @@
+#pragma once
+#include "raylib-cpp.hpp"
+#include "rlgl.h"
+
+#include "Renderer.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Draws sprites with raylib. Textures are owned here and referred to by
+ * the handles AddTexture() returns.
+ */
+class RaylibRenderer : public Renderer {
+public:
+	uint32_t AddTexture(raylib::Texture&& texture) {
+		textures.push_back(std::move(texture));
+		return (uint32_t)(textures.size() - 1);
+	}
+
+	void DrawSprite(uint32_t texture, const MathClasses::Affine2D& transform, MathClasses::Vector2 size, MathClasses::Vector2 pivot) override {
+		const raylib::Texture& tex = textures[texture];
+
+		// the Affine2D columns laid out as a column-major 4x4 for rlgl
+		const float matrix[16] = {
+			transform.m1, transform.m2, 0, 0,
+			transform.m3, transform.m4, 0, 0,
+			0, 0, 1.0f, 0,
+			transform.m5, transform.m6, 0, 1.0f
+		};
+
+		rlPushMatrix();
+		rlMultMatrixf(matrix);
+		DrawTexturePro(tex, ::Rectangle{ 0, 0, (float)tex.width, (float)tex.height },
+					   ::Rectangle{ 0, 0, size.x, size.y },
+					   ::Vector2{ pivot.x * size.x, pivot.y * size.y }, 0, WHITE);
+		rlPopMatrix();
+	}
+
+private:
+	std::vector<raylib::Texture> textures;
+};
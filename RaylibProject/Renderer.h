@@ -0,0 +1,38 @@
+#pragma once
+#include "Affine2D.h"
+#include "Vector2.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Where objects send their draw calls. The game draws through
+ * RaylibRenderer; NullRenderer lets the same code run without a window.
+ */
+class Renderer {
+public:
+	virtual ~Renderer() {}
+
+	/**
+	 * Draws a texture stretched over a size x size rectangle whose pivot,
+	 * given as a fraction of the size, sits at the transform's origin.
+	 *
+	 * @param texture The handle of a texture known to the renderer.
+	 * @param transform The sprite's world transform.
+	 * @param size The sprite's size before the transform is applied.
+	 * @param pivot The point the sprite rotates and scales around, from (0, 0) at its top left to (1, 1) at its bottom right.
+	 */
+	virtual void DrawSprite(uint32_t texture, const MathClasses::Affine2D& transform, MathClasses::Vector2 size, MathClasses::Vector2 pivot) = 0;
+};
+
+/**
+ * A renderer that draws nothing and counts the calls it receives.
+ */
+class NullRenderer : public Renderer {
+public:
+	size_t drawCalls = 0;
+
+	void DrawSprite(uint32_t, const MathClasses::Affine2D&, MathClasses::Vector2, MathClasses::Vector2) override {
+		drawCalls++;
+	}
+};
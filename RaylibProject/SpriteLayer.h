@@ -0,0 +1,97 @@
+#pragma once
+#include "SpriteObject.h"
+#include "Renderer.h"
+
+#include "Bounds.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The sprites drawn together on one layer, with their world rectangles
+ * copied into a structure-of-arrays stream so the whole layer can be
+ * culled against the camera in one vectorised pass.
+ *
+ * The layer does not own its sprites; each must outlive the layer or be
+ * removed with Clear() first.
+ */
+class SpriteLayer {
+public:
+	/**
+	 * Adds a sprite and returns its index in the layer.
+	 *
+	 * The layer keeps the sprite's address, so the sprite must not move
+	 * while it is in the layer. Sprites held by value in a std::vector must
+	 * be added only after the vector has stopped growing.
+	 */
+	uint32_t Add(SpriteObject& sprite) {
+		sprites.push_back(&sprite);
+		bounds.PushBack(sprite.WorldBounds());
+		seenVersions.push_back(sprite.TransformVersion());
+		return (uint32_t)(sprites.size() - 1);
+	}
+
+	void Clear() {
+		sprites.clear();
+		bounds.Clear();
+		seenVersions.clear();
+		visible.clear();
+	}
+
+	size_t Size() const { return sprites.size(); }
+
+	SpriteObject& operator [](size_t index) { return *sprites[index]; }
+	const SpriteObject& operator [](size_t index) const { return *sprites[index]; }
+
+	void Update() {
+		for (SpriteObject* sprite : sprites) {
+			sprite->Update();
+		}
+	}
+
+	/**
+	 * Finds the sprites whose world rectangles overlap the view.
+	 *
+	 * Only sprites whose transform changed since the last call have their
+	 * rectangle refreshed; the rest keep the copy already in the stream.
+	 *
+	 * @param view The world-space rectangle the camera sees.
+	 * @return The indices of the visible sprites in ascending order, valid until the next call.
+	 */
+	const std::vector<uint32_t>& Cull(const MathClasses::AABB2& view) {
+		for (size_t i = 0; i < sprites.size(); i++) {
+			uint32_t version = sprites[i]->TransformVersion();
+			if (version != seenVersions[i]) {
+				bounds.Set(i, sprites[i]->WorldBounds());
+				seenVersions[i] = version;
+			}
+		}
+
+		visible.resize(sprites.size());
+		visible.resize(bounds.Overlapping(view, visible.data()));
+		return visible;
+	}
+
+	/**
+	 * Draws the given sprites in order, such as the result of Cull().
+	 */
+	void Draw(Renderer& renderer, const std::vector<uint32_t>& indices) {
+		for (uint32_t index : indices) {
+			sprites[index]->Draw(renderer);
+		}
+	}
+
+	/**
+	 * Culls against the view and draws what remains.
+	 */
+	void Draw(Renderer& renderer, const MathClasses::AABB2& view) {
+		Draw(renderer, Cull(view));
+	}
+
+private:
+	std::vector<SpriteObject*> sprites;
+	MathClasses::AABB2Stream bounds;
+	std::vector<uint32_t> seenVersions;
+	std::vector<uint32_t> visible;
+};
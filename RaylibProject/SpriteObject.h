@@ -1,7 +1,95 @@
 #pragma once
-#include "raylib-cpp-utils.hpp"
 #include "Object.h"
+#include "Renderer.h"
 
+#include "Affine2D.h"
+#include "Bounds.h"
+#include "Vector2.h"
+
+#include <cstdint>
+
+/**
+ * A textured rectangle placed by a position, rotation and scale.
+ *
+ * The world transform and world-space bounding rectangle are cached and
+ * only rebuilt after the transform changes, and TransformVersion() counts
+ * those changes so a SpriteLayer can tell which cached rectangles to copy.
+ */
 class SpriteObject : public Object {
-	//public
-};
\ No newline at end of file
+public:
+	SpriteObject() {}
+
+	SpriteObject(uint32_t inTexture, MathClasses::Vector2 inSize, MathClasses::Vector2 inPosition = {})
+		: texture(inTexture), size(inSize), position(inPosition) {}
+
+	uint32_t Texture() const { return texture; }
+	MathClasses::Vector2 Size() const { return size; }
+	MathClasses::Vector2 Pivot() const { return pivot; }
+	MathClasses::Vector2 Position() const { return position; }
+	float Rotation() const { return rotation; }
+	MathClasses::Vector2 Scale() const { return scale; }
+
+	void SetTexture(uint32_t newTexture) { texture = newTexture; }
+
+	void SetSize(MathClasses::Vector2 newSize) { size = newSize; Changed(); }
+	void SetPivot(MathClasses::Vector2 newPivot) { pivot = newPivot; Changed(); }
+	void SetPosition(MathClasses::Vector2 newPosition) { position = newPosition; Changed(); }
+	void SetRotation(float newRotation) { rotation = newRotation; Changed(); }
+	void SetScale(MathClasses::Vector2 newScale) { scale = newScale; Changed(); }
+
+	void Translate(MathClasses::Vector2 offset) { SetPosition(position + offset); }
+	void Rotate(float angle) { SetRotation(rotation + angle); }
+
+	/**
+	 * Returns the transform from the sprite's local space, with the pivot
+	 * at the origin, to world space.
+	 */
+	const MathClasses::Affine2D& WorldTransform() const {
+		Refresh();
+		return worldTransform;
+	}
+
+	/**
+	 * Returns the smallest axis-aligned rectangle holding the sprite.
+	 */
+	const MathClasses::AABB2& WorldBounds() const {
+		Refresh();
+		return worldBounds;
+	}
+
+	/**
+	 * Returns a counter that changes whenever the transform, size or pivot
+	 * does, and so whenever WorldBounds() may have.
+	 */
+	uint32_t TransformVersion() const { return version; }
+
+	void Draw(Renderer& renderer) override {
+		renderer.DrawSprite(texture, WorldTransform(), size, pivot);
+	}
+
+protected:
+	void Changed() {
+		dirty = true;
+		version++;
+	}
+
+	void Refresh() const {
+		if (!dirty) { return; }
+		worldTransform = MathClasses::Affine2D::MakeTRS(position, rotation, scale);
+		MathClasses::Vector2 topLeft(-pivot.x * size.x, -pivot.y * size.y);
+		worldBounds = MathClasses::AABB2(topLeft, topLeft + size).Transformed(worldTransform);
+		dirty = false;
+	}
+
+	uint32_t texture = 0;
+	MathClasses::Vector2 size;
+	MathClasses::Vector2 pivot = { 0.5f, 0.5f };
+	MathClasses::Vector2 position;
+	float rotation = 0;
+	MathClasses::Vector2 scale = { 1.0f, 1.0f };
+
+	uint32_t version = 0;
+	mutable bool dirty = true;
+	mutable MathClasses::Affine2D worldTransform;
+	mutable MathClasses::AABB2 worldBounds;
+};
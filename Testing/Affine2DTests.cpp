@@ -0,0 +1,99 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Affine2D;
+using MathClasses::Matrix3;
+using MathClasses::Vector2;
+using MathClasses::Vector2Stream;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(Affine2DTests)
+	{
+	public:
+		const Vector2 points[BatchTestLength] = {
+			{ 13.5f, -48.23f }, { 5, 3.99f }, { 0, 1 }, { -2.5f, 7.0f },
+			{ 100.0f, -0.5f }, { 3, 4 }, { -8.25f, -16.0f }
+		};
+
+		TEST_METHOD(MatrixRoundTrip)
+		{
+			Matrix3 mat = Matrix3::MakeTRS(Vector2(4, -2), 0.7f, Vector2(2, 0.5f));
+			Affine2D affine(mat);
+
+			Assert::IsTrue(affine.ToMatrix3() == mat);
+			Assert::IsTrue(Affine2D::MakeTRS(Vector2(4, -2), 0.7f, Vector2(2, 0.5f)) == affine);
+			Assert::IsTrue(Affine2D::MakeIdentity().ToMatrix3() == Matrix3::MakeIdentity());
+			Assert::IsTrue(Affine2D::MakeTranslation(3, 4).ToMatrix3() == Matrix3::MakeTranslation(3, 4));
+			Assert::IsTrue(Affine2D::MakeRotateZ(1.2f).ToMatrix3() == Matrix3::MakeRotateZ(1.2f));
+			Assert::IsTrue(Affine2D::MakeScale(2, 3).ToMatrix3() == Matrix3::MakeScale(2, 3));
+		}
+
+		TEST_METHOD(ComposeMatchesMatrix3)
+		{
+			Matrix3 a = Matrix3::MakeTRS(Vector2(4, -2), 0.7f, Vector2(2, 0.5f));
+			Matrix3 b = Matrix3::MakeTRS(Vector2(-10, 3), -2.1f, Vector2(1.5f, 1.5f));
+
+			CustomAssert::AreEqualsMember(Affine2D(a * b), Affine2D(a) * Affine2D(b));
+
+			Affine2D c(a);
+			c *= Affine2D(b);
+			CustomAssert::AreEqualsMember(Affine2D(a * b), c);
+
+			Affine2D parents[3] = { Affine2D(a), Affine2D(b), Affine2D::MakeIdentity() };
+			Affine2D locals[3] = { Affine2D(b), Affine2D(a), Affine2D(a) };
+			Affine2D world[3];
+			Affine2D::Multiply(parents, locals, world, 3);
+			for (int i = 0; i < 3; i++) {
+				CustomAssert::AreEqualsMember(parents[i] * locals[i], world[i]);
+			}
+		}
+
+		TEST_METHOD(PointsAndVectors)
+		{
+			Matrix3 mat = Matrix3::MakeTRS(Vector2(4, -2), 0.7f, Vector2(2, 0.5f));
+			Affine2D affine(mat);
+
+			for (const Vector2& p : points) {
+				Assert::IsTrue(mat * p == affine * p);
+				Assert::IsTrue(affine.TransformPoint(p) - affine.Translation() == affine.TransformVector(p));
+			}
+
+			Vector2 out[BatchTestLength];
+			affine.TransformPoints(points, out, BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++) {
+				Assert::IsTrue(affine.TransformPoint(points[i]) == out[i]);
+			}
+
+			Vector2Stream stream = Vector2Stream::FromArray(points, BatchTestLength);
+			affine.TransformPoints(stream, stream);
+			for (int i = 0; i < BatchTestLength; i++) {
+				Assert::IsTrue(out[i] == stream.Get(i));
+			}
+		}
+
+		TEST_METHOD(Inverse)
+		{
+			// a sheared transform, which Matrix3::AffineInverted does not handle
+			Affine2D affine(1.5f, 0.25f, -0.75f, 2.0f, 10.0f, -4.0f);
+			Affine2D inverse = affine.Inverted();
+
+			CustomAssert::AreEqualsMember(Affine2D::MakeIdentity(), affine * inverse);
+			CustomAssert::AreEqualsMember(Affine2D::MakeIdentity(), inverse * affine);
+			CustomAssert::AreEqualsMember(Affine2D(affine.ToMatrix3().Inverted()), inverse);
+			for (const Vector2& p : points) {
+				CustomAssert::AreEqualsMember(p, inverse * (affine * p));
+			}
+
+			Assert::IsTrue(Affine2D() == Affine2D::MakeScale(0, 1).Inverted());
+			Assert::AreEqual(affine.ToMatrix3().Determinant(), affine.Determinant(), 1.0e-5f);
+		}
+	};
+}
@@ -0,0 +1,206 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::AABB;
+using MathClasses::AABB2;
+using MathClasses::AABB2Stream;
+using MathClasses::AABBStream;
+using MathClasses::Affine2D;
+using MathClasses::Circle;
+using MathClasses::Frustum;
+using MathClasses::Matrix4;
+using MathClasses::Plane;
+using MathClasses::Sphere;
+using MathClasses::SphereStream;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+
+namespace MathLibraryTests_Bounds
+{
+	// a camera at (2, 1, 10) turned slightly left, looking down -Z
+	Frustum CameraFrustum()
+	{
+		Matrix4 camera = Matrix4::MakeTRS(Vector3(2, 1, 10), Vector3(0, 0.3f, 0), Vector3(1, 1, 1));
+		Matrix4 projection = Matrix4::MakePerspective(1.0f, 16.0f / 9.0f, 0.5f, 100.0f);
+		return Frustum::FromMatrix(projection * camera.AffineInverted());
+	}
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_Bounds;
+
+	TEST_CLASS(BoundsTests)
+	{
+	public:
+		TEST_METHOD(BoxQueries)
+		{
+			const Vector3 points[4] = { { 1, -2, 3 }, { -4, 5, 0 }, { 2, 2, 2 }, { 0, 0, -1 } };
+			AABB box = AABB::FromPoints(points, 4);
+			Assert::IsTrue(box == AABB(Vector3(-4, -2, -1), Vector3(2, 5, 3)));
+			Assert::IsTrue(box.Center() == Vector3(-1, 1.5f, 1));
+			Assert::IsTrue(box.Extents() == Vector3(3, 3.5f, 2));
+			Assert::IsTrue(AABB::FromCenterExtents(box.Center(), box.Extents()) == box);
+
+			for (const Vector3& p : points) {
+				Assert::IsTrue(box.Contains(p));
+			}
+			Assert::IsFalse(box.Contains(Vector3(0, 0, 3.5f)));
+
+			Assert::IsTrue(box.Overlaps(AABB(Vector3(2, 5, 3), Vector3(4, 6, 7))));
+			Assert::IsFalse(box.Overlaps(AABB(Vector3(2.5f, 0, 0), Vector3(4, 1, 1))));
+			Assert::IsTrue(box.Merged(AABB(Vector3(0, 0, 0), Vector3(8, 1, 1))) == AABB(Vector3(-4, -2, -1), Vector3(8, 5, 3)));
+			Assert::IsTrue(box.Expanded(1) == AABB(Vector3(-5, -3, -2), Vector3(3, 6, 4)));
+
+			AABB2 flat(Vector2(0, 0), Vector2(2, 1));
+			Assert::IsTrue(flat.Overlaps(AABB2(Vector2(1, 0.5f), Vector2(3, 3))));
+			Assert::IsFalse(flat.Overlaps(AABB2(Vector2(1, 1.5f), Vector2(3, 3))));
+		}
+
+		TEST_METHOD(TransformedHoldsCorners)
+		{
+			AABB box(Vector3(-1, -2, 0.5f), Vector3(3, 1, 2));
+			Matrix4 transform = Matrix4::MakeTRS(Vector3(5, -3, 2), Vector3(0.4f, -1.1f, 0.7f), Vector3(2, 1, 0.5f));
+			AABB moved = box.Transformed(transform);
+
+			// every transformed corner lies inside, and together they touch each face
+			AABB corners;
+			for (int c = 0; c < 8; c++) {
+				Vector3 corner((c & 1) ? box.max.x : box.min.x, (c & 2) ? box.max.y : box.min.y, (c & 4) ? box.max.z : box.min.z);
+				Vector4 p = transform * Vector4(corner.x, corner.y, corner.z, 1.0f);
+				Vector3 point(p.x, p.y, p.z);
+				if (c == 0) { corners = AABB(point, point); }
+				corners.Encapsulate(point);
+				Assert::IsTrue(moved.Expanded(1.0e-4f).Contains(point));
+			}
+			Assert::IsTrue(corners.min.Distance(moved.min) < 1.0e-4f);
+			Assert::IsTrue(corners.max.Distance(moved.max) < 1.0e-4f);
+		}
+
+		TEST_METHOD(SpheresAndPlanes)
+		{
+			Sphere sphere(Vector3(1, 2, 3), 2);
+			Assert::IsTrue(sphere.Contains(Vector3(1, 2, 5)));
+			Assert::IsFalse(sphere.Contains(Vector3(1, 2, 5.1f)));
+			Assert::IsTrue(sphere.Overlaps(Sphere(Vector3(1, 2, 8), 3)));
+			Assert::IsFalse(sphere.Overlaps(Sphere(Vector3(1, 2, 8), 2.9f)));
+			Assert::IsTrue(sphere.Bounds() == AABB(Vector3(-1, 0, 1), Vector3(3, 4, 5)));
+			Assert::IsTrue(Circle(Vector2(0, 0), 1).Overlaps(Circle(Vector2(1.5f, 0), 0.5f)));
+
+			// counter-clockwise seen from +Y
+			Plane plane = Plane::FromPoints(Vector3(0, 2, 0), Vector3(0, 2, 1), Vector3(1, 2, 0));
+			Assert::IsTrue(plane.normal == Vector3(0, 1, 0));
+			Assert::AreEqual(3.0f, plane.SignedDistance(Vector3(7, 5, -2)));
+			Assert::AreEqual(-2.0f, plane.SignedDistance(Vector3(0, 0, 9)));
+
+			Plane scaled(Vector3(0, 4, 0), -8);
+			Assert::IsTrue(scaled.Normalised() == plane);
+		}
+
+		TEST_METHOD(FrustumFromPerspective)
+		{
+			Frustum frustum = Frustum::FromMatrix(Matrix4::MakePerspective(1.5f, 2.0f, 1.0f, 50.0f));
+			for (const Plane& plane : frustum.planes) {
+				Assert::AreEqual(1.0f, plane.normal.Magnitude(), 1.0e-6f);
+			}
+
+			// the near and far planes sit at z = -1 and z = -50
+			Assert::AreEqual(0.0f, frustum.planes[Frustum::Near].SignedDistance(Vector3(0, 0, -1)), 1.0e-5f);
+			Assert::AreEqual(0.0f, frustum.planes[Frustum::Far].SignedDistance(Vector3(0, 0, -50)), 1.0e-3f);
+
+			Assert::IsTrue(frustum.Contains(Vector3(0, 0, -10)));
+			Assert::IsFalse(frustum.Contains(Vector3(0, 0, 10)));
+			Assert::IsFalse(frustum.Contains(Vector3(0, 0, -0.5f)));
+			Assert::IsFalse(frustum.Contains(Vector3(0, 0, -60)));
+			Assert::IsFalse(frustum.Contains(Vector3(100, 0, -10)));
+			Assert::IsFalse(frustum.Contains(Vector3(0, -100, -10)));
+
+			Assert::IsTrue(frustum.Intersects(Sphere(Vector3(0, 0, 1), 2.5f)));
+			Assert::IsFalse(frustum.Intersects(Sphere(Vector3(0, 0, 1), 1.5f)));
+			Assert::IsTrue(frustum.Intersects(AABB(Vector3(-200, -1, -20), Vector3(0, 1, -5))));
+			Assert::IsFalse(frustum.Intersects(AABB(Vector3(-200, -1, -20), Vector3(-100, 1, -5))));
+		}
+
+		TEST_METHOD(CullMatchesIntersects)
+		{
+			Frustum frustum = CameraFrustum();
+			TestRandom random(44);
+
+			std::vector<Sphere> spheres;
+			std::vector<AABB> boxes;
+			SphereStream sphereStream;
+			AABBStream boxStream;
+			for (size_t i = 0; i < LargeBatchTestLength; i++) {
+				Vector3 center = random.NextVector3(-60.0f, 60.0f);
+				center.y *= 0.25f;
+				Vector3 extents = random.NextVector3(0.1f, 4.0f);
+				spheres.push_back(Sphere(center, extents.x));
+				boxes.push_back(AABB::FromCenterExtents(center, extents));
+				sphereStream.PushBack(spheres.back());
+				boxStream.PushBack(boxes.back());
+			}
+
+			std::vector<uint32_t> expected, visible(LargeBatchTestLength);
+			for (uint32_t i = 0; i < LargeBatchTestLength; i++) {
+				if (frustum.Intersects(spheres[i])) { expected.push_back(i); }
+			}
+			Assert::IsTrue(expected.size() > 50 && expected.size() < 950, L"the scene should be partly visible");
+			size_t count = frustum.CullSpheres(sphereStream, visible.data());
+			Assert::AreEqual(expected.size(), count);
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), visible.begin()));
+
+			expected.clear();
+			for (uint32_t i = 0; i < LargeBatchTestLength; i++) {
+				if (frustum.Intersects(boxes[i])) { expected.push_back(i); }
+			}
+			count = frustum.CullBoxes(boxStream, visible.data());
+			Assert::AreEqual(expected.size(), count);
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), visible.begin()));
+
+			Assert::AreEqual((size_t)0, frustum.CullBoxes(AABBStream(), visible.data()));
+		}
+
+		TEST_METHOD(RectanglesOverlappingView)
+		{
+			AABB2 view(Vector2(0, 0), Vector2(800, 450));
+			TestRandom random(45);
+
+			AABB2Stream rects;
+			for (int i = 0; i < 203; i++) {
+				Vector2 min = random.NextVector2(-400.0f, 1200.0f);
+				rects.PushBack(AABB2(min, min + random.NextVector2(1.0f, 64.0f)));
+			}
+			// touching the edge counts as overlapping
+			rects.Set(5, AABB2(Vector2(800, 10), Vector2(900, 20)));
+
+			std::vector<uint32_t> expected;
+			for (uint32_t i = 0; i < rects.Size(); i++) {
+				if (rects.Get(i).Overlaps(view)) { expected.push_back(i); }
+			}
+			Assert::IsTrue(std::binary_search(expected.begin(), expected.end(), 5u));
+
+			std::vector<uint32_t> visible(rects.Size());
+			size_t count = rects.Overlapping(view, visible.data());
+			Assert::AreEqual(expected.size(), count);
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), visible.begin()));
+
+			// a rotated rectangle's bounds hold all of its corners
+			AABB2 local(Vector2(-16, -8), Vector2(16, 8));
+			Affine2D transform = Affine2D::MakeTRS(Vector2(100, 50), 0.5f, Vector2(2, 1));
+			AABB2 world = local.Transformed(transform);
+			for (int c = 0; c < 4; c++) {
+				Vector2 corner((c & 1) ? local.max.x : local.min.x, (c & 2) ? local.max.y : local.min.y);
+				Assert::IsTrue(world.Expanded(1.0e-4f).Contains(transform * corner));
+			}
+			Assert::IsTrue(world.Center() == Vector2(100, 50));
+		}
+	};
+}
@@ -0,0 +1,268 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::AABB;
+using MathClasses::AABB2;
+using MathClasses::IndexPair;
+using MathClasses::SpatialHashGrid;
+using MathClasses::SweepAndPrune2;
+using MathClasses::SweepAndPrune3;
+using MathClasses::Vector2;
+using MathClasses::Vector2Stream;
+using MathClasses::Vector3;
+
+namespace MathLibraryTests_Broadphase
+{
+	std::vector<IndexPair> BruteForcePairs(const std::vector<Vector2>& points, float distance)
+	{
+		std::vector<IndexPair> pairs;
+		for (uint32_t a = 0; a < points.size(); a++) {
+			for (uint32_t b = a + 1; b < points.size(); b++) {
+				if ((points[b] - points[a]).MagnitudeSqr() <= distance * distance) { pairs.push_back({ a, b }); }
+			}
+		}
+		return pairs;
+	}
+
+	template<typename Box>
+	std::vector<IndexPair> BruteForceOverlaps(const std::vector<Box>& boxes, const std::vector<bool>& alive)
+	{
+		std::vector<IndexPair> pairs;
+		for (uint32_t a = 0; a < boxes.size(); a++) {
+			for (uint32_t b = a + 1; b < boxes.size(); b++) {
+				if (alive[a] && alive[b] && boxes[a].Overlaps(boxes[b])) { pairs.push_back({ a, b }); }
+			}
+		}
+		return pairs;
+	}
+
+	std::vector<IndexPair> Sorted(std::vector<IndexPair> pairs)
+	{
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	// checks that the pairs before an update, with the update's events applied, give the pairs after it
+	template<typename Broadphase>
+	void AssertEventsExplainChange(std::vector<IndexPair> before, const Broadphase& broadphase)
+	{
+		for (const IndexPair& pair : broadphase.Removed()) {
+			auto found = std::find(before.begin(), before.end(), pair);
+			Assert::IsTrue(found != before.end());
+			before.erase(found);
+		}
+		for (const IndexPair& pair : broadphase.Added()) {
+			Assert::IsTrue(std::find(before.begin(), before.end(), pair) == before.end());
+			before.push_back(pair);
+		}
+		Assert::IsTrue(Sorted(before) == Sorted(broadphase.Pairs()));
+	}
+}
+
+using namespace MathLibraryTests_Broadphase;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(BroadphaseTests)
+	{
+	public:
+		TEST_METHOD(PairsMatchBruteForce)
+		{
+			std::vector<Vector2> points = TestRandom(24).Vector2s(1500, -60.0f, 60.0f);
+			std::vector<IndexPair> expected = BruteForcePairs(points, 2.5f);
+			Assert::IsTrue(expected.size() > 100);
+
+			SpatialHashGrid grid(2.5f);
+			grid.Build(points.data(), points.size());
+			Assert::AreEqual(points.size(), grid.Size());
+
+			std::vector<IndexPair> pairs;
+			Assert::AreEqual(expected.size(), grid.FindPairs(2.5f, pairs));
+			for (const IndexPair& pair : pairs) {
+				Assert::IsTrue(pair.a < pair.b);
+			}
+			std::sort(pairs.begin(), pairs.end());
+			Assert::IsTrue(pairs == expected);
+
+			// a shorter distance than the cell size finds a subset
+			Assert::AreEqual(BruteForcePairs(points, 1.0f).size(), grid.FindPairs(1.0f, pairs));
+
+			// the stream overload sorts the same way
+			grid.Build(Vector2Stream::FromArray(points.data(), points.size()));
+			grid.FindPairs(2.5f, pairs);
+			std::sort(pairs.begin(), pairs.end());
+			Assert::IsTrue(pairs == expected);
+		}
+
+		TEST_METHOD(SharedBucketsNeitherMissNorRepeat)
+		{
+			// four buckets for thousands of cells, so nearly every cell shares
+			// a bucket with its neighbours
+			std::vector<Vector2> points = TestRandom(25).Vector2s(800, -40.0f, 40.0f);
+			SpatialHashGrid grid(3.0f, 4);
+			Assert::AreEqual((size_t)4, grid.BucketCount());
+			grid.Build(points.data(), points.size());
+
+			std::vector<IndexPair> pairs;
+			grid.FindPairs(3.0f, pairs);
+			std::sort(pairs.begin(), pairs.end());
+			Assert::IsTrue(pairs == BruteForcePairs(points, 3.0f));
+
+			// negative coordinates and cell boundaries
+			std::vector<Vector2> edges = { Vector2(-3, -3), Vector2(0, 0), Vector2(-0.5f, 0), Vector2(3, 0), Vector2(5.9f, 0) };
+			grid.Build(edges.data(), edges.size());
+			grid.FindPairs(3.0f, pairs);
+			std::sort(pairs.begin(), pairs.end());
+			Assert::IsTrue(pairs == BruteForcePairs(edges, 3.0f));
+		}
+
+		TEST_METHOD(QueryMatchesBruteForce)
+		{
+			std::vector<Vector2> points = TestRandom(26).Vector2s(2000, -50.0f, 50.0f);
+			SpatialHashGrid grid(4.0f, 256);
+			grid.Build(points.data(), points.size());
+
+			std::vector<uint32_t> found;
+			for (Vector2 center : { Vector2(0, 0), Vector2(-49, 12.5f), Vector2(8, -8), Vector2(200, 200) }) {
+				for (float radius : { 0.5f, 2.0f, 4.0f }) {
+					std::vector<uint32_t> expected;
+					for (uint32_t i = 0; i < points.size(); i++) {
+						if ((points[i] - center).MagnitudeSqr() <= radius * radius) { expected.push_back(i); }
+					}
+					grid.Query(center, radius, found);
+					std::sort(found.begin(), found.end());
+					Assert::IsTrue(found == expected);
+				}
+			}
+		}
+
+		TEST_METHOD(RebuildReusesStorage)
+		{
+			std::vector<Vector2> points = TestRandom(27).Vector2s(3000, -80.0f, 80.0f);
+			SpatialHashGrid grid(2.0f);
+			std::vector<IndexPair> pairs;
+			grid.Build(points.data(), points.size());
+			grid.FindPairs(2.0f, pairs);
+			pairs.reserve(pairs.size() * 2);
+			const IndexPair* pairStorage = pairs.data();
+
+			// every object moves and the grid is rebuilt, as it would be each tick
+			for (int tick = 0; tick < 5; tick++) {
+				for (Vector2& point : points) {
+					point = point + Vector2(0.25f, -0.125f);
+				}
+				grid.Build(points.data(), points.size());
+				std::vector<IndexPair> expected = BruteForcePairs(points, 2.0f);
+				Assert::AreEqual(expected.size(), grid.FindPairs(2.0f, pairs));
+				Assert::IsTrue(pairStorage == pairs.data());
+			}
+
+			// an empty grid finds nothing
+			grid.Build(points.data(), 0);
+			Assert::AreEqual((size_t)0, grid.FindPairs(2.0f, pairs));
+		}
+
+		TEST_METHOD(SweepAndPruneFollowsMovingBoxes)
+		{
+			// boxes from tiny to a fifth of the world wide, drifting a little each frame
+			TestRandom random(28);
+
+			std::vector<AABB2> boxes;
+			std::vector<bool> alive;
+			SweepAndPrune2 broadphase;
+			for (int i = 0; i < 400; i++) {
+				boxes.push_back(AABB2::FromCenterExtents(random.NextVector2(-50.0f, 50.0f), random.NextVector2(0.1f, 10.0f)));
+				alive.push_back(true);
+				Assert::AreEqual((uint32_t)i, broadphase.Add(boxes.back()));
+			}
+			broadphase.Update();
+			Assert::AreEqual((size_t)400, broadphase.Size());
+			Assert::IsTrue(Sorted(broadphase.Pairs()) == BruteForceOverlaps(boxes, alive));
+			Assert::AreEqual(broadphase.Pairs().size(), broadphase.Added().size());
+
+			for (int frame = 0; frame < 30; frame++) {
+				for (uint32_t i = 0; i < boxes.size(); i++) {
+					Vector2 offset = random.NextVector2(-0.5f, 0.5f);
+					boxes[i] = AABB2(boxes[i].min + offset, boxes[i].max + offset);
+					broadphase.SetBounds(i, boxes[i]);
+				}
+				std::vector<IndexPair> before = broadphase.Pairs();
+				broadphase.Update();
+				Assert::IsTrue(Sorted(broadphase.Pairs()) == BruteForceOverlaps(boxes, alive));
+				AssertEventsExplainChange(before, broadphase);
+			}
+
+			// boxes that only touch count as overlapping, as BoundingBox::Overlaps does
+			SweepAndPrune2 touching;
+			touching.Add(AABB2(Vector2(0, 0), Vector2(1, 1)));
+			touching.Add(AABB2(Vector2(1, 1), Vector2(2, 2)));
+			touching.Update();
+			Assert::AreEqual((size_t)1, touching.Pairs().size());
+			touching.SetBounds(1, AABB2(Vector2(1.5f, 1), Vector2(2, 2)));
+			touching.Update();
+			Assert::AreEqual((size_t)0, touching.Pairs().size());
+			Assert::IsTrue(touching.Removed()[0] == IndexPair{ 0, 1 });
+		}
+
+		TEST_METHOD(SweepAndPruneAddAndRemove)
+		{
+			TestRandom random(29);
+			auto randomBox = [&] {
+				return AABB::FromCenterExtents(random.NextVector3(-20.0f, 20.0f), random.NextVector3(0.5f, 4.0f));
+			};
+
+			std::vector<AABB> boxes;
+			std::vector<bool> alive;
+			SweepAndPrune3 broadphase;
+			for (int i = 0; i < 300; i++) {
+				boxes.push_back(randomBox());
+				alive.push_back(true);
+				broadphase.Add(boxes.back());
+			}
+			broadphase.Update();
+			Assert::IsTrue(Sorted(broadphase.Pairs()) == BruteForceOverlaps(boxes, alive));
+
+			// a few objects leave and arrive each frame, so the ends are sorted in one at a time
+			for (int frame = 0; frame < 20; frame++) {
+				std::vector<IndexPair> before = broadphase.Pairs();
+				for (int k = 0; k < 5; k++) {
+					uint32_t handle = random.NextBits() % boxes.size();
+					if (alive[handle]) {
+						broadphase.Remove(handle);
+						alive[handle] = false;
+					}
+				}
+				for (int k = 0; k < 4; k++) {
+					AABB box = randomBox();
+					uint32_t handle = broadphase.Add(box);
+					Assert::IsTrue(handle <= boxes.size());
+					if (handle == boxes.size()) {
+						boxes.push_back(box);
+						alive.push_back(true);
+					} else {
+						// only handles freed by an earlier Update() are reused
+						Assert::IsFalse(alive[handle]);
+						boxes[handle] = box;
+						alive[handle] = true;
+					}
+				}
+				broadphase.Update();
+
+				size_t liveCount = std::count(alive.begin(), alive.end(), true);
+				Assert::AreEqual(liveCount, broadphase.Size());
+				Assert::IsTrue(Sorted(broadphase.Pairs()) == BruteForceOverlaps(boxes, alive));
+				AssertEventsExplainChange(before, broadphase);
+				for (const IndexPair& pair : broadphase.Removed()) {
+					Assert::IsTrue(!alive[pair.a] || !alive[pair.b] || !boxes[pair.a].Overlaps(boxes[pair.b]));
+				}
+			}
+		}
+	};
+}
@@ -0,0 +1,278 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::AABB;
+using MathClasses::AABB2;
+using MathClasses::AABB2Stream;
+using MathClasses::Capsule2;
+using MathClasses::Capsule3;
+using MathClasses::Circle;
+using MathClasses::CircleStream;
+using MathClasses::Contact2;
+using MathClasses::Contact3;
+using MathClasses::OBB2;
+using MathClasses::Segment2;
+using MathClasses::Segment3;
+using MathClasses::Sphere;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+namespace Collision = MathClasses::Collision;
+
+namespace MathLibraryTests_Collision
+{
+	struct Scene
+	{
+		CircleStream circles;
+		AABB2Stream boxes;
+	};
+
+	Scene RandomScene(unsigned seed)
+	{
+		MathLibraryTests::TestRandom random(seed);
+		Scene scene;
+		for (size_t i = 0; i < MathLibraryTests::LargeBatchTestLength; i++) {
+			Vector2 center = random.NextVector2(-50.0f, 50.0f);
+			scene.circles.PushBack(Circle(center, random.NextFloat(0.5f, 6.0f)));
+			scene.boxes.PushBack(AABB2::FromCenterExtents(center, random.NextVector2(0.5f, 6.0f)));
+		}
+		return scene;
+	}
+
+	// checks a hit mask and its count against a scalar test of each candidate
+	template<typename Fn>
+	void AssertMask(const std::vector<uint32_t>& mask, size_t hits, size_t count, Fn&& overlaps)
+	{
+		size_t expected = 0;
+		for (size_t i = 0; i < count; i++) {
+			Assert::AreEqual(overlaps(i), Collision::IsHit(mask.data(), i));
+			expected += overlaps(i) ? 1 : 0;
+		}
+		Assert::AreEqual(expected, hits);
+		Assert::IsTrue(hits > 0 && hits < count, L"the query should hit some candidates but not all");
+	}
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_Collision;
+
+	TEST_CLASS(CollisionTests)
+	{
+	public:
+		TEST_METHOD(Spheres)
+		{
+			Contact2 contact;
+			Assert::IsTrue(Collision::Intersect(Circle(Vector2(0, 0), 2), Circle(Vector2(3, 0), 2), contact));
+			CustomAssert::AreEqualsMember(Vector2(1, 0), contact.normal);
+			Assert::AreEqual(1.0f, contact.depth);
+			CustomAssert::AreEqualsMember(Vector2(1.5f, 0), contact.point);
+
+			// touching counts, with no depth
+			Assert::IsTrue(Collision::Intersect(Circle(Vector2(0, 0), 1), Circle(Vector2(0, -3), 2), contact));
+			CustomAssert::AreEqualsMember(Vector2(0, -1), contact.normal);
+			Assert::AreEqual(0.0f, contact.depth);
+			Assert::IsFalse(Collision::Overlaps(Circle(Vector2(0, 0), 1), Circle(Vector2(0, -3.01f), 2)));
+
+			Contact3 contact3;
+			Assert::IsTrue(Collision::Intersect(Sphere(Vector3(1, 1, 1), 1), Sphere(Vector3(1, 1, 1), 1), contact3));
+			Assert::AreEqual(2.0f, contact3.depth);
+			Assert::AreEqual(1.0f, contact3.normal.Magnitude());
+		}
+
+		TEST_METHOD(SphereAndBox)
+		{
+			AABB2 box(Vector2(0, 0), Vector2(4, 2));
+			Contact2 contact;
+
+			// outside, past the right face
+			Assert::IsTrue(Collision::Intersect(Circle(Vector2(5, 1), 1.5f), box, contact));
+			CustomAssert::AreEqualsMember(Vector2(-1, 0), contact.normal);
+			Assert::AreEqual(0.5f, contact.depth);
+			CustomAssert::AreEqualsMember(Vector2(4, 1), contact.point);
+
+			// outside, near a corner
+			Assert::IsFalse(Collision::Overlaps(Circle(Vector2(5, 3), 1.4f), box));
+			Assert::IsTrue(Collision::Overlaps(Circle(Vector2(5, 3), 1.5f), box));
+
+			// centre inside, nearest the bottom face
+			Assert::IsTrue(Collision::Intersect(Circle(Vector2(2, 0.25f), 0.5f), box, contact));
+			CustomAssert::AreEqualsMember(Vector2(0, 1), contact.normal);
+			Assert::AreEqual(0.75f, contact.depth);
+			CustomAssert::AreEqualsMember(Vector2(2, 0), contact.point);
+
+			// the same contact seen from the box
+			Assert::IsTrue(Collision::Intersect(box, Circle(Vector2(2, 0.25f), 0.5f), contact));
+			CustomAssert::AreEqualsMember(Vector2(0, -1), contact.normal);
+
+			Contact3 contact3;
+			Assert::IsTrue(Collision::Intersect(Sphere(Vector3(0, 0, 3), 1.5f), AABB(Vector3(-1, -1, -1), Vector3(1, 1, 2)), contact3));
+			CustomAssert::AreEqualsMember(Vector3(0, 0, -1), contact3.normal);
+			Assert::AreEqual(0.5f, contact3.depth);
+		}
+
+		TEST_METHOD(Boxes)
+		{
+			Contact2 contact;
+			Assert::IsTrue(Collision::Intersect(AABB2(Vector2(0, 0), Vector2(4, 4)), AABB2(Vector2(3, 1), Vector2(8, 2)), contact));
+			CustomAssert::AreEqualsMember(Vector2(1, 0), contact.normal);
+			Assert::AreEqual(1.0f, contact.depth);
+			CustomAssert::AreEqualsMember(Vector2(3.5f, 1.5f), contact.point);
+
+			Assert::IsTrue(Collision::Intersect(AABB2(Vector2(0, 0), Vector2(4, 4)), AABB2(Vector2(-2, -1), Vector2(5, 0.5f)), contact));
+			CustomAssert::AreEqualsMember(Vector2(0, -1), contact.normal);
+			Assert::AreEqual(0.5f, contact.depth);
+
+			Assert::IsFalse(Collision::Intersect(AABB2(Vector2(0, 0), Vector2(4, 4)), AABB2(Vector2(4.5f, 0), Vector2(5, 1)), contact));
+		}
+
+		TEST_METHOD(Capsules)
+		{
+			Capsule2 capsule(Vector2(0, 0), Vector2(10, 0), 1);
+			Contact2 contact;
+
+			Assert::IsTrue(Collision::Intersect(capsule, Circle(Vector2(4, 1.5f), 1), contact));
+			CustomAssert::AreEqualsMember(Vector2(0, 1), contact.normal);
+			Assert::AreEqual(0.5f, contact.depth);
+			Assert::IsFalse(Collision::Overlaps(capsule, Circle(Vector2(12.1f, 0), 1)));
+			Assert::IsTrue(Collision::Overlaps(Circle(Vector2(11.9f, 0), 1), capsule));
+
+			// crossing capsules, and parallel ones side by side
+			Assert::IsTrue(Collision::Overlaps(capsule, Capsule2(Vector2(5, -5), Vector2(5, 5), 0.1f)));
+			Assert::IsTrue(Collision::Intersect(capsule, Capsule2(Vector2(2, 1.5f), Vector2(8, 1.5f), 1), contact));
+			CustomAssert::AreEqualsMember(Vector2(0, 1), contact.normal);
+			Assert::AreEqual(0.5f, contact.depth);
+			Assert::IsFalse(Collision::Overlaps(capsule, Capsule2(Vector2(-5, 3), Vector2(20, 3), 0.9f)));
+
+			// a capsule that is a point behaves as a sphere
+			Assert::IsTrue(Collision::Overlaps(Capsule3(Vector3(0, 0, 0), Vector3(0, 0, 0), 1), Capsule3(Vector3(-1, 1.9f, 0), Vector3(1, 1.9f, 0), 1)));
+			Assert::IsFalse(Collision::Overlaps(Capsule3(Vector3(0, 0, 0), Vector3(0, 0, 0), 1), Capsule3(Vector3(-1, 2.1f, 0), Vector3(1, 2.1f, 0), 1)));
+		}
+
+		TEST_METHOD(Segments)
+		{
+			float t = -1;
+			Assert::IsTrue(Collision::Cast(Segment2(Vector2(-10, 0), Vector2(10, 0)), Circle(Vector2(0, 0), 2), t));
+			Assert::AreEqual(0.4f, t, 1.0e-6f);
+			Assert::IsFalse(Collision::Cast(Segment2(Vector2(-10, 0), Vector2(-3, 0)), Circle(Vector2(0, 0), 2), t));
+			Assert::IsFalse(Collision::Cast(Segment2(Vector2(10, 0), Vector2(20, 0)), Circle(Vector2(0, 0), 2), t));
+			Assert::IsTrue(Collision::Cast(Segment3(Vector3(0, 0, 1), Vector3(0, 0, 9)), Sphere(Vector3(0, 0, 0), 2), t));
+			Assert::AreEqual(0.0f, t);
+
+			AABB2 box(Vector2(2, -1), Vector2(4, 1));
+			Assert::IsTrue(Collision::Cast(Segment2(Vector2(0, 0), Vector2(8, 0)), box, t));
+			Assert::AreEqual(0.25f, t);
+			Assert::IsTrue(Collision::Cast(Segment2(Vector2(3, 5), Vector2(3, -5)), box, t));
+			Assert::AreEqual(0.4f, t);
+			Assert::IsFalse(Collision::Cast(Segment2(Vector2(5, 5), Vector2(5, -5)), box, t));
+			Assert::IsFalse(Collision::Overlaps(Segment2(Vector2(0, 0), Vector2(1.9f, 0)), box));
+			Assert::IsTrue(Collision::Overlaps(Segment2(Vector2(0, 3), Vector2(6, -3)), box));
+			Assert::IsTrue(Collision::Overlaps(Segment2(Vector2(0, 3), Vector2(6, -3)), Circle(Vector2(3, 0), 0.1f)));
+
+			// the same segment against the box turned a quarter turn
+			Assert::IsTrue(Collision::Cast(Segment2(Vector2(0, 0), Vector2(8, 0)), OBB2::FromRotation(Vector2(3, 0), Vector2(4, 1), 1.5707964f), t));
+			Assert::AreEqual(0.25f, t, 1.0e-6f);
+		}
+
+		TEST_METHOD(RotatedBoxes)
+		{
+			// two unit squares, one turned 45 degrees: their bounds overlap
+			// before they do
+			OBB2 square(Vector2(0, 0), Vector2(1, 1));
+			OBB2 diamond = OBB2::FromRotation(Vector2(1.9f, 1.9f), Vector2(1, 1), 0.7853982f);
+			Assert::IsTrue(square.Bounds().Overlaps(diamond.Bounds()));
+			Assert::IsFalse(Collision::Overlaps(square, diamond));
+
+			diamond.center = Vector2(2.3f, 0);
+			Contact2 contact;
+			Assert::IsTrue(Collision::Intersect(square, diamond, contact));
+			CustomAssert::AreEqualsMember(Vector2(1, 0), contact.normal);
+			Assert::AreEqual(1.0f + 1.4142135f - 2.3f, contact.depth, 1.0e-5f);
+			CustomAssert::AreEqualsMember(Vector2(2.3f - 1.4142135f, 0), contact.point);
+			Assert::IsTrue(Collision::Overlaps(AABB2(Vector2(-1, -1), Vector2(1, 1)), diamond));
+
+			// a circle against a rotated box matches the box's own frame
+			Assert::IsTrue(Collision::Intersect(Circle(Vector2(2.3f - 1.4142135f - 0.4f, 0), 0.5f), diamond, contact));
+			CustomAssert::AreEqualsMember(Vector2(1, 0), contact.normal);
+			Assert::AreEqual(0.1f, contact.depth, 1.0e-5f);
+			Assert::IsFalse(Collision::Overlaps(diamond, Circle(Vector2(2.3f, 2.0f), 0.5f)));
+			Assert::IsTrue(Collision::Overlaps(diamond, Circle(Vector2(2.3f, 1.8f), 0.5f)));
+
+			Vector2 corners[4];
+			diamond.Corners(corners);
+			for (const Vector2& corner : corners) {
+				Assert::IsTrue(diamond.Bounds().Expanded(1.0e-5f).Contains(corner));
+			}
+		}
+
+		TEST_METHOD(BatchMasksMatchScalar)
+		{
+			Scene scene = RandomScene(46);
+			const size_t count = scene.circles.Size();
+			std::vector<uint32_t> mask(Collision::MaskWords(count));
+
+			Circle circle(Vector2(3, -4), 12);
+			size_t hits = Collision::OverlapMask(circle, scene.circles, mask.data());
+			AssertMask(mask, hits, count, [&](size_t i) { return Collision::Overlaps(circle, scene.circles.Get(i)); });
+
+			hits = Collision::OverlapMask(circle, scene.boxes, mask.data());
+			AssertMask(mask, hits, count, [&](size_t i) { return Collision::Overlaps(circle, scene.boxes.Get(i)); });
+
+			AABB2 box(Vector2(-20, 5), Vector2(-5, 25));
+			hits = Collision::OverlapMask(box, scene.boxes, mask.data());
+			AssertMask(mask, hits, count, [&](size_t i) { return Collision::Overlaps(box, scene.boxes.Get(i)); });
+
+			Capsule2 capsule(Vector2(-40, -30), Vector2(35, 20), 3);
+			hits = Collision::OverlapMask(capsule, scene.circles, mask.data());
+			AssertMask(mask, hits, count, [&](size_t i) { return Collision::Overlaps(capsule, scene.circles.Get(i)); });
+
+			// a diagonal segment, and segments parallel to each axis
+			const Segment2 segments[3] = {
+				{ Vector2(-45, 40), Vector2(45, -35) }, { Vector2(-45, 7), Vector2(45, 7) }, { Vector2(-3, -50), Vector2(-3, 50) }
+			};
+			for (const Segment2& segment : segments) {
+				hits = Collision::OverlapMask(segment, scene.boxes, mask.data());
+				AssertMask(mask, hits, count, [&](size_t i) { return Collision::Overlaps(segment, scene.boxes.Get(i)); });
+			}
+		}
+
+		TEST_METHOD(BatchContactsMatchScalar)
+		{
+			Scene scene = RandomScene(47);
+			const size_t count = scene.circles.Size();
+			std::vector<uint32_t> indices(count);
+			std::vector<Contact2> contacts(count);
+
+			auto check = [&](size_t written, auto&& intersect) {
+				size_t next = 0;
+				for (size_t i = 0; i < count; i++) {
+					Contact2 expected;
+					if (!intersect(i, expected)) { continue; }
+					Assert::IsTrue(next < written);
+					Assert::AreEqual((uint32_t)i, indices[next]);
+					Assert::IsTrue(expected.normal == contacts[next].normal && expected.point == contacts[next].point);
+					Assert::AreEqual(expected.depth, contacts[next].depth);
+					next++;
+				}
+				Assert::AreEqual(next, written);
+				Assert::IsTrue(written > 0);
+			};
+
+			Circle circle(Vector2(-6, 10), 9);
+			check(Collision::Contacts(circle, scene.circles, indices.data(), contacts.data()),
+				[&](size_t i, Contact2& c) { return Collision::Intersect(circle, scene.circles.Get(i), c); });
+			check(Collision::Contacts(circle, scene.boxes, indices.data(), contacts.data()),
+				[&](size_t i, Contact2& c) { return Collision::Intersect(circle, scene.boxes.Get(i), c); });
+
+			AABB2 box(Vector2(10, -30), Vector2(30, -10));
+			check(Collision::Contacts(box, scene.boxes, indices.data(), contacts.data()),
+				[&](size_t i, Contact2& c) { return Collision::Intersect(box, scene.boxes.Get(i), c); });
+		}
+	};
+}
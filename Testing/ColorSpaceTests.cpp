@@ -0,0 +1,218 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using ::MathClasses::Color;
+using ::MathClasses::HSV;
+using ::MathClasses::Vector4;
+namespace ColorSpace = ::MathClasses::ColorSpace;
+
+namespace MathLibraryTests_ColorSpace
+{
+	// the exact sRGB transfer functions, in double
+	double ReferenceDecode(double c)
+	{
+		return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+	}
+
+	double ReferenceEncode(double x)
+	{
+		return x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055;
+	}
+
+	// the textbook RGB to HSV conversion, in double
+	void ReferenceHsv(Color c, double& h, double& s, double& v)
+	{
+		double r = c.r / 255.0, g = c.g / 255.0, b = c.b / 255.0;
+		double max = std::max({ r, g, b }), min = std::min({ r, g, b });
+		double delta = max - min;
+		v = max;
+		s = max > 0 ? delta / max : 0;
+		h = 0;
+		if (delta > 0) {
+			if (max == r) { h = 60.0 * std::fmod((g - b) / delta + 6.0, 6.0); }
+			else if (max == g) { h = 60.0 * ((b - r) / delta + 2.0); }
+			else { h = 60.0 * ((r - g) / delta + 4.0); }
+		}
+	}
+
+	int MaxChannelDifference(Color a, Color b)
+	{
+		int worst = 0;
+		for (int c = 0; c < 4; c++) {
+			worst = std::max(worst, std::abs((int)a[c] - (int)b[c]));
+		}
+		return worst;
+	}
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_ColorSpace;
+
+	TEST_CLASS(ColorSpaceTests)
+	{
+	public:
+		TEST_METHOD(DecodeTableMatchesReference)
+		{
+			for (int i = 0; i < 256; i++) {
+				double expected = ReferenceDecode(i / 255.0);
+				Assert::AreEqual(expected, (double)ColorSpace::SrgbToLinear((uint8_t)i), 1.0e-7 + expected * 1.0e-7);
+			}
+		}
+
+		TEST_METHOD(EncodeWithinQuarterStep)
+		{
+			for (int i = 0; i <= 100000; i++) {
+				float x = i / 100000.0f;
+				double error = (ColorSpace::LinearToSrgb(x) - ReferenceEncode(x)) * 255.0;
+				Assert::IsTrue(std::abs(error) < 0.25, L"sRGB encode strayed more than a quarter step");
+			}
+			Assert::AreEqual(0.0f, ColorSpace::LinearToSrgb(-1.0f));
+			Assert::AreEqual(1.0f, ColorSpace::LinearToSrgb(2.0f));
+		}
+
+		TEST_METHOD(SrgbRoundTripIsExact)
+		{
+			// every byte value in every channel, with a tail past the last four
+			std::vector<Color> in(258);
+			for (size_t i = 0; i < in.size(); i++) {
+				in[i] = Color((uint8_t)i, (uint8_t)(255 - i), (uint8_t)(i * 37), (uint8_t)(i * 5));
+			}
+
+			std::vector<Vector4> linear(in.size());
+			std::vector<Color> out(in.size());
+			ColorSpace::SrgbToLinear(in.data(), linear.data(), in.size());
+			ColorSpace::LinearToSrgb(linear.data(), out.data(), linear.size());
+
+			for (size_t i = 0; i < in.size(); i++) {
+				Assert::AreEqual(in[i], out[i]);
+				Assert::AreEqual(in[i], ColorSpace::LinearToSrgb(ColorSpace::SrgbToLinear(in[i])));
+			}
+		}
+
+		TEST_METHOD(SrgbEncodeBatchMatchesScalar)
+		{
+			TestRandom random(21);
+			std::vector<Vector4> linear(LargeBatchTestLength);
+			for (Vector4& v : linear) {
+				float r = random.NextFloat(-0.25f, 1.25f);
+				float g = random.NextFloat(-0.25f, 1.25f) * 0.01f;
+				float b = random.NextFloat(-0.25f, 1.25f);
+				v = Vector4(r, g, b, random.NextFloat(-0.25f, 1.25f));
+			}
+
+			std::vector<Color> out(linear.size());
+			ColorSpace::LinearToSrgb(linear.data(), out.data(), linear.size());
+			for (size_t i = 0; i < linear.size(); i++) {
+				Assert::AreEqual(ColorSpace::LinearToSrgb(linear[i]), out[i]);
+			}
+		}
+
+		TEST_METHOD(HsvMatchesReference)
+		{
+			std::vector<Color> in = TestRandom(22).Colors(1021);
+			in[0] = Color(255, 0, 0);
+			in[1] = Color(0, 255, 0);
+			in[2] = Color(0, 0, 255);
+			in[3] = Color(128, 128, 128);
+			in[4] = Color(0, 0, 0, 0);
+			in[5] = Color(255, 0, 1);
+
+			std::vector<HSV> hsv(in.size());
+			ColorSpace::RgbToHsv(in.data(), hsv.data(), in.size());
+
+			for (size_t i = 0; i < in.size(); i++) {
+				double h, s, v;
+				ReferenceHsv(in[i], h, s, v);
+				Assert::AreEqual(h, (double)hsv[i].h, 1.0e-3);
+				Assert::AreEqual(s, (double)hsv[i].s, 1.0e-6);
+				Assert::AreEqual(v, (double)hsv[i].v, 1.0e-6);
+				Assert::AreEqual(in[i].a / 255.0, (double)hsv[i].a, 1.0e-6);
+
+				HSV scalar = ColorSpace::RgbToHsv(in[i]);
+				Assert::AreEqual(scalar.h, hsv[i].h);
+				Assert::AreEqual(scalar.s, hsv[i].s);
+				Assert::AreEqual(scalar.v, hsv[i].v);
+			}
+			Assert::AreEqual(240.0f, hsv[2].h);
+			Assert::IsTrue(hsv[5].h < 360.0f && hsv[5].h > 359.0f);
+		}
+
+		TEST_METHOD(HsvRoundTripWithinOneStep)
+		{
+			std::vector<Color> in;
+			for (int r = 0; r < 256; r += 5) {
+				for (int g = 0; g < 256; g += 3) {
+					for (int b = 0; b < 256; b += 7) {
+						in.push_back(Color((uint8_t)r, (uint8_t)g, (uint8_t)b, (uint8_t)(r ^ g)));
+					}
+				}
+			}
+
+			std::vector<HSV> hsv(in.size());
+			std::vector<Color> out(in.size());
+			ColorSpace::RgbToHsv(in.data(), hsv.data(), in.size());
+			ColorSpace::HsvToRgb(hsv.data(), out.data(), hsv.size());
+
+			for (size_t i = 0; i < in.size(); i++) {
+				Assert::IsTrue(MaxChannelDifference(in[i], out[i]) <= 1);
+				Assert::AreEqual(ColorSpace::HsvToRgb(hsv[i]), out[i]);
+			}
+		}
+
+		TEST_METHOD(ShiftHue)
+		{
+			Color in[7] = { Color(255, 0, 0), Color(0, 255, 0, 7), Color(0, 0, 255), Color(90, 90, 90, 90),
+							Color(250, 200, 10), Color(13, 200, 180, 0), Color(255, 0, 0) };
+			Color out[7];
+
+			ColorSpace::ShiftHue(in, 120.0f, out, 7);
+			Assert::AreEqual(Color(0, 255, 0), out[0]);
+			Assert::AreEqual(Color(0, 0, 255, 7), out[1]);
+			Assert::AreEqual(Color(255, 0, 0), out[2]);
+			Assert::AreEqual(in[3], out[3]);
+			Assert::AreEqual(Color(0, 255, 0), out[6]);
+
+			// a turn in either direction lands on the same hue
+			Color wrapped[7];
+			ColorSpace::ShiftHue(in, -240.0f, wrapped, 7);
+			for (int i = 0; i < 7; i++) {
+				Assert::IsTrue(MaxChannelDifference(out[i], wrapped[i]) <= 1);
+			}
+
+			ColorSpace::ShiftHue(in, 720.0f, out, 7);
+			for (int i = 0; i < 7; i++) {
+				Assert::IsTrue(MaxChannelDifference(in[i], out[i]) <= 1);
+				Assert::AreEqual(in[i].a, out[i].a);
+			}
+		}
+
+		TEST_METHOD(LerpLinearKeepsBrightness)
+		{
+			Color black(0, 0, 0), white(255, 255, 255);
+			Color start[5] = { black, black, black, black, black };
+			Color end[5] = { white, white, white, white, white };
+			Color out[5];
+
+			ColorSpace::LerpLinear(start, end, 0.0f, out, 5);
+			Assert::AreEqual(black, out[4]);
+			ColorSpace::LerpLinear(start, end, 1.0f, out, 5);
+			Assert::AreEqual(white, out[4]);
+
+			// halfway in linear light is 50% brightness, which sRGB encodes
+			// near 188 rather than the 128 a byte lerp gives
+			ColorSpace::LerpLinear(start, end, 0.5f, out, 5);
+			Assert::IsTrue(out[0].r >= 187 && out[0].r <= 188);
+			Assert::AreEqual(out[0], out[4]);
+		}
+	};
+}
@@ -2,9 +2,24 @@
 
 #include "MathLibraryTests.h"
 #include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using ::MathClasses::Color;
+using ::MathClasses::Vector4;
+namespace ColorKernels = ::MathClasses::ColorKernels;
+
+namespace MathLibraryTests_Color
+{
+	// byte math rounds to nearest, so identities hold exactly
+	static_assert(Color(200, 100, 50, 25) * Color(255, 255, 255, 255) == Color(200, 100, 50, 25));
+	static_assert(Color(255, 128, 1, 255) * Color(128, 128, 128, 128) == Color(128, 64, 1, 128));
+	static_assert(Color::Blend(Color(10, 20, 30, 255), Color(200, 200, 200, 255)) == Color(10, 20, 30, 255));
+	static_assert(Color::Blend(Color(10, 20, 30, 0), Color(200, 200, 200, 77)) == Color(200, 200, 200, 77));
+	static_assert(Color(255, 255, 255, 128).Premultiplied() == Color(128, 128, 128, 128));
+}
 
 namespace MathLibraryTests
 {
@@ -126,5 +141,101 @@ namespace MathLibraryTests
 		{
 			Color actual(255, 0, 0, 0);
 		}
+
+		TEST_METHOD(Div255RoundsToNearest)
+		{
+			for (uint32_t n = 0; n <= 255 * 255; n++) {
+				Assert::AreEqual((uint32_t)((n * 2 + 255) / 510), (uint32_t)Color::Div255(n));
+			}
+		}
+
+		TEST_METHOD(TintKernelMatchesScalar)
+		{
+			// every pair of channel values: 256 tints of all 256 values
+			std::vector<Color> in(256);
+			for (int i = 0; i < 256; i++) {
+				in[i] = Color((uint8_t)i, (uint8_t)(255 - i), (uint8_t)(i * 7), (uint8_t)i);
+			}
+
+			std::vector<Color> out(in.size());
+			for (int t = 0; t < 256; t++) {
+				Color tint((uint8_t)t, (uint8_t)(t ^ 0x55), (uint8_t)(255 - t), (uint8_t)t);
+				ColorKernels::Tint(in.data(), tint, out.data(), in.size());
+				for (size_t i = 0; i < in.size(); i++) {
+					Assert::AreEqual(in[i] * tint, out[i]);
+				}
+			}
+		}
+
+		TEST_METHOD(PremultiplyKernelMatchesScalar)
+		{
+			std::vector<Color> in = TestRandom(1).Colors(1027);
+			std::vector<Color> out(in.size());
+			ColorKernels::Premultiply(in.data(), out.data(), in.size());
+			for (size_t i = 0; i < in.size(); i++) {
+				Assert::AreEqual(in[i].Premultiplied(), out[i]);
+			}
+		}
+
+		TEST_METHOD(BlendKernelMatchesScalar)
+		{
+			std::vector<Color> src = TestRandom(2).Colors(1027);
+			std::vector<Color> dst = TestRandom(3).Colors(1027);
+			std::vector<Color> out(src.size());
+			ColorKernels::Blend(src.data(), dst.data(), out.data(), src.size());
+			for (size_t i = 0; i < src.size(); i++) {
+				Assert::AreEqual(Color::Blend(src[i], dst[i]), out[i]);
+			}
+
+			// blending in place over the destination
+			ColorKernels::Blend(src.data(), dst.data(), dst.data(), dst.size());
+			Assert::IsTrue(out == dst);
+		}
+
+		TEST_METHOD(LerpKernelMatchesScalar)
+		{
+			std::vector<Color> start = TestRandom(4).Colors(1025);
+			std::vector<Color> end = TestRandom(5).Colors(1025);
+			std::vector<Color> out(start.size());
+
+			for (float t : { -1.0f, 0.0f, 0.25f, 0.5f, 0.9f, 1.0f, 2.0f }) {
+				ColorKernels::Lerp(start.data(), end.data(), t, out.data(), start.size());
+				for (size_t i = 0; i < start.size(); i++) {
+					Assert::AreEqual(Color::Lerp(start[i], end[i], t), out[i]);
+				}
+			}
+			Assert::AreEqual(start[7], Color::Lerp(start[7], end[7], 0.0f));
+			Assert::AreEqual(end[7], Color::Lerp(start[7], end[7], 1.0f));
+		}
+
+		TEST_METHOD(FloatConversionRoundTrips)
+		{
+			std::vector<Color> in(256 + 3);
+			for (size_t i = 0; i < in.size(); i++) {
+				in[i] = Color((uint8_t)i, (uint8_t)(i * 3), (uint8_t)(255 - i), (uint8_t)(i * 11));
+			}
+
+			std::vector<Vector4> floats(in.size());
+			std::vector<Color> out(in.size());
+			ColorKernels::ToVector4(in.data(), floats.data(), in.size());
+			ColorKernels::FromVector4(floats.data(), out.data(), floats.size());
+
+			for (size_t i = 0; i < in.size(); i++) {
+				Vector4 expected = in[i].ToVector4();
+				for (int c = 0; c < 4; c++) {
+					Assert::AreEqual(expected[c], floats[i][c]);
+				}
+				Assert::AreEqual(in[i], out[i]);
+			}
+			Assert::AreEqual(1.0f, Color(255, 255, 255, 255).ToVector4().x);
+
+			// out of range channels clamp
+			Vector4 wide[4] = { { -1.0f, 0.5f, 2.0f, 1.0f }, { 0.0f, 0.998f, 0.002f, 0.5f }, {}, {} };
+			Color packed[4];
+			ColorKernels::FromVector4(wide, packed, 4);
+			Assert::AreEqual(Color(0, 128, 255, 255), packed[0]);
+			Assert::AreEqual(Color(0, 254, 1, 128), packed[1]);
+			Assert::AreEqual(Color::FromVector4(wide[1]), packed[1]);
+		}
 	};
 }
@@ -0,0 +1,111 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+
+/*
+ * These checks run at compile time; a failure stops the test project from
+ * building. The values are chosen so every result is exact in float.
+ */
+namespace MathLibraryTests_Constexpr
+{
+	// constructors
+	static_assert(Vector2().x == 0 && Vector2().y == 0);
+	static_assert(Vector3(1, 2, 3).z == 3);
+	static_assert(Vector3(Vector2(1, 2), 3) == Vector3(1, 2, 3));
+	static_assert(Vector4(Vector3(1, 2, 3), 1).w == 1);
+	static_assert(Vector3(Vector4(1, 2, 3, 4)) == Vector3(1, 2, 3));
+	static_assert(Matrix3().m5 == 0 && Matrix4().m16 == 0);
+
+	// arithmetic
+	static_assert(Vector2(1, 2) + Vector2(3, 4) == Vector2(4, 6));
+	static_assert(Vector2(8, 6) / 2.0f - Vector2(1, 1) == Vector2(3, 2));
+	static_assert(2.0f * Vector3(1, 2, 3) == Vector3(2, 4, 6));
+	static_assert(Vector3(1, 2, 3) * Vector3(2, 2, 2) / Vector3(1, 4, 2) == Vector3(2, 1, 3));
+	static_assert(-Vector3(1, -2, 3) == Vector3(-1, 2, -3));
+	static_assert(Vector4(1, 2, 3, 4) + Vector4(4, 3, 2, 1) == Vector4(5, 5, 5, 5));
+	static_assert((Vector4(2, 4, 6, 8) - Vector4(1, 1, 1, 1)) * 2.0f == Vector4(2, 6, 10, 14));
+	static_assert(-Vector4(1, 2, 3, 4) / 2.0f == Vector4(-0.5f, -1, -1.5f, -2));
+
+	constexpr Vector4 Accumulate()
+	{
+		Vector4 v(1, 1, 1, 1);
+		v += Vector4(1, 2, 3, 4);
+		v *= 2.0f;
+		v -= Vector4(0, 0, 0, 2);
+		return v;
+	}
+	static_assert(Accumulate() == Vector4(4, 6, 8, 8));
+
+	// dot and cross
+	static_assert(Vector2(1, 2).Dot(Vector2(3, 4)) == 11);
+	static_assert(Vector3::Dot(Vector3(1, 2, 3), Vector3(4, 5, 6)) == 32);
+	static_assert(Vector4(1, 2, 3, 4).Dot(Vector4(1, 1, 1, 1)) == 10);
+	static_assert(Vector3(1, 0, 0).Cross(Vector3(0, 1, 0)) == Vector3(0, 0, 1));
+	static_assert(Vector4::Cross(Vector4(0, 1, 0, 0), Vector4(0, 0, 1, 0)) == Vector4(1, 0, 0, 0));
+	static_assert(Vector3(3, 4, 12).MagnitudeSqr() == 169);
+
+	// factories and products
+	static_assert(Matrix3::MakeIdentity() * Vector3(1, 2, 3) == Vector3(1, 2, 3));
+	static_assert(Matrix3::MakeTranslation(5, -2) * Vector2(1, 1) == Vector2(6, -1));
+	static_assert(Matrix3::MakeTranslation(5, -2) * Matrix3::MakeScale(2, 3) * Vector2(1, 1) == Vector2(7, 1));
+	static_assert(Matrix3::MakeScale(Vector3(2, 3, 4)) * Matrix3::MakeIdentity() == Matrix3::MakeScale(2, 3, 4));
+	static_assert(Matrix4::MakeIdentity() * Matrix4::MakeIdentity() == Matrix4::MakeIdentity());
+	static_assert(Matrix4::MakeTranslation(1, 2, 3) * Vector4(1, 1, 1, 1) == Vector4(2, 3, 4, 1));
+	static_assert(Matrix4::MakeTranslation(Vector3(1, 2, 3)) * Matrix4::MakeScale(2, 2, 2) * Vector4(1, 1, 1, 1) == Vector4(3, 4, 5, 1));
+	static_assert(Matrix4::MakeScale(Vector3(2, 3, 4)) * Vector4(1, 1, 1, 0) == Vector4(2, 3, 4, 0));
+
+	// transposition
+	static_assert(Matrix3(1, 2, 3, 4, 5, 6, 7, 8, 9).Transposed() == Matrix3(1, 4, 7, 2, 5, 8, 3, 6, 9));
+	static_assert(Matrix3::MakeTranslation(1, 2).Transposed().Transposed() == Matrix3::MakeTranslation(1, 2));
+	static_assert(Matrix4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16).Transposed() ==
+				  Matrix4(1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 4, 8, 12, 16));
+
+	// a table baked at compile time, such as a fixed sprite layout
+	constexpr Matrix3 layoutTransform = Matrix3::MakeTranslation(100, 50) * Matrix3::MakeScale(2, 2);
+	constexpr Vector2 bakedCorners[4] = {
+		layoutTransform * Vector2(0, 0), layoutTransform * Vector2(16, 0),
+		layoutTransform * Vector2(16, 16), layoutTransform * Vector2(0, 16)
+	};
+	static_assert(bakedCorners[2] == Vector2(132, 82));
+
+	constexpr Vector3 unitDirections[6] = {
+		Vector3(1, 0, 0), -Vector3(1, 0, 0), Vector3(0, 1, 0),
+		-Vector3(0, 1, 0), Vector3(1, 0, 0).Cross(Vector3(0, 1, 0)), Vector3(0, 1, 0).Cross(Vector3(1, 0, 0))
+	};
+	static_assert(unitDirections[5] == Vector3(0, 0, -1));
+}
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(ConstexprTests)
+	{
+	public:
+		// the baked results must match what the SIMD paths produce at run time
+		TEST_METHOD(MatchesRuntime)
+		{
+			using namespace MathLibraryTests_Constexpr;
+
+			Matrix3 layout = Matrix3::MakeTranslation(100, 50) * Matrix3::MakeScale(2, 2);
+			CustomAssert::AreEqualsMember(layout, layoutTransform);
+			CustomAssert::AreEqualsMember(layout * Vector2(16, 16), bakedCorners[2]);
+
+			constexpr Matrix4 bakedTRS = Matrix4::MakeTranslation(1, 2, 3) * Matrix4::MakeScale(2, 3, 4);
+			Matrix4 translation = Matrix4::MakeTranslation(1, 2, 3);
+			CustomAssert::AreEqualsMember(translation * Matrix4::MakeScale(2, 3, 4), bakedTRS);
+			CustomAssert::AreEqualsMember(bakedTRS.Transposed(), (translation * Matrix4::MakeScale(2, 3, 4)).Transposed());
+
+			constexpr Vector4 bakedCross = Vector4(1, 2, 3, 0).Cross(Vector4(4, 5, 6, 0));
+			Vector4 a(1, 2, 3, 0);
+			CustomAssert::AreEqualsMember(a.Cross(Vector4(4, 5, 6, 0)), bakedCross);
+		}
+	};
+}
@@ -0,0 +1,189 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <cmath>
+#include <cstdint>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::Fixed32;
+using MathClasses::Matrix3;
+using MathClasses::Matrix3fx;
+using MathClasses::Vector2;
+using MathClasses::Vector2fx;
+
+namespace MathLibraryTests_Fixed
+{
+	// arithmetic is exact integer math, so it can be checked at compile time
+	static_assert(Fixed32(3) * Fixed32(2) == Fixed32(6));
+	static_assert(Fixed32(1) / Fixed32(4) == Fixed32(0.25));
+	static_assert(Fixed32(-3) / Fixed32(2) == Fixed32(-1.5));
+	static_assert(Sqrt(Fixed32(4)) == Fixed32(2));
+	static_assert(Sqrt(Fixed32(2)).raw == 92681);
+	static_assert(Sin(Fixed32(0)) == Fixed32(0));
+	static_assert(Cos(Fixed32(0)) == Fixed32(1));
+	static_assert(Vector2fx(3, 4).MagnitudeSqr() == Fixed32(25));
+	static_assert(Matrix3fx::MakeIdentity() * Vector2fx(5, -7) == Vector2fx(5, -7));
+}
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(FixedTests)
+	{
+	public:
+		TEST_METHOD(Arithmetic)
+		{
+			// products round halves up, quotients truncate toward zero
+			Assert::AreEqual(2, (Fixed32::FromRaw(3) * Fixed32(0.5)).raw);
+			Assert::AreEqual(-1, (Fixed32::FromRaw(-3) * Fixed32(0.5)).raw);
+			Assert::AreEqual(21845, (Fixed32(1) / Fixed32(3)).raw);
+			Assert::AreEqual(-21845, (Fixed32(-1) / Fixed32(3)).raw);
+
+			// overflow wraps, division by zero saturates
+			Assert::AreEqual(INT32_MIN, (Fixed32::FromRaw(INT32_MAX) + Fixed32::FromRaw(1)).raw);
+			Assert::AreEqual(INT32_MAX, (Fixed32(5) / Fixed32(0)).raw);
+			Assert::AreEqual(INT32_MIN, (Fixed32(-5) / Fixed32(0)).raw);
+
+			// float conversion rounds and saturates
+			Assert::AreEqual(98304, Fixed32(1.5f).raw);
+			Assert::AreEqual(-1, Fixed32(-1.0f / 65536.0f).raw);
+			Assert::AreEqual(INT32_MAX, Fixed32(1.0e9f).raw);
+			Assert::AreEqual(-2.75f, Fixed32(-2.75f).ToFloat());
+
+			Fixed32 a = 10;
+			a -= Fixed32(0.5);
+			a *= 2;
+			a /= 4;
+			Assert::AreEqual(4.75f, (float)a);
+			Assert::IsTrue(Fixed32(-1) < Fixed32(0.5) && Fixed32(2) >= Fixed32(2));
+		}
+
+		TEST_METHOD(SquareRoot)
+		{
+			for (int32_t raw = 0; raw < (1 << 22); raw += 4099) {
+				Fixed32 root = Sqrt(Fixed32::FromRaw(raw));
+
+				// rounded down: root^2 <= value < (root + step)^2
+				int64_t value = (int64_t)raw << 16;
+				Assert::IsTrue((int64_t)root.raw * root.raw <= value);
+				Assert::IsTrue((int64_t)(root.raw + 1) * (root.raw + 1) > value);
+			}
+			Assert::AreEqual(0, Sqrt(Fixed32(-4)).raw);
+			Assert::AreEqual(181.0f, (float)Sqrt(Fixed32(32761)));
+		}
+
+		TEST_METHOD(SinTable)
+		{
+			// pins the compile-time table, so a compiler that rounds it
+			// differently fails here rather than desyncing a replay
+			int64_t sum = 0;
+			for (int32_t entry : MathClasses::Detail::SinQuarterTable) {
+				sum += entry;
+			}
+			Assert::AreEqual((int64_t)10713444, sum);
+			Assert::AreEqual(65536, MathClasses::Detail::SinQuarterTable[256]);
+			Assert::AreEqual(46341, MathClasses::Detail::SinQuarterTable[128]);
+		}
+
+		TEST_METHOD(SinCosAccuracy)
+		{
+			for (float angle = -10.0f; angle <= 10.0f; angle += 0.0173f) {
+				Fixed32 s = 0, c = 0;
+				SinCos(Fixed32(angle), s, c);
+
+				double exact = Fixed32(angle).ToDouble();
+				Assert::AreEqual(std::sin(exact), s.ToDouble(), 1.0e-4);
+				Assert::AreEqual(std::cos(exact), c.ToDouble(), 1.0e-4);
+				Assert::AreEqual(s.raw, Sin(Fixed32(angle)).raw);
+				Assert::AreEqual(c.raw, Cos(Fixed32(angle)).raw);
+			}
+			Assert::AreEqual(65536, Sin(MathClasses::FixedConstants::HalfPi).raw);
+		}
+
+		TEST_METHOD(VectorOperations)
+		{
+			Vector2fx v(3, 4);
+			Assert::AreEqual(5.0f, (float)v.Magnitude());
+
+			// normalising gives the same bits every time, on every platform
+			Vector2fx n = v.Normalised();
+			Assert::AreEqual(39321, n.x.raw);
+			Assert::AreEqual(52428, n.y.raw);
+
+			Vector2fx velocity(Fixed32(0.25), Fixed32(-1.5));
+			Vector2fx position = Vector2fx(10, 20) + velocity * Fixed32(2);
+			Assert::AreEqual(Vector2fx(Fixed32(10.5), Fixed32(17)), position);
+			Assert::AreEqual(Fixed32(-28.5), position.Dot(Vector2fx(1, -2)) - Fixed32(5));
+		}
+
+		TEST_METHOD(MatrixTRS)
+		{
+			Vector2fx t(Fixed32(12.5), -4);
+			Fixed32 r(0.7);
+			Vector2fx s(2, Fixed32(0.5));
+
+			Matrix3fx trs = Matrix3fx::MakeTRS(t, r, s);
+			Matrix3fx product = Matrix3fx::MakeTranslation(t) * Matrix3fx::MakeRotateZ(r) * Matrix3fx::MakeScale(s.x, s.y);
+			Assert::AreEqual(product, trs);
+
+			Matrix3 reference = Matrix3::MakeTRS(Vector2(12.5f, -4.0f), 0.7f, Vector2(2.0f, 0.5f));
+			for (int i = 0; i < 9; i++) {
+				Assert::AreEqual(reference[i], trs[i].ToFloat(), 1.0e-3f);
+			}
+
+			Assert::AreEqual(trs, trs * Matrix3fx::MakeIdentity());
+			Assert::AreEqual(trs.Transposed().Transposed(), trs);
+		}
+
+		TEST_METHOD(TransformPointsMatchesScalar)
+		{
+			TestRandom random(7);
+			auto coordinate = [&] { return Fixed32::FromRaw(random.NextInt(-100 * 65536, 100 * 65536)); };
+
+			Matrix3fx m = Matrix3fx::MakeTRS(Vector2fx(Fixed32(-3.25), 9), Fixed32(2.1), Vector2fx(Fixed32(1.5), Fixed32(-0.75)));
+
+			Vector2fx in[BatchTestLength];
+			for (Vector2fx& p : in) {
+				p.x = coordinate();
+				p.y = coordinate();
+			}
+
+			Vector2fx out[BatchTestLength];
+			m.TransformPoints(in, out, BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++) {
+				Vector2fx expected = m * in[i];
+				Assert::AreEqual(expected.x.raw, out[i].x.raw);
+				Assert::AreEqual(expected.y.raw, out[i].y.raw);
+			}
+		}
+
+		TEST_METHOD(KernelsMatchScalar)
+		{
+			TestRandom random(11);
+
+			constexpr size_t count = 23;
+			Fixed32 a[count], b[count], sum[count], product[count], integrated[count];
+			for (size_t i = 0; i < count; i++) {
+				a[i] = Fixed32::FromRaw(random.NextInt(INT32_MIN, INT32_MAX));
+				b[i] = Fixed32::FromRaw(random.NextInt(INT32_MIN, INT32_MAX) >> 12);
+			}
+			// signs and ties that a careless rounding step gets wrong
+			a[0] = Fixed32::FromRaw(-1); b[0] = Fixed32(0.5);
+			a[1] = Fixed32::FromRaw(INT32_MIN); b[1] = Fixed32::FromRaw(-1);
+			a[2] = Fixed32::FromRaw(-3); b[2] = Fixed32(-0.5);
+
+			Fixed32 dt = Fixed32(1) / Fixed32(60);
+			MathClasses::FixedKernels::Add(a, b, sum, count);
+			MathClasses::FixedKernels::Mul(a, b, product, count);
+			MathClasses::FixedKernels::AddScaled(a, b, dt, integrated, count);
+
+			for (size_t i = 0; i < count; i++) {
+				Assert::AreEqual((a[i] + b[i]).raw, sum[i].raw);
+				Assert::AreEqual((a[i] * b[i]).raw, product[i].raw);
+				Assert::AreEqual((a[i] + b[i] * dt).raw, integrated[i].raw);
+			}
+		}
+	};
+}
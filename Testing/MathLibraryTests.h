@@ -8,11 +8,27 @@
 
 #include "Vector2.h"
 #include "Vector3.h"
-//#include "Vector4.h"
-//#include "Matrix3.h"
-//#include "Matrix4.h"
-//#include "Utils.h"
-//#include "Color.h"
+#include "Vector4.h"
+#include "VectorN.h"
+#include "Half.h"
+#include "Fixed32.h"
+#include "PackedVector.h"
+#include "VectorStream.h"
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Matrix4d.h"
+#include "Matrix3fx.h"
+#include "Affine2D.h"
+#include "Quaternion.h"
+#include "Spline.h"
+#include "Skinning.h"
+#include "Bounds.h"
+#include "Collision.h"
+#include "Broadphase.h"
+#include "VectorExpr.h"
+#include "Utils.h"
+#include "Color.h"
+#include "ColorSpace.h"
 
 namespace MathClasses
 {
@@ -5,6 +5,7 @@
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using aie::test::CustomAssert;
+using MathClasses::MAX_FLOAT_DELTA;
 using MathClasses::Vector3;
 using MathClasses::Matrix3;
 
@@ -297,6 +298,59 @@ namespace MathLibraryTests
 			CustomAssert::AreEqualsMember(Vector2(0.0f, 1.0f), v2b);
 		}
 	};
+
+	TEST_CLASS(Matrix3Tests_Inverse)
+	{
+		TEST_METHOD(Determinant)
+		{
+			Matrix3 m3a(1, 3, 1, 2, 2, 2, 3, 1, 4);
+
+			Assert::AreEqual(-4.f, m3a.Determinant(), MAX_FLOAT_DELTA);
+			Assert::AreEqual(0.f, Matrix3(1, 2, 3, 4, 5, 6, 7, 8, 9).Determinant(), MAX_FLOAT_DELTA);
+		}
+
+		TEST_METHOD(Inverted)
+		{
+			Matrix3 m3a(1, 3, 1, 2, 2, 2, 3, 1, 4);
+
+			CustomAssert::AreEqualsMember(Matrix3::MakeIdentity(), m3a * m3a.Inverted());
+			CustomAssert::AreEqualsMember(Matrix3::MakeIdentity(), m3a.Inverted() * m3a);
+		}
+
+		TEST_METHOD(InvertedSingular)
+		{
+			Matrix3 m3a(1, 2, 3, 4, 5, 6, 7, 8, 9);
+
+			CustomAssert::AreEqualsMember(Matrix3(), m3a.Inverted());
+		}
+
+		TEST_METHOD(AffineInverted)
+		{
+			Matrix3 m3a = Matrix3::MakeTranslation(10.0f, -4.5f) * Matrix3::MakeRotateZ(0.72f) * Matrix3::MakeScale(2.0f, 3.0f);
+
+			CustomAssert::AreEqualsMember(m3a.Inverted(), m3a.AffineInverted());
+			CustomAssert::AreEqualsMember(Matrix3::MakeIdentity(), m3a * m3a.AffineInverted());
+		}
+
+		TEST_METHOD(InvertArray)
+		{
+			Matrix3 mats[3] = {
+				Matrix3::MakeTranslation(1.0f, 2.0f) * Matrix3::MakeRotateZ(0.3f),
+				Matrix3::MakeRotateZ(-2.6f) * Matrix3::MakeScale(0.5f, 4.0f),
+				Matrix3::MakeTranslation(-7.0f, 0.25f) * Matrix3::MakeScale(3.0f, 3.0f)
+			};
+
+			Matrix3 general[3], affine[3];
+			Matrix3::Invert(mats, general, 3);
+			Matrix3::AffineInvert(mats, affine, 3);
+
+			for (int i = 0; i < 3; i++)
+			{
+				CustomAssert::AreEqualsMember(mats[i].Inverted(), general[i]);
+				CustomAssert::AreEqualsMember(mats[i].Inverted(), affine[i]);
+			}
+		}
+	};
 }
 
 namespace MathLibraryTests_OPTIONAL
@@ -2,10 +2,12 @@
 
 #include "MathLibraryTests.h"
 #include "MathUnitTestAssert.h"
+#include "TestData.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using aie::test::CustomAssert;
 using MathClasses::Matrix3;
+using MathClasses::Vector2;
 using MathClasses::Vector3;
 
 namespace MathLibraryTests
@@ -103,6 +105,46 @@ namespace MathLibraryTests
 
 		}
 
+		// closed-form euler matches the product of the single-axis rotations
+		TEST_METHOD(MakeEulerMatchesProduct)
+		{
+			Matrix3 expected = Matrix3::MakeRotateZ(-0.4f) * Matrix3::MakeRotateY(2.7f) * Matrix3::MakeRotateX(1.3f);
+
+			CustomAssert::AreEqualsMember(expected, Matrix3::MakeEuler(1.3f, 2.7f, -0.4f));
+		}
+
+		// make trs matches the product of translation, rotation and scale
+		TEST_METHOD(MakeTRS2D)
+		{
+			Matrix3 actual = Matrix3::MakeTRS(Vector2(10.0f, -4.5f), 0.72f, Vector2(2.0f, 3.0f));
+
+			CustomAssert::AreEqualsMember(
+				Matrix3::MakeTranslation(10.0f, -4.5f) * Matrix3::MakeRotateZ(0.72f) * Matrix3::MakeScale(2.0f, 3.0f),
+				actual);
+		}
+
+		// make trs for every element of a stream
+		TEST_METHOD(MakeTRSStream)
+		{
+			MathClasses::Vector2Stream translations;
+			MathClasses::Vector2Stream scales;
+			float rotations[6];
+			for (int i = 0; i < 6; i++)
+			{
+				translations.PushBack(Vector2(i * 3.0f, -i * 1.5f));
+				scales.PushBack(Vector2(1.0f + i, 0.5f * i));
+				rotations[i] = -2.0f + i * 0.9f;
+			}
+
+			Matrix3 actual[6];
+			Matrix3::MakeTRS(translations, rotations, scales, actual);
+
+			for (int i = 0; i < 6; i++)
+			{
+				CustomAssert::AreEqualsMember(Matrix3::MakeTRS(translations.Get(i), rotations[i], scales.Get(i)), actual[i]);
+			}
+		}
+
 		// make scale from floats
 		TEST_METHOD(MakeScaleFloat2D)
 		{
@@ -136,4 +178,73 @@ namespace MathLibraryTests
 					0.0f, 0.0f, 4.0f), actual);
 		}
 	};
+
+	TEST_CLASS(Matrix3Tests_TransformPoints)
+	{
+	public:
+		const Vector2 points[BatchTestLength] = {
+			{ 13.5f, -48.23f }, { 5, 3.99f }, { 0, 1 }, { -2.5f, 7.0f },
+			{ 100.0f, -0.5f }, { 3, 4 }, { -8.25f, -16.0f }
+		};
+
+		Matrix3 MakeTransform()
+		{
+			return Matrix3::MakeTranslation(10.0f, -4.5f) * Matrix3::MakeRotateZ(0.72f) * Matrix3::MakeScale(2.0f, 3.0f);
+		}
+
+		TEST_METHOD(TransformPointsArray)
+		{
+			Matrix3 mat = MakeTransform();
+
+			Vector2 actual[BatchTestLength];
+			mat.TransformPoints(points, actual, BatchTestLength);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(mat * points[i], actual[i]);
+			}
+		}
+
+		TEST_METHOD(TransformPointsInPlace)
+		{
+			Matrix3 mat = MakeTransform();
+
+			Vector2 actual[BatchTestLength];
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				actual[i] = points[i];
+			}
+			mat.TransformPoints(actual, actual, BatchTestLength);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(mat * points[i], actual[i]);
+			}
+		}
+
+		TEST_METHOD(TransformPointsStrided)
+		{
+			struct Vertex
+			{
+				float position[2];
+				float texcoord[2];
+			};
+
+			Matrix3 mat = MakeTransform();
+
+			Vertex vertices[BatchTestLength];
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				vertices[i] = { { points[i].x, points[i].y }, { 0.5f, 0.25f } };
+			}
+			mat.TransformPoints(vertices[0].position, sizeof(Vertex), vertices[0].position, sizeof(Vertex), BatchTestLength);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(mat * points[i], Vector2(vertices[i].position[0], vertices[i].position[1]));
+				Assert::AreEqual(0.5f, vertices[i].texcoord[0]);
+				Assert::AreEqual(0.25f, vertices[i].texcoord[1]);
+			}
+		}
+	};
 }
@@ -5,6 +5,7 @@
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using aie::test::CustomAssert;
+using MathClasses::MAX_FLOAT_DELTA;
 using MathClasses::Matrix4;
 using MathClasses::Vector4;
 
@@ -376,6 +377,68 @@ namespace MathLibraryTests
 				actual);
 		}
 	};
+
+	TEST_CLASS(Matrix4Tests_Inverse)
+	{
+		TEST_METHOD(Determinant)
+		{
+			Matrix4 m4a(1, 4, 1, 7,
+				2, 3, 2, 8,
+				3, 2, 4, 9,
+				4, 1, 4, 1);
+
+			Assert::AreEqual(45.f, m4a.Determinant(), MAX_FLOAT_DELTA);
+			Assert::AreEqual(24.f, Matrix4::MakeScale(2.0f, 3.0f, 4.0f).Determinant(), MAX_FLOAT_DELTA);
+		}
+
+		TEST_METHOD(Inverted)
+		{
+			Matrix4 m4a(1, 4, 1, 7,
+				2, 3, 2, 8,
+				3, 2, 4, 9,
+				4, 1, 4, 1);
+
+			CustomAssert::AreEqualsMember(Matrix4::MakeIdentity(), m4a * m4a.Inverted());
+			CustomAssert::AreEqualsMember(Matrix4::MakeIdentity(), m4a.Inverted() * m4a);
+		}
+
+		TEST_METHOD(InvertedSingular)
+		{
+			Matrix4 m4a(1, 2, 3, 4,
+				5, 6, 7, 8,
+				9, 10, 11, 12,
+				13, 14, 15, 16);
+
+			CustomAssert::AreEqualsMember(Matrix4(), m4a.Inverted());
+		}
+
+		TEST_METHOD(AffineInverted)
+		{
+			Matrix4 m4a = Matrix4::MakeTranslation(2.0f, 3.0f, 4.0f) * Matrix4::MakeEuler(1.0f, 2.0f, 3.0f) * Matrix4::MakeScale(2.0f, 0.5f, 4.0f);
+
+			CustomAssert::AreEqualsMember(m4a.Inverted(), m4a.AffineInverted());
+			CustomAssert::AreEqualsMember(Matrix4::MakeIdentity(), m4a * m4a.AffineInverted());
+		}
+
+		TEST_METHOD(InvertArray)
+		{
+			Matrix4 mats[3] = {
+				Matrix4::MakeTranslation(1.0f, 2.0f, 3.0f) * Matrix4::MakeRotateX(0.3f),
+				Matrix4::MakeRotateY(-2.6f) * Matrix4::MakeScale(0.5f, 4.0f, 2.0f),
+				Matrix4::MakeTranslation(-7.0f, 0.25f, 9.0f) * Matrix4::MakeRotateZ(0.72f)
+			};
+
+			Matrix4 general[3], affine[3];
+			Matrix4::Invert(mats, general, 3);
+			Matrix4::AffineInvert(mats, affine, 3);
+
+			for (int i = 0; i < 3; i++)
+			{
+				CustomAssert::AreEqualsMember(mats[i].Inverted(), general[i]);
+				CustomAssert::AreEqualsMember(mats[i].Inverted(), affine[i]);
+			}
+		}
+	};
 }
 namespace MathLibraryTests_OPTIONAL
 {
@@ -2,6 +2,7 @@
 
 #include "MathLibraryTests.h"
 #include "MathUnitTestAssert.h"
+#include "TestData.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using aie::test::CustomAssert;
@@ -157,6 +158,48 @@ namespace MathLibraryTests
 				actual);
 		}
 
+		// closed-form euler matches the product of the single-axis rotations
+		TEST_METHOD(MakeEulerMatchesProduct)
+		{
+			Matrix4 expected = Matrix4::MakeRotateZ(-0.4f) * Matrix4::MakeRotateY(2.7f) * Matrix4::MakeRotateX(1.3f);
+
+			CustomAssert::AreEqualsMember(expected, Matrix4::MakeEuler(1.3f, 2.7f, -0.4f));
+		}
+
+		// make trs matches the product of translation, rotation and scale
+		TEST_METHOD(MakeTRS)
+		{
+			Vector3 translation(1.5f, -2.0f, 8.0f);
+			Vector3 rotation(0.3f, -1.1f, 2.4f);
+			Vector3 scale(2.0f, 0.5f, 3.0f);
+
+			CustomAssert::AreEqualsMember(
+				Matrix4::MakeTranslation(translation) * Matrix4::MakeEuler(rotation) * Matrix4::MakeScale(scale),
+				Matrix4::MakeTRS(translation, rotation, scale));
+		}
+
+		// make trs for every element of a stream
+		TEST_METHOD(MakeTRSStream)
+		{
+			MathClasses::Vector3Stream translations;
+			MathClasses::Vector3Stream rotations;
+			MathClasses::Vector3Stream scales;
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				translations.PushBack(Vector3(i * 3.0f, -i * 1.5f, 0.25f * i));
+				rotations.PushBack(Vector3(-2.0f + i * 0.9f, 0.4f * i, 3.0f - i));
+				scales.PushBack(Vector3(1.0f + i, 0.5f * i, 2.0f));
+			}
+
+			Matrix4 actual[BatchTestLength];
+			Matrix4::MakeTRS(translations, rotations, scales, actual);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(Matrix4::MakeTRS(translations.Get(i), rotations.Get(i), scales.Get(i)), actual[i]);
+			}
+		}
+
 		// make scale from floats
 		TEST_METHOD(MakeScaleFloat3D)
 		{
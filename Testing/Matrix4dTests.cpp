@@ -0,0 +1,78 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Matrix4;
+using MathClasses::Matrix4d;
+using MathClasses::Vector3;
+using MathClasses::Vector3d;
+using MathClasses::Vector4;
+using MathClasses::Vector4d;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(Matrix4dTests)
+	{
+	public:
+		// the double factories match the float ones
+		TEST_METHOD(MatchesMatrix4)
+		{
+			Matrix4 single = Matrix4::MakeTRS(Vector3(1.5f, -2.0f, 8.0f), Vector3(0.3f, -1.1f, 2.4f), Vector3(2.0f, 0.5f, 3.0f));
+			Matrix4d wide = Matrix4d::MakeTRS(Vector3d(1.5, -2.0, 8.0), Vector3d(0.3, -1.1, 2.4), Vector3d(2.0, 0.5, 3.0));
+
+			CustomAssert::AreEqualsMember(Matrix4d(single), wide);
+			CustomAssert::AreEqualsMember(Matrix4d(Matrix4::MakeEuler(1.0f, 2.0f, 3.0f)), Matrix4d::MakeEuler(1.0, 2.0, 3.0));
+		}
+
+		TEST_METHOD(Multiply)
+		{
+			Matrix4d a = Matrix4d::MakeTranslation(1.0e8, 2.0, -3.0);
+			Matrix4d b = Matrix4d::MakeScale(2.0, 3.0, 4.0);
+
+			CustomAssert::AreEqualsMember(Matrix4d(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 1.0e8, 2, -3, 1), a * b);
+			CustomAssert::AreEqualsMember(Vector4d(1.0e8 + 2, 5, 1, 1), (a * b) * Vector4d(1, 1, 1, 1));
+			CustomAssert::AreEqualsMember(Vector3d(1.0e8 + 0.25, 2, -3), a.TransformPoint(Vector3d(0.25, 0, 0)));
+			CustomAssert::AreEqualsMember(a, a.Transposed().Transposed());
+		}
+
+		// far from the world origin, the relative matrix keeps the small offset
+		TEST_METHOD(CameraRelativeMatrix)
+		{
+			Vector3d camera(5.0e7, -1.0e6, 3.0e7);
+			Matrix4d model = Matrix4d::MakeTranslation(camera + Vector3d(0.3, -0.7, 1.1)) * Matrix4d::MakeScale(2, 2, 2);
+
+			Matrix4 relative = model.ToMatrix4(camera);
+
+			CustomAssert::AreEqualsMember(Matrix4::MakeTranslation(0.3f, -0.7f, 1.1f) * Matrix4::MakeScale(2, 2, 2), relative);
+
+			Matrix4 batched[1];
+			Matrix4d::ToMatrix4(&model, batched, 1, camera);
+			CustomAssert::AreEqualsMember(relative, batched[0]);
+		}
+
+		TEST_METHOD(RebasePositions)
+		{
+			Vector3d camera(-4.0e7, 2.5e6, 1.0e9);
+			Vector3d positions[BatchTestLength];
+			Vector3 expected[BatchTestLength];
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				expected[i] = Vector3(0.125f * i, -3.5f + i, 100.0f - 0.25f * i);
+				positions[i] = camera + Vector3d(expected[i]);
+			}
+
+			Vector3 actual[BatchTestLength];
+			MathClasses::Rebase(positions, actual, BatchTestLength, camera);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(expected[i], actual[i]);
+				CustomAssert::AreEqualsMember(expected[i], MathClasses::Rebase(positions[i], camera));
+			}
+		}
+	};
+}
@@ -0,0 +1,146 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::Half;
+using MathClasses::OctahedralNormal;
+using MathClasses::QuantisationBox;
+using MathClasses::Vector3;
+using MathClasses::Vector3h;
+using MathClasses::Vector3q16;
+using MathClasses::Vector3Stream;
+namespace Packing = MathClasses::Packing;
+
+namespace MathLibraryTests_PackedVector
+{
+	static_assert(sizeof(Vector3h) == sizeof(Vector3) / 2);
+	static_assert(sizeof(Vector3q16) == sizeof(Vector3) / 2);
+	static_assert(sizeof(OctahedralNormal) == sizeof(Vector3) / 3);
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_PackedVector;
+
+	TEST_CLASS(PackedVectorTests)
+	{
+	public:
+		TEST_METHOD(HalfPackMatchesScalar)
+		{
+			const float inf = std::numeric_limits<float>::infinity();
+			const float special[] = {
+				0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65519.0f, 65520.0f, -1.0e6f,
+				6.1035156e-5f, 6.0e-5f, 1.0e-7f, -3.0e-8f, 2.0e-8f, inf, -inf,
+				std::numeric_limits<float>::quiet_NaN(), 0.33333334f, 1.0009766f
+			};
+
+			// eighteen values per axis covers the four-wide loop and the tail
+			Vector3Stream in;
+			for (size_t i = 0; i < std::size(special); i++) {
+				in.PushBack({ special[i], special[std::size(special) - 1 - i], special[i] * -0.5f });
+			}
+			Vector3Stream random = TestRandom(3).Vector3s(37, -70000.0f, 70000.0f);
+			for (size_t i = 0; i < random.Size(); i++) {
+				in.PushBack(random.Get(i) * (i % 2 == 0 ? 1.0f : 1.0e-4f));
+			}
+
+			std::vector<Vector3h> packed(in.Size());
+			Packing::Pack(in, packed.data());
+			for (size_t i = 0; i < in.Size(); i++) {
+				Assert::AreEqual(Half::FromFloat(in.x[i]), packed[i].x.bits);
+				Assert::AreEqual(Half::FromFloat(in.y[i]), packed[i].y.bits);
+				Assert::AreEqual(Half::FromFloat(in.z[i]), packed[i].z.bits);
+			}
+		}
+
+		TEST_METHOD(HalfUnpackMatchesScalar)
+		{
+			// every Half bit pattern, spread over the three axes
+			std::vector<Vector3h> packed(65536 / 3 + 1);
+			for (uint32_t bits = 0; bits < 65536; bits++) {
+				packed[bits / 3][bits % 3] = Half::FromBits((uint16_t)bits);
+			}
+
+			Vector3Stream out;
+			Packing::Unpack(packed.data(), packed.size(), out);
+			Assert::AreEqual(packed.size(), out.Size());
+			for (size_t i = 0; i < packed.size(); i++) {
+				Assert::AreEqual(std::bit_cast<uint32_t>(Half::ToFloat(packed[i].x.bits)), std::bit_cast<uint32_t>(out.x[i]));
+				Assert::AreEqual(std::bit_cast<uint32_t>(Half::ToFloat(packed[i].y.bits)), std::bit_cast<uint32_t>(out.y[i]));
+				Assert::AreEqual(std::bit_cast<uint32_t>(Half::ToFloat(packed[i].z.bits)), std::bit_cast<uint32_t>(out.z[i]));
+			}
+		}
+
+		TEST_METHOD(QuantisedRoundTrip)
+		{
+			QuantisationBox box(Vector3(-10, -10, 0), Vector3(10, 30, 5));
+			Vector3Stream in = TestRandom(5).Vector3s(103, -12.0f, 12.0f);
+			in.Set(0, { -10, -10, 0 });
+			in.Set(1, { 10, 30, 5 });
+
+			std::vector<Vector3q16> packed(in.Size());
+			Packing::Pack(in, box, packed.data());
+
+			Vector3Stream out;
+			Packing::Unpack(packed.data(), packed.size(), box, out);
+
+			Assert::AreEqual(Vector3q16(0, 0, 0), packed[0]);
+			Assert::AreEqual(Vector3q16(65535, 65535, 65535), packed[1]);
+
+			for (size_t i = 0; i < in.Size(); i++) {
+				Assert::AreEqual(box.Pack(in.Get(i)), packed[i]);
+				Assert::AreEqual(box.Unpack(packed[i]), out.Get(i));
+
+				// within half a step of the input clamped to the box
+				Vector3 clamped(std::clamp(in.x[i], -10.0f, 10.0f), std::clamp(in.y[i], -10.0f, 30.0f), std::clamp(in.z[i], 0.0f, 5.0f));
+				for (int axis = 0; axis < 3; axis++) {
+					Assert::AreEqual(clamped[axis], out.Get(i)[axis], box.step[axis] * 0.5f + 1.0e-5f);
+				}
+			}
+		}
+
+		TEST_METHOD(OctahedralRoundTrip)
+		{
+			Vector3Stream in = TestRandom(9).Vector3s(203, -1.0f, 1.0f);
+			const Vector3 axes[] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 1, -1, -1 } };
+			for (size_t i = 0; i < std::size(axes); i++) {
+				in.Set(i, axes[i]);
+			}
+			for (size_t i = 0; i < in.Size(); i++) {
+				in.Set(i, in.Get(i).Normalised());
+			}
+
+			std::vector<OctahedralNormal> packed(in.Size());
+			Packing::PackNormals(in, packed.data());
+
+			Vector3Stream out;
+			Packing::UnpackNormals(packed.data(), packed.size(), out);
+
+			// the batch kernels may fuse multiply-adds the scalar code rounds
+			// separately, so they can differ by a few ulp and round a value
+			// sitting on a step boundary to the neighbouring step
+			const float ulps = 4 * std::numeric_limits<float>::epsilon();
+			for (size_t i = 0; i < in.Size(); i++) {
+				Vector3 decoded = packed[i].Decode();
+				OctahedralNormal encoded = OctahedralNormal::Encode(in.Get(i));
+				Assert::IsTrue(std::abs(encoded.u - packed[i].u) <= 1 && std::abs(encoded.v - packed[i].v) <= 1);
+				Assert::AreEqual(decoded.x, out.x[i], ulps);
+				Assert::AreEqual(decoded.y, out.y[i], ulps);
+				Assert::AreEqual(decoded.z, out.z[i], ulps);
+
+				Assert::AreEqual(1.0f, decoded.Magnitude(), 1.0e-6f);
+				Assert::IsTrue(decoded.Dot(in.Get(i)) > std::cos(0.001f));
+			}
+		}
+	};
+}
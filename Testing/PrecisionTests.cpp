@@ -0,0 +1,149 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+
+#include <cmath>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Precision;
+using MathClasses::Quaternion;
+using MathClasses::QuaternionStream;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+using MathClasses::Vector3Stream;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(PrecisionTests)
+	{
+	public:
+		// distance from the reference in units in the last place of the reference
+		static double Ulps(float value, double reference)
+		{
+			float ref = (float)reference;
+			double ulp = (double)std::nextafter(std::fabs(ref), INFINITY) - std::fabs(ref);
+			return std::fabs(value - reference) / ulp;
+		}
+
+		TEST_METHOD(RSqrtWithinBound)
+		{
+			for (float x = 1e-6f; x < 1e6f; x *= 1.01f)
+			{
+				double ulps = Ulps(MathClasses::RSqrt<Precision::Fast>(x), 1.0 / std::sqrt((double)x));
+				Assert::IsTrue(ulps <= 4.0);
+			}
+		}
+
+		TEST_METHOD(SinCosWithinBound)
+		{
+			for (float x = -8192.0f; x < 8192.0f; x += 0.37f)
+			{
+				float s, c;
+				MathClasses::SinCos<Precision::Fast>(x, s, c);
+				double refSin = std::sin((double)x), refCos = std::cos((double)x);
+
+				Assert::IsTrue(std::fabs(s - refSin) <= 1e-7 || Ulps(s, refSin) <= 2.0);
+				Assert::IsTrue(std::fabs(c - refCos) <= 1e-7 || Ulps(c, refCos) <= 2.0);
+				Assert::AreEqual(s, MathClasses::Sin<Precision::Fast>(x));
+				Assert::AreEqual(c, MathClasses::Cos<Precision::Fast>(x));
+			}
+		}
+
+		TEST_METHOD(Atan2WithinBound)
+		{
+			for (float angle = -3.14159f; angle < 3.14159f; angle += 0.001f)
+			{
+				for (float radius : { 0.001f, 1.0f, 1000.0f })
+				{
+					float y = radius * std::sin(angle), x = radius * std::cos(angle);
+					double ref = std::atan2((double)y, (double)x);
+					float fast = MathClasses::Atan2<Precision::Fast>(y, x);
+
+					Assert::IsTrue(std::fabs(fast - ref) <= 2.5e-7);
+					Assert::IsTrue(std::fabs(ref) <= 0.1 || Ulps(fast, ref) <= 4.0);
+				}
+			}
+			Assert::AreEqual(0.0f, MathClasses::Atan2<Precision::Fast>(0, 0));
+		}
+
+		TEST_METHOD(ExactIsDefault)
+		{
+			Vector3 v(13.5f, -48.23f, 862);
+			Vector3 exact = v;
+			exact.x /= v.Magnitude(); exact.y /= v.Magnitude(); exact.z /= v.Magnitude();
+
+			Assert::IsTrue(exact.x == v.Normalised().x && exact.y == v.Normalised().y && exact.z == v.Normalised().z);
+			Assert::AreEqual(std::atan2(3.0f, 4.0f), MathClasses::AngleFrom2D(4.0f, 3.0f));
+			Assert::AreEqual(std::sin(1.25f), MathClasses::Sin(1.25f));
+		}
+
+		TEST_METHOD(FastNormaliseAndFactories)
+		{
+			Vector2 v2(13.5f, -48.23f);
+			Vector3 v3(13.5f, -48.23f, 862);
+			Vector4 v4(13.5f, -48.23f, 862, 1);
+
+			CustomAssert::AreEqualsMember(v2.Normalised(), v2.Normalised<Precision::Fast>());
+			CustomAssert::AreEqualsMember(v3.Normalised(), v3.Normalised<Precision::Fast>());
+			CustomAssert::AreEqualsMember(v4.Normalised(), v4.Normalised<Precision::Fast>());
+			CustomAssert::AreEqualsMember(Vector3(), Vector3().SafeNormalised<Precision::Fast>());
+
+			CustomAssert::AreEqualsMember(Matrix3::MakeEuler(1.2f, -0.7f, 2.9f), Matrix3::MakeEuler<Precision::Fast>(1.2f, -0.7f, 2.9f));
+			CustomAssert::AreEqualsMember(Matrix4::MakeEuler(1.2f, -0.7f, 2.9f), Matrix4::MakeEuler<Precision::Fast>(1.2f, -0.7f, 2.9f));
+		}
+
+		TEST_METHOD(FastStreamNormalise)
+		{
+			Vector3Stream exact(7), fast(7);
+			for (int i = 0; i < 7; i++)
+			{
+				Vector3 v(1.5f * i - 4.0f, 3.0f - i, 0.25f * i + 1.0f);
+				exact.Set(i, v);
+				fast.Set(i, v);
+			}
+			exact.Normalise();
+			fast.Normalise<Precision::Fast>();
+
+			for (int i = 0; i < 7; i++)
+			{
+				CustomAssert::AreEqualsMember(exact.Get(i), fast.Get(i));
+			}
+		}
+
+		TEST_METHOD(FastQuaternionStream)
+		{
+			QuaternionStream starts, ends;
+			for (int i = 0; i < 7; i++)
+			{
+				starts.PushBack(Quaternion::MakeEuler(0.3f * i, -0.2f * i, 0.5f));
+				ends.PushBack(Quaternion::MakeEuler(-1.1f, 0.4f * i, 0.25f * i));
+			}
+
+			QuaternionStream exact, fast;
+			QuaternionStream::Nlerp(starts, ends, 0.35f, exact);
+			QuaternionStream::Nlerp<Precision::Fast>(starts, ends, 0.35f, fast);
+			for (int i = 0; i < 7; i++)
+			{
+				CustomAssert::AreEqualsMember(exact.Get(i), fast.Get(i));
+				CustomAssert::AreEqualsMember(Quaternion::Nlerp<Precision::Fast>(starts.Get(i), ends.Get(i), 0.35f), fast.Get(i));
+			}
+
+			// scaled copies normalise back to the same rotations
+			for (int i = 0; i < 7; i++)
+			{
+				Quaternion q = starts.Get(i);
+				fast.Set(i, Quaternion(q.x * 3.0f, q.y * 3.0f, q.z * 3.0f, q.w * 3.0f));
+			}
+			fast.Normalise<Precision::Fast>();
+			for (int i = 0; i < 7; i++)
+			{
+				CustomAssert::AreEqualsMember(starts.Get(i), fast.Get(i));
+			}
+		}
+	};
+}
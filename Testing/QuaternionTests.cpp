@@ -0,0 +1,160 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::MAX_FLOAT_DELTA;
+using MathClasses::Matrix3;
+using MathClasses::Matrix4;
+using MathClasses::Quaternion;
+using MathClasses::QuaternionStream;
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(QuaternionTests)
+	{
+	public:
+		TEST_METHOD(DefaultIsIdentity)
+		{
+			Quaternion q;
+			Vector3 v(13.5f, -48.23f, 862);
+
+			CustomAssert::AreEqualsMember(Quaternion(0, 0, 0, 1), q);
+			CustomAssert::AreEqualsMember(v, q.Rotate(v));
+		}
+
+		TEST_METHOD(AxisAngleMatchesMatrices)
+		{
+			Quaternion qx = Quaternion::MakeAxisAngle(Vector3(1, 0, 0), 3.98f);
+			Quaternion qy = Quaternion::MakeAxisAngle(Vector3(0, 1, 0), 1.76f);
+			Quaternion qz = Quaternion::MakeAxisAngle(Vector3(0, 0, 1), 9.62f);
+
+			CustomAssert::AreEqualsMember(Matrix3::MakeRotateX(3.98f), qx.ToMatrix3());
+			CustomAssert::AreEqualsMember(Matrix3::MakeRotateY(1.76f), qy.ToMatrix3());
+			CustomAssert::AreEqualsMember(Matrix3::MakeRotateZ(9.62f), qz.ToMatrix3());
+			CustomAssert::AreEqualsMember(Matrix4::MakeRotateX(3.98f), qx.ToMatrix4());
+		}
+
+		TEST_METHOD(EulerMatchesMatrices)
+		{
+			Quaternion q = Quaternion::MakeEuler(1.2f, -0.7f, 2.9f);
+
+			CustomAssert::AreEqualsMember(Matrix3::MakeEuler(1.2f, -0.7f, 2.9f), q.ToMatrix3());
+			CustomAssert::AreEqualsMember(Matrix4::MakeEuler(1.2f, -0.7f, 2.9f), q.ToMatrix4());
+			CustomAssert::AreEqualsMember(Quaternion::MakeEuler(Vector3(1.2f, -0.7f, 2.9f)), q);
+		}
+
+		TEST_METHOD(MultiplyComposes)
+		{
+			Quaternion a = Quaternion::MakeEuler(0.3f, 1.1f, -2.4f);
+			Quaternion b = Quaternion::MakeAxisAngle(Vector3(0, 0.6f, 0.8f), 0.9f);
+			Vector3 v(5, 3.99f, -12);
+
+			CustomAssert::AreEqualsMember(a.ToMatrix3() * b.ToMatrix3(), (a * b).ToMatrix3());
+			CustomAssert::AreEqualsMember(a.Rotate(b.Rotate(v)), (a * b) * v);
+			CustomAssert::AreEqualsMember(a.ToMatrix3() * v, a * v);
+			CustomAssert::AreEqualsMember(Quaternion(), a * a.Inverted());
+			CustomAssert::AreEqualsMember(a.Conjugate(), a.Inverted());
+		}
+
+		TEST_METHOD(SlerpAndNlerp)
+		{
+			Quaternion start = Quaternion::MakeAxisAngle(Vector3(0, 1, 0), 0.2f);
+			Quaternion end = Quaternion::MakeAxisAngle(Vector3(0, 1, 0), 1.8f);
+
+			CustomAssert::AreEqualsMember(start, Quaternion::Slerp(start, end, 0));
+			CustomAssert::AreEqualsMember(end, Quaternion::Slerp(start, end, 1));
+			CustomAssert::AreEqualsMember(Quaternion::MakeAxisAngle(Vector3(0, 1, 0), 0.6f), Quaternion::Slerp(start, end, 0.25f));
+
+			// nlerp follows the same arc, only at a different speed
+			Quaternion halfway = Quaternion::Nlerp(start, end, 0.5f);
+			CustomAssert::AreEqualsMember(Quaternion::MakeAxisAngle(Vector3(0, 1, 0), 1.0f), halfway);
+			Assert::AreEqual(1.0f, halfway.Magnitude(), MAX_FLOAT_DELTA);
+
+			// -end is the same rotation, so the shortest path is unchanged
+			Quaternion negEnd(-end.x, -end.y, -end.z, -end.w);
+			CustomAssert::AreEqualsMember(Quaternion::Slerp(start, end, 0.25f), Quaternion::Slerp(start, negEnd, 0.25f));
+			CustomAssert::AreEqualsMember(Quaternion::Nlerp(start, end, 0.25f), Quaternion::Nlerp(start, negEnd, 0.25f));
+		}
+	};
+
+	TEST_CLASS(QuaternionTests_Stream)
+	{
+	public:
+		Quaternion starts[BatchTestLength];
+		Quaternion ends[BatchTestLength];
+
+		QuaternionTests_Stream()
+		{
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				starts[i] = Quaternion::MakeEuler(0.3f * i, -0.2f * i, 0.5f);
+				ends[i] = Quaternion::MakeEuler(-1.1f, 0.4f * i, 0.25f * i);
+			}
+			// a nearly equal pair takes the nlerp fallback, and a negated
+			// pair takes the shortest-path flip
+			ends[2] = Quaternion::MakeEuler(0.6f, -0.4f, 0.5001f);
+			ends[3] = Quaternion(-ends[3].x, -ends[3].y, -ends[3].z, -ends[3].w);
+		}
+
+		TEST_METHOD(NlerpSlerpMatchScalar)
+		{
+			QuaternionStream a = QuaternionStream::FromArray(starts, BatchTestLength);
+			QuaternionStream b = QuaternionStream::FromArray(ends, BatchTestLength);
+			QuaternionStream nlerped, slerped;
+			QuaternionStream::Nlerp(a, b, 0.35f, nlerped);
+			QuaternionStream::Slerp(a, b, 0.35f, slerped);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(Quaternion::Nlerp(starts[i], ends[i], 0.35f), nlerped.Get(i));
+				CustomAssert::AreEqualsMember(Quaternion::Slerp(starts[i], ends[i], 0.35f), slerped.Get(i));
+			}
+		}
+
+		TEST_METHOD(SlerpTailMatchesBody)
+		{
+			// six elements: the last two run in the scalar tail and repeat
+			// pairs the 4-wide body blends
+			const int order[] = { 0, 1, 2, 3, 1, 2 };
+			QuaternionStream a, b;
+			for (int i : order)
+			{
+				a.PushBack(starts[i]);
+				b.PushBack(ends[i]);
+			}
+			QuaternionStream slerped;
+			QuaternionStream::Slerp(a, b, 0.35f, slerped);
+
+			for (int i = 0; i < 6; i++)
+			{
+				Assert::AreEqual(1.0f, slerped.Get(i).Magnitude(), 1.0e-6f);
+			}
+			Assert::IsTrue(slerped.Get(1).Equals(slerped.Get(4), 1.0e-6f));
+			Assert::IsTrue(slerped.Get(2).Equals(slerped.Get(5), 1.0e-6f));
+		}
+
+		TEST_METHOD(RotateMatchesScalar)
+		{
+			QuaternionStream rotations = QuaternionStream::FromArray(starts, BatchTestLength);
+			Vector3Stream vectors(BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				vectors.Set(i, Vector3(1.5f * i, -2.0f, 0.5f + i));
+			}
+
+			Vector3Stream rotated;
+			QuaternionStream::Rotate(rotations, vectors, rotated);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(starts[i].Rotate(vectors.Get(i)), rotated.Get(i));
+			}
+		}
+	};
+}
@@ -0,0 +1,139 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::Matrix4;
+using MathClasses::SkinWeightStream;
+using MathClasses::Vector3;
+using MathClasses::Vector3Stream;
+using MathClasses::Vector4;
+namespace Skinning = MathClasses::Skinning;
+
+namespace MathLibraryTests_Skinning
+{
+	struct Mesh
+	{
+		std::vector<Matrix4> palette;
+		SkinWeightStream influences;
+		Vector3Stream positions, normals;
+	};
+
+	// a palette of rotations, translations and uniform scales, and vertices
+	// with one to four influences
+	Mesh RandomMesh(size_t vertices, size_t bones, unsigned seed)
+	{
+		MathLibraryTests::TestRandom random(seed);
+
+		Mesh mesh;
+		for (size_t b = 0; b < bones; b++) {
+			float scale = 1.0f + 0.25f * random.NextFloat(-1.0f, 1.0f);
+			Vector3 translation = random.NextVector3(-1.0f, 1.0f) * 10.0f;
+			Vector3 rotation = random.NextVector3(-1.0f, 1.0f) * 3.0f;
+			mesh.palette.push_back(Matrix4::MakeTRS(translation, rotation, Vector3(scale, scale, scale)));
+		}
+
+		for (size_t i = 0; i < vertices; i++) {
+			size_t used = 1 + i % 4;
+			std::array<uint16_t, 4> index = { 0, 0, 0, 0 };
+			std::array<float, 4> weight = { 0, 0, 0, 0 };
+			float total = 0;
+			for (size_t k = 0; k < used; k++) {
+				index[k] = (uint16_t)(random.NextBits() % bones);
+				weight[k] = 0.1f + (random.NextFloat(-1.0f, 1.0f) + 1.0f);
+				total += weight[k];
+			}
+			for (size_t k = 0; k < used; k++) {
+				weight[k] /= total;
+			}
+			mesh.influences.PushBack(index, weight);
+			mesh.positions.PushBack(random.NextVector3(-1.0f, 1.0f) * 5.0f);
+			mesh.normals.PushBack((random.NextVector3(-1.0f, 1.0f) + Vector3(0, 0, 2.0f)).Normalised());
+		}
+		return mesh;
+	}
+
+	// the weighted sum of each bone's transform of the vertex
+	void ReferenceSkin(const Mesh& mesh, size_t i, Vector3& position, Vector3& normal)
+	{
+		Vector4 p, n;
+		Vector3 bindPosition = mesh.positions.Get(i), bindNormal = mesh.normals.Get(i);
+		for (size_t k = 0; k < SkinWeightStream::MaxInfluences; k++) {
+			const Matrix4& m = mesh.palette[mesh.influences.bone[k][i]];
+			float w = mesh.influences.weight[k][i];
+			p = p + (m * Vector4(bindPosition.x, bindPosition.y, bindPosition.z, 1.0f)) * w;
+			n = n + (m * Vector4(bindNormal.x, bindNormal.y, bindNormal.z, 0.0f)) * w;
+		}
+		position = Vector3(p.x, p.y, p.z);
+		normal = Vector3(n.x, n.y, n.z).Normalised();
+	}
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_Skinning;
+
+	TEST_CLASS(SkinningTests)
+	{
+	public:
+		TEST_METHOD(SingleBoneIsTransform)
+		{
+			Mesh mesh = RandomMesh(7, 3, 41);
+			for (size_t i = 0; i < 7; i++) {
+				mesh.influences.bone[0][i] = 2;
+				mesh.influences.weight[0][i] = 1.0f;
+				for (size_t k = 1; k < 4; k++) {
+					mesh.influences.weight[k][i] = 0.0f;
+				}
+			}
+
+			Vector3Stream positions, normals;
+			Skinning::Skin(mesh.palette.data(), mesh.influences, mesh.positions, mesh.normals, positions, normals);
+			Assert::AreEqual((size_t)7, positions.Size());
+
+			for (size_t i = 0; i < 7; i++) {
+				Vector3 p = mesh.positions.Get(i);
+				Vector4 expected = mesh.palette[2] * Vector4(p.x, p.y, p.z, 1.0f);
+				Assert::IsTrue(Vector3(expected.x, expected.y, expected.z).Distance(positions.Get(i)) < 1.0e-4f);
+				Assert::AreEqual(1.0f, normals.Get(i).Magnitude(), 1.0e-6f);
+			}
+		}
+
+		TEST_METHOD(MatchesWeightedSum)
+		{
+			Mesh mesh = RandomMesh(LargeBatchTestLength, 32, 42);
+			Vector3Stream positions, normals;
+			Skinning::Skin(mesh.palette.data(), mesh.influences, mesh.positions, mesh.normals, positions, normals);
+
+			for (size_t i = 0; i < mesh.positions.Size(); i++) {
+				Vector3 position, normal;
+				ReferenceSkin(mesh, i, position, normal);
+				Assert::IsTrue(position.Distance(positions.Get(i)) < 1.0e-4f, L"skinned position differs");
+				Assert::IsTrue(normal.Distance(normals.Get(i)) < 1.0e-5f, L"skinned normal differs");
+			}
+		}
+
+		TEST_METHOD(ParallelMatchesSingleThread)
+		{
+			Mesh mesh = RandomMesh(LargeBatchTestLength, 16, 43);
+			Vector3Stream positions, normals, parallelPositions, parallelNormals;
+			Skinning::Skin(mesh.palette.data(), mesh.influences, mesh.positions, mesh.normals, positions, normals);
+
+			// a chunk size that is not a multiple of four, and more threads than chunks
+			Skinning::SkinParallel(mesh.palette.data(), mesh.influences, mesh.positions, mesh.normals, parallelPositions, parallelNormals, 61, 3);
+			for (size_t i = 0; i < positions.Size(); i++) {
+				Assert::IsTrue(positions.Get(i) == parallelPositions.Get(i));
+				Assert::IsTrue(normals.Get(i) == parallelNormals.Get(i));
+			}
+
+			Skinning::SkinParallel(mesh.palette.data(), mesh.influences, mesh.positions, mesh.normals, parallelPositions, parallelNormals, 512, 64);
+			for (size_t i = 0; i < positions.Size(); i++) {
+				Assert::IsTrue(positions.Get(i) == parallelPositions.Get(i));
+			}
+		}
+	};
+}
@@ -0,0 +1,174 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::CubicCurve2;
+using MathClasses::CubicCurve3;
+using MathClasses::Spline2;
+using MathClasses::Spline3;
+using MathClasses::ArcLengthTable;
+
+namespace MathLibraryTests_Spline
+{
+	// the Bernstein form of a cubic Bezier, for comparison with the power form
+	Vector3 ReferenceBezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t)
+	{
+		float u = 1.0f - t;
+		return p0 * (u * u * u) + p1 * (3.0f * u * u * t) + p2 * (3.0f * u * t * t) + p3 * (t * t * t);
+	}
+
+	void AreNear(const Vector3& expected, const Vector3& actual, float tolerance)
+	{
+		Assert::IsTrue(expected.Distance(actual) < tolerance, L"points differ");
+	}
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_Spline;
+
+	TEST_CLASS(SplineTests)
+	{
+	public:
+		const Vector3 controls[4] = { { 0, 0, 0 }, { 1, 4, -2 }, { 5, -3, 1 }, { 6, 2, 3 } };
+
+		TEST_METHOD(BezierMatchesBernstein)
+		{
+			CubicCurve3 curve = CubicCurve3::FromBezier(controls[0], controls[1], controls[2], controls[3]);
+			for (int i = 0; i <= 20; i++) {
+				float t = i / 20.0f;
+				AreNear(ReferenceBezier(controls[0], controls[1], controls[2], controls[3], t), curve.Evaluate(t), 1.0e-5f);
+			}
+			CustomAssert::AreEqualsMember((controls[1] - controls[0]) * 3.0f, curve.Derivative(0.0f));
+			CustomAssert::AreEqualsMember((controls[3] - controls[2]) * 3.0f, curve.Derivative(1.0f));
+
+			// a quadratic is the cubic with control points two thirds of the way to the middle point
+			CubicCurve3 quadratic = CubicCurve3::FromQuadraticBezier(controls[0], controls[1], controls[3]);
+			Vector3 q1 = controls[0] + (controls[1] - controls[0]) * (2.0f / 3.0f);
+			Vector3 q2 = controls[3] + (controls[1] - controls[3]) * (2.0f / 3.0f);
+			for (int i = 0; i <= 20; i++) {
+				float t = i / 20.0f;
+				AreNear(ReferenceBezier(controls[0], q1, q2, controls[3], t), quadratic.Evaluate(t), 1.0e-5f);
+			}
+		}
+
+		TEST_METHOD(HermiteAndCatmullRomEndpoints)
+		{
+			Vector2 p0(1, 2), m0(3, 0), p1(4, -1), m1(0, -2);
+			CubicCurve2 hermite = CubicCurve2::FromHermite(p0, m0, p1, m1);
+			CustomAssert::AreEqualsMember(p0, hermite.Evaluate(0.0f));
+			CustomAssert::AreEqualsMember(p1, hermite.Evaluate(1.0f));
+			CustomAssert::AreEqualsMember(m0, hermite.Derivative(0.0f));
+			CustomAssert::AreEqualsMember(m1, hermite.Derivative(1.0f));
+
+			Vector2 points[5] = { { 0, 0 }, { 2, 1 }, { 4, 0 }, { 5, -3 }, { 8, -1 } };
+			Spline2 spline = Spline2::CatmullRom(points, 5);
+			Assert::AreEqual((size_t)4, spline.SegmentCount());
+			for (int i = 0; i < 5; i++) {
+				CustomAssert::AreEqualsMember(points[i], spline.Evaluate((float)i));
+			}
+
+			// interior tangents are half the span between neighbours, and
+			// the spline is continuous in slope across segments
+			CustomAssert::AreEqualsMember((points[3] - points[1]) * 0.5f, spline.Derivative(2.0f));
+			CustomAssert::AreEqualsMember(spline.segments[1].Derivative(1.0f), spline.segments[2].Derivative(0.0f));
+
+			// parameters outside the spline clamp to its ends
+			CustomAssert::AreEqualsMember(points[0], spline.Evaluate(-3.0f));
+			CustomAssert::AreEqualsMember(points[4], spline.Evaluate(99.0f));
+		}
+
+		TEST_METHOD(ForwardDifferencingMatchesEvaluate)
+		{
+			Vector3 chain[7] = { controls[0], controls[1], controls[2], controls[3], { 7, 7, 4 }, { 9, 0, 0 }, { 10, 1, -1 } };
+			Spline3 spline = Spline3::Bezier(chain, 7);
+			Assert::AreEqual((size_t)2, spline.SegmentCount());
+
+			const size_t perSegment = 64;
+			std::vector<Vector3> samples(spline.SampleCount(perSegment));
+			spline.Sample(perSegment, samples.data());
+
+			for (size_t i = 0; i < samples.size(); i++) {
+				AreNear(spline.Evaluate(i / (float)perSegment), samples[i], 1.0e-4f);
+			}
+			CustomAssert::AreEqualsMember(chain[6], samples.back());
+		}
+
+		TEST_METHOD(ArcLengthReparameterisation)
+		{
+			// a straight line with uneven control points moves at uneven speed
+			Vector3 line[4] = { { 0, 0, 0 }, { 9, 0, 0 }, { 9.5f, 0, 0 }, { 10, 0, 0 } };
+			Spline3 spline = Spline3::Bezier(line, 4);
+			ArcLengthTable table(spline, 256);
+
+			Assert::AreEqual(10.0f, table.Length(), 1.0e-3f);
+			for (int i = 0; i <= 10; i++) {
+				float distance = (float)i;
+				Assert::AreEqual(distance, spline.Evaluate(table.ParameterAt(distance)).x, 0.01f);
+			}
+			Assert::AreEqual(0.0f, table.ParameterAt(-5.0f));
+			Assert::AreEqual(1.0f, table.ParameterAt(50.0f));
+
+			// a quarter circle through nine Catmull-Rom points on the arc
+			std::vector<Vector2> arc;
+			for (int i = 0; i <= 8; i++) {
+				float angle = i * 3.14159265f / 16.0f;
+				arc.push_back(Vector2(std::cos(angle), std::sin(angle)) * 10.0f);
+			}
+			ArcLengthTable circle(Spline2::CatmullRom(arc.data(), arc.size()));
+			Assert::AreEqual(10.0f * 3.14159265f / 2.0f, circle.Length(), 0.02f);
+		}
+
+		TEST_METHOD(CurveStreamMatchesEvaluate)
+		{
+			MathClasses::CurveStream<Vector3> stream;
+			std::vector<CubicCurve3> curves;
+			std::vector<float> t;
+			for (int i = 0; i < 11; i++) {
+				Vector3 offset((float)i, (float)-i, 0.5f * i);
+				curves.push_back(CubicCurve3::FromBezier(controls[0] + offset, controls[1], controls[2] - offset, controls[3]));
+				stream.PushBack(curves.back());
+				t.push_back(i / 10.0f);
+			}
+			Assert::AreEqual((size_t)11, stream.Size());
+
+			std::vector<Vector3> out(stream.Size());
+			stream.Evaluate(t.data(), out.data());
+			std::vector<float> x(stream.Size()), y(stream.Size()), z(stream.Size());
+			stream.Evaluate(t.data(), { x.data(), y.data(), z.data() });
+
+			for (size_t i = 0; i < curves.size(); i++) {
+				CustomAssert::AreEqualsMember(curves[i].Evaluate(t[i]), out[i]);
+				CustomAssert::AreEqualsMember(out[i], Vector3(x[i], y[i], z[i]));
+				CustomAssert::AreEqualsMember(curves[i].c3, stream.Get(i).c3);
+			}
+		}
+
+		TEST_METHOD(CurveStepperWalksCurves)
+		{
+			MathClasses::CurveStepper<Vector2> stepper;
+			std::vector<CubicCurve2> curves;
+			for (int i = 0; i < 7; i++) {
+				Vector2 p0((float)i, 0), p1((float)i + 2, 5), p2(1, (float)-i), p3(10, 10);
+				curves.push_back(CubicCurve2::FromBezier(p0, p1, p2, p3));
+				stepper.PushBack(curves.back(), 50);
+			}
+
+			for (int step = 0; step <= 50; step++) {
+				for (size_t i = 0; i < curves.size(); i++) {
+					Vector2 expected = curves[i].Evaluate(step / 50.0f);
+					Assert::IsTrue(expected.Distance(stepper.Get(i)) < 1.0e-4f, L"stepper drifted from the curve");
+				}
+				stepper.Step();
+			}
+		}
+	};
+}
@@ -0,0 +1,97 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+
+#include "Renderer.h"
+#include "SpriteLayer.h"
+#include "SpriteObject.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::AABB2;
+using MathClasses::Vector2;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(SpriteCullingTests)
+	{
+	public:
+		TEST_METHOD(CachedBoundsFollowTransform)
+		{
+			SpriteObject sprite(0, Vector2(20, 10), Vector2(100, 50));
+			Assert::IsTrue(sprite.WorldBounds() == AABB2(Vector2(90, 45), Vector2(110, 55)));
+
+			// reading the cache does not count as a change
+			uint32_t version = sprite.TransformVersion();
+			sprite.WorldTransform();
+			Assert::AreEqual(version, sprite.TransformVersion());
+
+			sprite.Translate(Vector2(5, -5));
+			Assert::AreNotEqual(version, sprite.TransformVersion());
+			Assert::IsTrue(sprite.WorldBounds() == AABB2(Vector2(95, 40), Vector2(115, 50)));
+
+			// a quarter turn swaps the rectangle's width and height
+			sprite.SetRotation(1.5707964f);
+			AABB2 turned = sprite.WorldBounds();
+			Assert::AreEqual(10.0f, turned.Size().x, 1.0e-4f);
+			Assert::AreEqual(20.0f, turned.Size().y, 1.0e-4f);
+
+			sprite.SetPivot(Vector2(0, 0));
+			sprite.SetRotation(0);
+			sprite.SetScale(Vector2(2, 2));
+			Assert::IsTrue(sprite.WorldBounds() == AABB2(Vector2(105, 45), Vector2(145, 65)));
+		}
+
+		TEST_METHOD(DrawsOnlyVisibleSprites)
+		{
+			// a 30 x 30 grid of sprites 50 units apart, seen through an 800 x 450 view
+			std::vector<SpriteObject> sprites;
+			for (int y = 0; y < 30; y++) {
+				for (int x = 0; x < 30; x++) {
+					sprites.emplace_back(0, Vector2(20, 20), Vector2(x * 50.0f, y * 50.0f));
+				}
+			}
+			SpriteLayer layer;
+			for (SpriteObject& sprite : sprites) {
+				layer.Add(sprite);
+			}
+
+			auto countVisible = [&](const AABB2& view) {
+				size_t count = 0;
+				for (const SpriteObject& sprite : sprites) {
+					count += sprite.WorldBounds().Overlaps(view) ? 1 : 0;
+				}
+				return count;
+			};
+
+			AABB2 view(Vector2(0, 0), Vector2(800, 450));
+			NullRenderer renderer;
+			layer.Draw(renderer, view);
+			// columns 0 to 16 and rows 0 to 9
+			Assert::AreEqual((size_t)(17 * 10), renderer.drawCalls);
+			Assert::AreEqual(countVisible(view), renderer.drawCalls);
+
+			view = AABB2(Vector2(612, 1003), Vector2(1412, 1453));
+			renderer.drawCalls = 0;
+			const std::vector<uint32_t>& visible = layer.Cull(view);
+			layer.Draw(renderer, visible);
+			Assert::AreEqual(countVisible(view), renderer.drawCalls);
+			for (uint32_t index : visible) {
+				Assert::IsTrue(layer[index].WorldBounds().Overlaps(view));
+			}
+
+			// moving a sprite into view is picked up on the next cull
+			size_t before = layer.Cull(view).size();
+			sprites[0].SetPosition(Vector2(1000, 1200));
+			Assert::AreEqual(before + 1, layer.Cull(view).size());
+			sprites[0].SetPosition(Vector2(-1000, 0));
+			Assert::AreEqual(before, layer.Cull(view).size());
+
+			renderer.drawCalls = 0;
+			layer.Draw(renderer, AABB2(Vector2(-5000, -5000), Vector2(-4000, -4000)));
+			Assert::AreEqual((size_t)0, renderer.drawCalls);
+		}
+	};
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "MathLibraryTests.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace MathLibraryTests
+{
+	/*
+	 * The batch functions work through four elements at a time and finish
+	 * the remainder one by one. Tests comparing them against the scalar
+	 * functions use these lengths, which are not multiples of four, so
+	 * both paths run.
+	 */
+	constexpr int BatchTestLength = 7;
+	constexpr size_t LargeBatchTestLength = 1003;
+
+	/**
+	 * Seeded random test data, so a failing test fails the same way on
+	 * every run.
+	 */
+	class TestRandom
+	{
+	public:
+		explicit TestRandom(unsigned seed) : engine(seed) {}
+
+		uint32_t NextBits() { return engine(); }
+		float NextFloat(float min, float max) { return std::uniform_real_distribution<float>(min, max)(engine); }
+		int32_t NextInt(int32_t min, int32_t max) { return std::uniform_int_distribution<int32_t>(min, max)(engine); }
+
+		MathClasses::Vector2 NextVector2(float min, float max) {
+			float x = NextFloat(min, max);
+			float y = NextFloat(min, max);
+			return MathClasses::Vector2(x, y);
+		}
+
+		MathClasses::Vector3 NextVector3(float min, float max) {
+			float x = NextFloat(min, max);
+			float y = NextFloat(min, max);
+			float z = NextFloat(min, max);
+			return MathClasses::Vector3(x, y, z);
+		}
+
+		MathClasses::Color NextColor() {
+			MathClasses::Color color;
+			color.rgba = NextBits();
+			return color;
+		}
+
+		std::vector<float> Floats(size_t count, float min, float max) {
+			std::vector<float> values(count);
+			for (float& v : values) { v = NextFloat(min, max); }
+			return values;
+		}
+
+		std::vector<MathClasses::Vector2> Vector2s(size_t count, float min, float max) {
+			std::vector<MathClasses::Vector2> points(count);
+			for (MathClasses::Vector2& p : points) { p = NextVector2(min, max); }
+			return points;
+		}
+
+		MathClasses::Vector3Stream Vector3s(size_t count, float min, float max) {
+			MathClasses::Vector3Stream stream;
+			for (size_t i = 0; i < count; i++) { stream.PushBack(NextVector3(min, max)); }
+			return stream;
+		}
+
+		std::vector<MathClasses::Color> Colors(size_t count) {
+			std::vector<MathClasses::Color> colors(count);
+			for (MathClasses::Color& c : colors) { c = NextColor(); }
+			return colors;
+		}
+
+	private:
+		std::mt19937 engine;
+	};
+}
@@ -17,10 +17,11 @@ namespace Microsoft::VisualStudio::CppUnitTestFramework
 
 	using MathClasses::Vector2;
 	using MathClasses::Vector3;
-	//using MathClasses::Vector4;
-	//using MathClasses::Matrix3;
-	//using MathClasses::Matrix4;
-	//using MathClasses::Color;
+	using MathClasses::Vector4;
+	using MathClasses::Matrix3;
+	using MathClasses::Matrix4;
+	using MathClasses::Quaternion;
+	using MathClasses::Color;
 
 	namespace Detail
 	{
@@ -54,74 +55,155 @@ namespace Microsoft::VisualStudio::CppUnitTestFramework
 		return ss.str();
 	}
 
-	//template<> inline std::wstring ToString<Vector3>(const Vector3& t)
-	//{
-	//	auto ss = Detail::MakeWideStringStreamForFloats();
-	//
-	//	constexpr auto delimiter = L", ";
-	//	ss << L"("
-	//		<< t.x << delimiter
-	//		<< t.y << delimiter
-	//		<< t.z << L")";
-	//
-	//	return ss.str();
-	//}
-	//
-	//template<> inline std::wstring ToString<Vector4>(const Vector4& t)
-	//{
-	//	auto ss = Detail::MakeWideStringStreamForFloats();
-	//
-	//	constexpr auto delimiter = L", ";
-	//	ss << L"("
-	//		<< t.x << delimiter
-	//		<< t.y << delimiter
-	//		<< t.z << delimiter
-	//		<< t.w << L")";
-	//
-	//	return ss.str();
-	//}
-	//
-	//template<> inline std::wstring ToString<Matrix3>(const Matrix3& t)
-	//{
-	//	auto ss = Detail::MakeWideStringStreamForFloats();
-	//
-	//	// Print each column as a vector.
-	//	constexpr auto delimiter = L", ";
-	//	ss << L"["
-	//		<< ToString(Vector3{ t.mm[0][0], t.mm[0][1], t.mm[0][2] }) << delimiter
-	//		<< ToString(Vector3{ t.mm[1][0], t.mm[1][1], t.mm[1][2] }) << delimiter
-	//		<< ToString(Vector3{ t.mm[2][0], t.mm[2][1], t.mm[2][2] }) << L"]";
-	//
-	//	return ss.str();
-	//}
-	//
-	//template<> inline std::wstring ToString<Matrix4>(const Matrix4& t)
-	//{
-	//	auto ss = Detail::MakeWideStringStreamForFloats();
-	//
-	//	// Print each column as a vector.
-	//	constexpr auto delimiter = L", ";
-	//	ss << L"["
-	//		<< ToString(Vector4{ t.mm[0][0], t.mm[0][1], t.mm[0][2], t.mm[0][3] }) << delimiter
-	//		<< ToString(Vector4{ t.mm[1][0], t.mm[1][1], t.mm[1][2], t.mm[1][3] }) << delimiter
-	//		<< ToString(Vector4{ t.mm[2][0], t.mm[2][1], t.mm[2][2], t.mm[2][3] }) << delimiter
-	//		<< ToString(Vector4{ t.mm[3][0], t.mm[3][1], t.mm[3][2], t.mm[3][3] }) << L"]";
-	//
-	//	return ss.str();
-	//}
-	//
-	//template<> inline std::wstring ToString<Color>(const Color& t)
-	//{
-	//	auto ss = std::wstringstream{};
-	//
-	//	// Print each column as a vector.
-	//	constexpr auto delimiter = L", ";
-	//	ss << L"["
-	//		<< (unsigned char)t.r << delimiter
-	//		<< (unsigned char)t.g << delimiter
-	//		<< (unsigned char)t.b << delimiter
-	//		<< (unsigned char)t.a << L"]";
-	//
-	//	return ss.str();
-	//}
+	template<> inline std::wstring ToString<Vector3>(const Vector3& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+
+		constexpr auto delimiter = L", ";
+		ss << L"("
+			<< t.x << delimiter
+			<< t.y << delimiter
+			<< t.z << L")";
+
+		return ss.str();
+	}
+
+	template<> inline std::wstring ToString<Vector4>(const Vector4& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+
+		constexpr auto delimiter = L", ";
+		ss << L"("
+			<< t.x << delimiter
+			<< t.y << delimiter
+			<< t.z << delimiter
+			<< t.w << L")";
+
+		return ss.str();
+	}
+
+	namespace Detail
+	{
+		/// @return The components of any VectorN, written like the Vector types above.
+		template<typename T, size_t N>
+		std::wstring VectorNToString(const MathClasses::VectorN<T, N>& t)
+		{
+			auto ss = Detail::MakeWideStringStreamForFloats();
+			ss << L"(";
+			for (size_t i = 0; i < N; i++)
+			{
+				ss << (i == 0 ? L"" : L", ") << typename MathClasses::VectorN<T, N>::Scalar(t.v[i]);
+			}
+			ss << L")";
+			return ss.str();
+		}
+	}
+
+	template<> inline std::wstring ToString<MathClasses::Vector2i>(const MathClasses::Vector2i& t) { return Detail::VectorNToString(t); }
+	template<> inline std::wstring ToString<MathClasses::Vector3i>(const MathClasses::Vector3i& t) { return Detail::VectorNToString(t); }
+	template<> inline std::wstring ToString<MathClasses::Vector3d>(const MathClasses::Vector3d& t) { return Detail::VectorNToString(t); }
+	template<> inline std::wstring ToString<MathClasses::Vector4d>(const MathClasses::Vector4d& t) { return Detail::VectorNToString(t); }
+	template<> inline std::wstring ToString<MathClasses::Vector3h>(const MathClasses::Vector3h& t) { return Detail::VectorNToString(t); }
+	template<> inline std::wstring ToString<MathClasses::Vector3q16>(const MathClasses::Vector3q16& t) { return Detail::VectorNToString(t); }
+
+	template<> inline std::wstring ToString<MathClasses::Fixed32>(const MathClasses::Fixed32& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+		ss << t.ToDouble() << L" (raw " << t.raw << L")";
+		return ss.str();
+	}
+
+	template<> inline std::wstring ToString<MathClasses::Vector2fx>(const MathClasses::Vector2fx& t)
+	{
+		return L"(" + ToString(t.x) + L", " + ToString(t.y) + L")";
+	}
+
+	template<> inline std::wstring ToString<MathClasses::Matrix3fx>(const MathClasses::Matrix3fx& t)
+	{
+		std::wstring result = L"[";
+		for (int i = 0; i < 9; i++)
+		{
+			result += (i == 0 ? L"" : L", ") + ToString(t.v[i]);
+		}
+		return result + L"]";
+	}
+
+	template<> inline std::wstring ToString<Matrix3>(const Matrix3& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+	
+		// Print each column as a vector.
+		constexpr auto delimiter = L", ";
+		ss << L"["
+			<< ToString(Vector3{ t.mm[0][0], t.mm[0][1], t.mm[0][2] }) << delimiter
+			<< ToString(Vector3{ t.mm[1][0], t.mm[1][1], t.mm[1][2] }) << delimiter
+			<< ToString(Vector3{ t.mm[2][0], t.mm[2][1], t.mm[2][2] }) << L"]";
+	
+		return ss.str();
+	}
+	
+	template<> inline std::wstring ToString<MathClasses::Affine2D>(const MathClasses::Affine2D& t)
+	{
+		constexpr auto delimiter = L", ";
+		return L"[" + ToString(t.axis[0]) + delimiter + ToString(t.axis[1]) + delimiter + ToString(t.axis[2]) + L"]";
+	}
+
+	template<> inline std::wstring ToString<Matrix4>(const Matrix4& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+	
+		// Print each column as a vector.
+		constexpr auto delimiter = L", ";
+		ss << L"["
+			<< ToString(Vector4{ t.mm[0][0], t.mm[0][1], t.mm[0][2], t.mm[0][3] }) << delimiter
+			<< ToString(Vector4{ t.mm[1][0], t.mm[1][1], t.mm[1][2], t.mm[1][3] }) << delimiter
+			<< ToString(Vector4{ t.mm[2][0], t.mm[2][1], t.mm[2][2], t.mm[2][3] }) << delimiter
+			<< ToString(Vector4{ t.mm[3][0], t.mm[3][1], t.mm[3][2], t.mm[3][3] }) << L"]";
+	
+		return ss.str();
+	}
+	
+	template<> inline std::wstring ToString<MathClasses::Matrix4d>(const MathClasses::Matrix4d& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+
+		// Print each column as a vector.
+		constexpr auto delimiter = L", ";
+		ss << L"["
+			<< Detail::VectorNToString(t.axis[0]) << delimiter
+			<< Detail::VectorNToString(t.axis[1]) << delimiter
+			<< Detail::VectorNToString(t.axis[2]) << delimiter
+			<< Detail::VectorNToString(t.axis[3]) << L"]";
+
+		return ss.str();
+	}
+
+	template<> inline std::wstring ToString<Quaternion>(const Quaternion& t)
+	{
+		auto ss = Detail::MakeWideStringStreamForFloats();
+
+		constexpr auto delimiter = L", ";
+		ss << L"("
+			<< t.x << delimiter
+			<< t.y << delimiter
+			<< t.z << delimiter
+			<< t.w << L")";
+
+		return ss.str();
+	}
+
+	template<> inline std::wstring ToString<Color>(const Color& t)
+	{
+		auto ss = std::wstringstream{};
+
+		// Print the channels as numbers rather than characters.
+		constexpr auto delimiter = L", ";
+		ss << L"["
+			<< (unsigned int)t.r << delimiter
+			<< (unsigned int)t.g << delimiter
+			<< (unsigned int)t.b << delimiter
+			<< (unsigned int)t.a << L"]";
+
+		return ss.str();
+	}
 }
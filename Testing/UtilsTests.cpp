@@ -0,0 +1,118 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using MathClasses::MAX_FLOAT_DELTA;
+namespace Easing = MathClasses::Easing;
+
+namespace MathLibraryTests_Utils
+{
+	template<typename Curve>
+	void CheckCurve(float atHalf)
+	{
+		Assert::AreEqual(0.0f, Curve::Apply(0.0f), MAX_FLOAT_DELTA);
+		Assert::AreEqual(1.0f, Curve::Apply(1.0f), MAX_FLOAT_DELTA);
+		Assert::AreEqual(atHalf, Curve::Apply(0.5f), MAX_FLOAT_DELTA);
+
+		std::vector<float> t = MathLibraryTests::TestRandom(31).Floats(MathLibraryTests::LargeBatchTestLength, 0.0f, 1.0f);
+		t[0] = 0.0f;
+		t[1] = 0.5f;
+		t[2] = 1.0f;
+		std::vector<float> out(t.size());
+		MathClasses::EaseArray<Curve>(t.data(), out.data(), t.size());
+		for (size_t i = 0; i < t.size(); i++) {
+			Assert::AreEqual(Curve::Apply(t[i]), out[i]);
+		}
+	}
+}
+
+namespace MathLibraryTests
+{
+	using namespace MathLibraryTests_Utils;
+
+	TEST_CLASS(UtilsTests)
+	{
+	public:
+		TEST_METHOD(ScalarHelpers)
+		{
+			Assert::AreEqual(0.25f, MathClasses::InverseLerp(10.0f, 30.0f, 15.0f));
+			Assert::AreEqual(-0.5f, MathClasses::InverseLerp(10.0f, 30.0f, 0.0f));
+
+			Assert::AreEqual(0.0f, MathClasses::SmoothStep(1.0f, 3.0f, 0.0f));
+			Assert::AreEqual(0.5f, MathClasses::SmoothStep(1.0f, 3.0f, 2.0f));
+			Assert::AreEqual(1.0f, MathClasses::SmoothStep(1.0f, 3.0f, 9.0f));
+			Assert::AreEqual(0.15625f, MathClasses::SmoothStep(1.0f, 3.0f, 1.5f));
+
+			Assert::AreEqual(50.0f, MathClasses::Remap(0.0f, 1.0f, 0.0f, 100.0f, 0.5f));
+			Assert::AreEqual(-10.0f, MathClasses::Remap(-1.0f, 1.0f, 10.0f, -10.0f, 1.0f));
+
+			static_assert(MathClasses::Remap(0.0f, 2.0f, 10.0f, 20.0f, 1.0f) == 15.0f);
+		}
+
+		TEST_METHOD(ArraysMatchScalar)
+		{
+			std::vector<float> start = TestRandom(32).Floats(LargeBatchTestLength, -100.0f, 100.0f);
+			std::vector<float> end = TestRandom(33).Floats(LargeBatchTestLength, -100.0f, 100.0f);
+			std::vector<float> alpha = TestRandom(34).Floats(LargeBatchTestLength, -0.5f, 1.5f);
+			std::vector<float> out(start.size());
+
+			MathClasses::LerpArray(start.data(), end.data(), alpha.data(), out.data(), start.size());
+			for (size_t i = 0; i < start.size(); i++) {
+				Assert::AreEqual(MathClasses::Lerp(start[i], end[i], alpha[i]), out[i]);
+			}
+
+			MathClasses::InverseLerpArray(-20.0f, 60.0f, start.data(), out.data(), start.size());
+			for (size_t i = 0; i < start.size(); i++) {
+				Assert::AreEqual(MathClasses::InverseLerp(-20.0f, 60.0f, start[i]), out[i]);
+			}
+
+			MathClasses::SmoothStepArray(-20.0f, 60.0f, start.data(), out.data(), start.size());
+			for (size_t i = 0; i < start.size(); i++) {
+				Assert::AreEqual(MathClasses::SmoothStep(-20.0f, 60.0f, start[i]), out[i]);
+			}
+
+			// equal edges make a step, and a value on the edge gives 0 on both paths
+			const float onEdge[] = { 2.0f, 1.0f, 3.0f, 2.0f, 2.0f };
+			float stepped[5];
+			MathClasses::SmoothStepArray(2.0f, 2.0f, onEdge, stepped, 5);
+			for (size_t i = 0; i < 5; i++) {
+				Assert::AreEqual(MathClasses::SmoothStep(2.0f, 2.0f, onEdge[i]), stepped[i]);
+				Assert::AreEqual(onEdge[i] > 2.0f ? 1.0f : 0.0f, stepped[i]);
+			}
+
+			MathClasses::RemapArray(-100.0f, 100.0f, 5.0f, -3.0f, start.data(), out.data(), start.size());
+			for (size_t i = 0; i < start.size(); i++) {
+				Assert::AreEqual(MathClasses::Remap(-100.0f, 100.0f, 5.0f, -3.0f, start[i]), out[i]);
+			}
+
+			// the output may alias an input
+			std::vector<float> inPlace = start;
+			MathClasses::LerpArray(inPlace.data(), end.data(), alpha.data(), inPlace.data(), inPlace.size());
+			for (size_t i = 0; i < start.size(); i++) {
+				Assert::AreEqual(MathClasses::Lerp(start[i], end[i], alpha[i]), inPlace[i]);
+			}
+		}
+
+		TEST_METHOD(EasingCurves)
+		{
+			CheckCurve<Easing::Linear>(0.5f);
+			CheckCurve<Easing::InQuad>(0.25f);
+			CheckCurve<Easing::OutQuad>(0.75f);
+			CheckCurve<Easing::InOutQuad>(0.5f);
+			CheckCurve<Easing::InCubic>(0.125f);
+			CheckCurve<Easing::OutCubic>(0.875f);
+			CheckCurve<Easing::InOutCubic>(0.5f);
+			CheckCurve<Easing::SmoothStep>(0.5f);
+			CheckCurve<Easing::OutBack>(1.0876975f);
+
+			// the in-out curves are continuous where they switch halves
+			Assert::AreEqual(Easing::InOutQuad::Apply(0.4999999f), Easing::InOutQuad::Apply(0.5f), 1.0e-5f);
+			Assert::AreEqual(Easing::InOutCubic::Apply(0.4999999f), Easing::InOutCubic::Apply(0.5f), 1.0e-5f);
+		}
+	};
+}
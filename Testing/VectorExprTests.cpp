@@ -0,0 +1,80 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::MAX_FLOAT_DELTA;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::Vector4;
+using MathClasses::Vector3Stream;
+using MathClasses::Expr::Lazy;
+
+namespace Expr = MathClasses::Expr;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(VectorExprTests)
+	{
+	public:
+		const Vector3 points[BatchTestLength] = {
+			{ 13.5f, -48.23f, 862 }, { 5, 3.99f, -12 }, { 0, 1, 0 }, { -2.5f, 7.0f, 1.25f },
+			{ 100.0f, -0.5f, 2 }, { 3, 4, 12 }, { -8.25f, -16.0f, 0.5f }
+		};
+
+		TEST_METHOD(MatchesOperators)
+		{
+			Vector3 a(13.5f, -48.23f, 862), b(5, 3.99f, -12), c(-2.5f, 7.0f, 1.25f);
+
+			CustomAssert::AreEqualsMember(a + b * 4.89f - c, Expr::Evaluate<Vector3>(Lazy(a) + Lazy(b) * 4.89f - Lazy(c)));
+			CustomAssert::AreEqualsMember((a - b) / 2.0f, Expr::Evaluate<Vector3>((Lazy(a) - Lazy(b)) / 2.0f));
+			CustomAssert::AreEqualsMember(-(a * b), Expr::Evaluate<Vector3>(-(Lazy(a) * Lazy(b))));
+
+			Vector2 p(3, 4), q(-1, 2);
+			Vector2 r;
+			Expr::Assign(r, 0.5f * Lazy(p) + Lazy(q));
+			CustomAssert::AreEqualsMember(p * 0.5f + q, r);
+
+			Vector4 v(1, 2, 3, 4), w(4, 3, 2, 1);
+			CustomAssert::AreEqualsMember(v + w * 2.0f, Expr::Evaluate<Vector4>(Lazy(v) + Lazy(w) * 2.0f));
+		}
+
+		TEST_METHOD(Reductions)
+		{
+			Vector3 a(13.5f, -48.23f, 862), b(5, 3.99f, -12);
+
+			Assert::AreEqual(a.Distance(b), Expr::Magnitude(Lazy(a) - Lazy(b)), MAX_FLOAT_DELTA);
+			Assert::AreEqual(a.DistanceSqr(b), Expr::MagnitudeSqr(Lazy(a) - Lazy(b)), 0.1f);
+			Assert::AreEqual((a + b).Dot(b), Expr::Dot(Lazy(a) + Lazy(b), Lazy(b)), 0.1f);
+		}
+
+		TEST_METHOD(Streams)
+		{
+			Vector3Stream a = Vector3Stream::FromArray(points, BatchTestLength);
+			Vector3Stream b(BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				b.Set(i, points[6 - i]);
+			}
+			const Vector3 offset(1, -2, 0.5f);
+
+			Vector3Stream out;
+			Expr::Assign(out, Lazy(a) + Lazy(b) * 4.89f - Lazy(offset));
+			Assert::AreEqual((size_t)BatchTestLength, out.Size());
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(points[i] + points[6 - i] * 4.89f - offset, out.Get(i));
+			}
+
+			// writing back into an operand is allowed
+			Expr::Assign(a, (Lazy(a) - Lazy(b)) * 0.5f);
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember((points[i] - points[6 - i]) * 0.5f, a.Get(i));
+			}
+		}
+	};
+}
@@ -0,0 +1,125 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Half;
+using MathClasses::Vector2;
+using MathClasses::Vector2i;
+using MathClasses::Vector3;
+using MathClasses::Vector3d;
+using MathClasses::Vector3h;
+using MathClasses::Vector3i;
+using MathClasses::VectorN;
+
+namespace MathLibraryTests_VectorN
+{
+	// the float aliases are the template, so generic code accepts them
+	static_assert(std::is_same_v<Vector3, VectorN<float, 3>>);
+	static_assert(sizeof(Vector2) == 8 && sizeof(Vector3) == 12);
+	static_assert(sizeof(Vector3i) == 12 && sizeof(Vector3d) == 24 && sizeof(Vector3h) == 6);
+
+	// integer vectors work at compile time like the float ones
+	static_assert(Vector2i(3, 4) + Vector2i(1, -1) == Vector2i(4, 3));
+	static_assert(Vector3i(1, 0, 0).Cross(Vector3i(0, 1, 0)) == Vector3i(0, 0, 1));
+	static_assert(Vector3i(2, 3, 4).Dot(Vector3i(1, 1, 1)) == 9);
+	static_assert(Vector3i(Vector2i(1, 2), 3) == Vector3i(1, 2, 3));
+	static_assert(-2 * Vector2i(1, 2) == Vector2i(-2, -4));
+
+	// half conversions that are exact
+	static_assert(Half::FromFloat(1.0f) == 0x3C00);
+	static_assert(Half::FromFloat(-2.0f) == 0xC000);
+	static_assert(Half::FromFloat(65504.0f) == 0x7BFF);
+	static_assert(Half::ToFloat(0x3555) == 0.333251953125f);
+}
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(VectorNTests)
+	{
+	public:
+		TEST_METHOD(IntegerGridVectors)
+		{
+			Vector2i cell(7, -3);
+			Vector2i step(1, 2);
+
+			CustomAssert::AreEqualsMember(Vector2i(8, -1), cell + step);
+			CustomAssert::AreEqualsMember(Vector2i(7, -6), cell * Vector2i(1, 2));
+			CustomAssert::AreEqualsMember(Vector2i(3, -1), cell / 2);
+			Assert::AreEqual(5.0f, Vector2i(3, 4).Magnitude());
+			Assert::AreEqual(25, Vector2i(3, 4).MagnitudeSqr());
+
+			// integer vectors compare exactly
+			Assert::IsFalse(Vector2i(1, 1) == Vector2i(1, 2));
+		}
+
+		TEST_METHOD(ConvertBetweenElementTypes)
+		{
+			Vector3i cell(4, -2, 9);
+			Vector3 position(cell);
+
+			CustomAssert::AreEqualsMember(Vector3(4, -2, 9), position);
+			CustomAssert::AreEqualsMember(Vector3i(1, 2, -3), Vector3i(Vector3(1.9f, 2.2f, -3.7f)));
+		}
+
+		TEST_METHOD(DoubleVectors)
+		{
+			Vector3d a(1.0e7, 2.0, -3.0);
+			Vector3d b(1.0e7 + 0.125, 2.0, -3.0);
+
+			Assert::AreEqual(0.125, a.Distance(b));
+			CustomAssert::AreEqualsMember(Vector3d(0, 0, 1), Vector3d(0, 0, 8).Normalised());
+			CustomAssert::AreEqualsMember(Vector3d(0, 0, 1), Vector3d(1, 0, 0).Cross(Vector3d(0, 1, 0)));
+		}
+
+		TEST_METHOD(HalfVectors)
+		{
+			Vector3h a(1.5f, -2.0f, 0.25f);
+			Vector3h b(0.5f, 4.0f, 0.75f);
+
+			CustomAssert::AreEqualsMember(Vector3h(2.0f, 2.0f, 1.0f), a + b);
+			Assert::AreEqual(-7.0625f, a.Dot(b));
+			CustomAssert::AreEqualsMember(Vector3h(0.6f, 0.8f, 0), Vector3h(3.0f, 4.0f, 0).Normalised(), L"within half precision");
+		}
+
+		TEST_METHOD(HalfRounding)
+		{
+			// every half converts to float and back unchanged
+			for (uint32_t bits = 0; bits < 0x10000; bits++)
+			{
+				float f = Half::ToFloat((uint16_t)bits);
+				if (f != f) { continue; }
+				Assert::AreEqual((uint16_t)bits, Half::FromFloat(f));
+			}
+
+			// ties round to even
+			Assert::AreEqual((uint16_t)0x3C00, Half::FromFloat(1.0f + 1.0f / 2048));
+			Assert::AreEqual((uint16_t)0x3C02, Half::FromFloat(1.0f + 3.0f / 2048));
+			// subnormals, overflow and NaN
+			Assert::AreEqual((uint16_t)0x0001, Half::FromFloat(5.9604645e-8f));
+			Assert::AreEqual((uint16_t)0x0000, Half::FromFloat(2.9802322e-8f));
+			Assert::AreEqual((uint16_t)0x7C00, Half::FromFloat(65520.0f));
+			Assert::AreEqual((uint16_t)0xFC00, Half::FromFloat(-std::numeric_limits<float>::infinity()));
+			float nan = Half::ToFloat(Half::FromFloat(std::numeric_limits<float>::quiet_NaN()));
+			Assert::IsTrue(nan != nan);
+		}
+
+		TEST_METHOD(ComponentAccess)
+		{
+			Vector3 v(1, 2, 3);
+
+			Assert::AreEqual(2.0f, v[1]);
+			Assert::AreEqual(3.0f, v.Get<2>());
+			v[0] = 5;
+			Assert::AreEqual(5.0f, v.x);
+
+			Vector2 dropped = v;
+			CustomAssert::AreEqualsMember(Vector2(5, 2), dropped);
+		}
+	};
+}
@@ -0,0 +1,122 @@
+#include "CppUnitTest.h"
+
+#include "MathLibraryTests.h"
+#include "MathUnitTestAssert.h"
+#include "TestData.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using aie::test::CustomAssert;
+using MathClasses::Vector2;
+using MathClasses::Vector3;
+using MathClasses::Vector2Stream;
+using MathClasses::Vector3Stream;
+using MathClasses::MAX_FLOAT_DELTA;
+
+namespace MathLibraryTests
+{
+	TEST_CLASS(VectorStreamTests)
+	{
+	public:
+		const Vector2 points2[BatchTestLength] = {
+			{ 13.5f, -48.23f }, { 5, 3.99f }, { 0, 1 }, { -2.5f, 7.0f },
+			{ 100.0f, -0.5f }, { 3, 4 }, { -8.25f, -16.0f }
+		};
+		const Vector3 points3[BatchTestLength] = {
+			{ 13.5f, -48.23f, 862 }, { 5, 3.99f, -12 }, { 0, 1, 0 }, { -2.5f, 7.0f, 1.25f },
+			{ 100.0f, -0.5f, 2 }, { 3, 4, 12 }, { -8.25f, -16.0f, 0.5f }
+		};
+
+		TEST_METHOD(RoundTrip)
+		{
+			Vector2Stream stream2 = Vector2Stream::FromArray(points2, BatchTestLength);
+			Vector2 out2[BatchTestLength];
+			stream2.ToArray(out2);
+
+			Vector3Stream stream3 = Vector3Stream::FromArray(points3, BatchTestLength);
+			Vector3 out3[BatchTestLength];
+			stream3.ToArray(out3);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(points2[i], out2[i]);
+				CustomAssert::AreEqualsMember(points3[i], out3[i]);
+			}
+		}
+
+		TEST_METHOD(AddScaleLerp)
+		{
+			Vector3Stream a = Vector3Stream::FromArray(points3, BatchTestLength);
+			Vector3Stream b(BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				b.Set(i, points3[6 - i]);
+			}
+
+			Vector3Stream sum, scaled, lerped, integrated;
+			Vector3Stream::Add(a, b, sum);
+			Vector3Stream::Scale(a, 4.89f, scaled);
+			Vector3Stream::Lerp(a, b, 0.25f, lerped);
+			Vector3Stream::AddScaled(a, b, 0.5f, integrated);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(points3[i] + points3[6 - i], sum.Get(i));
+				CustomAssert::AreEqualsMember(points3[i] * 4.89f, scaled.Get(i));
+				CustomAssert::AreEqualsMember(MathClasses::Lerp(points3[i], points3[6 - i], 0.25f), lerped.Get(i));
+				CustomAssert::AreEqualsMember(points3[i] + (points3[6 - i] * 0.5f), integrated.Get(i));
+			}
+		}
+
+		TEST_METHOD(LerpPerElement)
+		{
+			Vector3Stream a = Vector3Stream::FromArray(points3, BatchTestLength);
+			Vector3Stream b(BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				b.Set(i, points3[6 - i]);
+			}
+			const float alpha[BatchTestLength] = { 0.0f, 0.1f, 0.25f, 0.5f, 0.75f, 1.0f, 1.5f };
+
+			Vector3Stream lerped;
+			Vector3Stream::Lerp(a, b, alpha, lerped);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(MathClasses::Lerp(points3[i], points3[6 - i], alpha[i]), lerped.Get(i));
+			}
+		}
+
+		TEST_METHOD(DotMagnitudeDistance)
+		{
+			Vector2Stream a = Vector2Stream::FromArray(points2, BatchTestLength);
+			Vector2Stream b(BatchTestLength);
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				b.Set(i, points2[6 - i]);
+			}
+
+			float dot[BatchTestLength], mag[BatchTestLength], dist[BatchTestLength];
+			Vector2Stream::Dot(a, b, dot);
+			a.Magnitude(mag);
+			Vector2Stream::Distance(a, b, dist);
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				Assert::AreEqual(points2[i].Dot(points2[6 - i]), dot[i], MAX_FLOAT_DELTA);
+				Assert::AreEqual(points2[i].Magnitude(), mag[i], MAX_FLOAT_DELTA);
+				Assert::AreEqual(points2[i].Distance(points2[6 - i]), dist[i], MAX_FLOAT_DELTA);
+			}
+		}
+
+		TEST_METHOD(Normalise)
+		{
+			Vector3Stream stream = Vector3Stream::FromArray(points3, BatchTestLength);
+			stream.Normalise();
+
+			for (int i = 0; i < BatchTestLength; i++)
+			{
+				CustomAssert::AreEqualsMember(points3[i].Normalised(), stream.Get(i));
+			}
+		}
+	};
+}